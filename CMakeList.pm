@@ -340,6 +340,7 @@ sub writeExcutables
       print $DX "target_link_libraries(",$item," gsl)\n";
       print $DX "target_link_libraries(",$item," gslcblas)\n";
       print $DX "target_link_libraries(",$item," m)\n";
+      print $DX "target_link_libraries(",$item," pthread)\n";
     }
   
   
@@ -32,6 +32,7 @@
 #include <string>
 #include <algorithm>
 #include <memory>
+#include <functional>
 
 #include "Exception.h"
 #include "MersenneTwister.h"
@@ -79,6 +80,7 @@
 #include "ImportControl.h"
 #include "World.h"
 #include "makeESS.h"
+#include "SweepRun.h"
 
 
 MTRand RNG(12345UL);
@@ -122,16 +124,42 @@ main(int argc,char* argv[])
       InputModifications(SimPtr,IParam,Names);
       mainSystem::setMaterialsDataBase(IParam);
 
-      essSystem::makeESS ESSObj;
-      World::createOuterObjects(*SimPtr);
-      ESSObj.build(*SimPtr,IParam);
+      if (IParam.flag("sweep"))
+	{
+	  const mainSystem::SweepRun
+	    SweepObj(IParam.getValue<std::string>("sweep"),
+		     IParam.getDefValue<size_t>(1,"sweep",1));
+	  exitFlag=SweepObj.run(*SimPtr,IParam,Oname,
+				[&IParam](Simulation& System)
+	    {
+	      essSystem::makeESS ESSObj;
+	      World::createOuterObjects(System);
+	      ESSObj.build(System,IParam);
+	    });
+	}
+      else
+	{
+	  const std::string snapKey=mainSystem::snapshotKey
+	    (IParam,
+	     {"beamlines","bunkerChicane","bunkerFeed","bunkerPillars",
+	      "bunkerQuake","bunkerType","engineering","iradLineType",
+	      "iradObject","lowMod","lowPipe","nF5","targetType",
+	      "topMod","topPipe"});
+	  if (!mainSystem::restoreSnapshot(*SimPtr,IParam,snapKey))
+	    {
+	      essSystem::makeESS ESSObj;
+	      World::createOuterObjects(*SimPtr);
+	      ESSObj.build(*SimPtr,IParam);
+	      mainSystem::saveSnapshot(*SimPtr,IParam,snapKey);
+	    }
       
-      mainSystem::buildFullSimulation(SimPtr,IParam,Oname);
+	  mainSystem::buildFullSimulation(SimPtr,IParam,Oname);
 
-      exitFlag=SimProcess::processExitChecks(*SimPtr,IParam);
-      ModelSupport::calcVolumes(SimPtr,IParam);
+	  exitFlag=SimProcess::processExitChecks(*SimPtr,IParam);
+	  ModelSupport::calcVolumes(SimPtr,IParam);
       
-      SimPtr->objectGroups::write("ObjectRegister.txt");
+	  SimPtr->objectGroups::write("ObjectRegister.txt");
+	}
     }
   catch (ColErr::ExitAbort& EA)
     {
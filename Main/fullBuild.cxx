@@ -131,9 +131,17 @@ main(int argc,char* argv[])
 	    setVFlag(IParam.getValue<int>("memStack"));
 	}
       
-      World::createOuterObjects(*SimPtr);
-      moderatorSystem::makeTS2 TS2Obj;
-      TS2Obj.build(SimPtr,IParam);
+      const std::string snapKey=mainSystem::snapshotKey
+	(IParam,
+	 {"bolts","decFile","decType","exclude","isolate",
+	  "orthoH","targetType"});
+      if (!mainSystem::restoreSnapshot(*SimPtr,IParam,snapKey))
+	{
+	  World::createOuterObjects(*SimPtr);
+	  moderatorSystem::makeTS2 TS2Obj;
+	  TS2Obj.build(SimPtr,IParam);
+	  mainSystem::saveSnapshot(*SimPtr,IParam,snapKey);
+	}
       
       mainSystem::buildFullSimulation(SimPtr,IParam,Oname);
       ELog::EM<<"FULLBUILD : variable hash: "
@@ -33,6 +33,7 @@
 #include <algorithm>
 #include <memory>
 #include <array>
+#include <functional>
 
 #include "Exception.h"
 #include "MersenneTwister.h"
@@ -82,6 +83,7 @@
 
 #include "DefUnitsMaxIV.h"
 #include "makeMaxIV.h"
+#include "SweepRun.h"
 
 MTRand RNG(12345UL);
 
@@ -124,15 +126,37 @@ main(int argc,char* argv[])
       InputModifications(SimPtr,IParam,Names);
       mainSystem::setMaterialsDataBase(IParam);
 
-      xraySystem::makeMaxIV BObj;
-      World::createOuterObjects(*SimPtr);
-      BObj.build(*SimPtr,IParam);
+      if (IParam.flag("sweep"))
+	{
+	  const mainSystem::SweepRun
+	    SweepObj(IParam.getValue<std::string>("sweep"),
+		     IParam.getDefValue<size_t>(1,"sweep",1));
+	  exitFlag=SweepObj.run(*SimPtr,IParam,Oname,
+				[&IParam](Simulation& System)
+	    {
+	      xraySystem::makeMaxIV BObj;
+	      World::createOuterObjects(System);
+	      BObj.build(System,IParam);
+	    });
+	}
+      else
+	{
+	  const std::string snapKey=mainSystem::snapshotKey
+	    (IParam,{"beamlines","stopPoint"});
+	  if (!mainSystem::restoreSnapshot(*SimPtr,IParam,snapKey))
+	    {
+	      xraySystem::makeMaxIV BObj;
+	      World::createOuterObjects(*SimPtr);
+	      BObj.build(*SimPtr,IParam);
+	      mainSystem::saveSnapshot(*SimPtr,IParam,snapKey);
+	    }
 
-      mainSystem::buildFullSimulation(SimPtr,IParam,Oname);
-      exitFlag=SimProcess::processExitChecks(*SimPtr,IParam);
+	  mainSystem::buildFullSimulation(SimPtr,IParam,Oname);
+	  exitFlag=SimProcess::processExitChecks(*SimPtr,IParam);
 
-      ModelSupport::calcVolumes(SimPtr,IParam);
-      SimPtr->objectGroups::write("ObjectRegister.txt");
+	  ModelSupport::calcVolumes(SimPtr,IParam);
+	  SimPtr->objectGroups::write("ObjectRegister.txt");
+	}
     }
   
   catch (ColErr::ExitAbort& EA)
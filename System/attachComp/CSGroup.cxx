@@ -295,7 +295,7 @@ CSGroup::insertAllObjects(Simulation& System)
       MonteCarlo::Object* outerObj=System.findObject(primaryCell);
       if (outerObj)
 	{
-	  outerObj->addSurfString(inwardCut.complement().display());
+	  outerObj->addIntersection(inwardCut.complement());
 	  primaryCell=0;
 	}
     }
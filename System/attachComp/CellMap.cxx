@@ -114,15 +114,15 @@ CellMap::insertCellMapInCell(Simulation& System,
   if (!CPtr)
     throw ColErr::InContainerError<int>(cellN,"cellN in System");
 
+  std::vector<HeadRule> compVec;
   for(const int cn : getCells(cellKey))
     {
       const MonteCarlo::Object* OPtr=System.findObject(cn);
       if (OPtr)
-	{
-	  const HeadRule compObj=OPtr->getHeadRule().complement();
-	  CPtr->addSurfString(compObj.display());
-	}
-    }  
+	compVec.push_back(OPtr->getHeadRule().complement());
+    }
+  // all in one go
+  CPtr->addIntersection(compVec);
   return;
 }
 
@@ -151,7 +151,7 @@ CellMap::insertCellMapInCell(Simulation& System,
   if (!CPtr)
     throw ColErr::InContainerError<int>(cellN,"cellN in System");
 
-  CPtr->addSurfString(compObj.display());
+  CPtr->addIntersection(compObj);
   return;
 }
   
@@ -170,15 +170,29 @@ CellMap::insertComponent(Simulation& System,
 {
   ELog::RegMethod RegA("CellMap","insertComponent(CellMap)");
 
+  std::vector<HeadRule> compVec;
   for(const int cn : CM.getCells(holdKey))
     {
       const MonteCarlo::Object* OPtr=
 	System.findObject(cn);
       if (OPtr)
-	{
-	  const HeadRule compObj=OPtr->getHeadRule().complement();
-	  insertComponent(System,cutKey,compObj);	  
-	}
+	compVec.push_back(OPtr->getHeadRule().complement());
+    }
+  if (compVec.empty()) return;
+
+  // all the cells are added to each object in one go
+  const std::vector<int> CVec=getCells(cutKey);
+  if (CVec.empty())
+    throw ColErr::InContainerError<std::string>
+      (cutKey,"Cell["+cutKey+"] not present");
+
+  for(const int cellNum : CVec)
+    {
+      MonteCarlo::Object* outerObj=System.findObject(cellNum);
+      if (!outerObj)
+	throw ColErr::InContainerError<int>
+	  (cellNum,"Cell["+cutKey+"] not in simlutation");
+      outerObj->addIntersection(compVec);
     }
   return;
 }
@@ -235,8 +249,21 @@ CellMap::insertComponent(Simulation& System,
    */
 {
   ELog::RegMethod RegA("CellMap","insertComponent(HR)");
-  if (HR.hasRule())
-    insertComponent(System,Key,HR.display());
+  if (!HR.hasRule()) return;
+
+  const std::vector<int> CVec=getCells(Key);
+  if (CVec.empty())
+    throw ColErr::InContainerError<std::string>
+      (Key,"Cell["+Key+"] not present");
+
+  for(const int cellNum : CVec)
+    {
+      MonteCarlo::Object* outerObj=System.findObject(cellNum);
+      if (!outerObj)
+	throw ColErr::InContainerError<int>(cellNum,
+					    "Cell["+Key+"] not in simlutation");
+      outerObj->addIntersection(HR);
+    }
   return;
 }
 
@@ -254,8 +281,14 @@ CellMap::insertComponent(Simulation& System,
    */
 {
   ELog::RegMethod RegA("CellMap","insertComponent(index,HR)");
-  if (HR.hasRule())
-    insertComponent(System,Key,index,HR.display());
+  if (!HR.hasRule()) return;
+
+  const int cellNum=getCell(Key,index);
+  MonteCarlo::Object* outerObj=System.findObject(cellNum);
+  if (!outerObj)
+    throw ColErr::InContainerError<int>(cellNum,
+					"Cell["+Key+"] not present");
+  outerObj->addIntersection(HR);
   return;
 }
 
@@ -277,13 +310,18 @@ CellMap::insertComponent(Simulation& System,
     throw ColErr::InContainerError<std::string>
       (Key,"Cell["+Key+"] not present");
 
+  // process once for all the cells
+  HeadRule excludeHR;
+  if (!StrFunc::isEmpty(exclude) && !excludeHR.procString(exclude))
+    throw ColErr::InvalidLine(exclude,"exclude",0);
+  
   for(const int cellNum : CVec)
     {
       MonteCarlo::Object* outerObj=System.findObject(cellNum);
       if (!outerObj)
 	throw ColErr::InContainerError<int>(cellNum,
 					    "Cell["+Key+"] not in simlutation");
-      outerObj->addSurfString(exclude);
+      outerObj->addIntersection(excludeHR);
     }
   return;
 }
@@ -309,7 +347,11 @@ CellMap::insertComponent(Simulation& System,
   if (!outerObj)
     throw ColErr::InContainerError<int>(cellNum,
 					"Cell["+Key+"] not present");
-  outerObj->addSurfString(exclude);
+
+  HeadRule excludeHR;
+  if (!StrFunc::isEmpty(exclude) && !excludeHR.procString(exclude))
+    throw ColErr::InvalidLine(exclude,"exclude",0);
+  outerObj->addIntersection(excludeHR);
   return;
 }
 
@@ -413,6 +455,27 @@ CellMap::makeCell(const std::string& Key,Simulation& System,
   return;
 }
 
+void
+CellMap::makeCell(const std::string& Key,Simulation& System,
+		  const int cellIndex,const int matNumber,
+		  const double matTemp,const HeadRule& HR)
+
+  /*!
+    Builds a new cell in Simulation and registers it with the CellMap
+    \param System :: Simulation to obtain cell from
+    \param Key :: KeyName for cell
+    \param cellIndex :: Cell index
+    \param matNumber :: Material number
+    \param matTemp :: Temperature
+    \param HR :: Boolean surface rule
+  */
+{
+  ELog::RegMethod RegA("CellMap","makeCell(HR)");
+  System.addCell(cellIndex,matNumber,matTemp,HR);
+  addCell(Key,cellIndex);
+  return;
+}
+
 void
 CellMap::deleteCell(Simulation& System,
 		    const std::string& Key,
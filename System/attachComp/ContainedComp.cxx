@@ -682,13 +682,12 @@ ContainedComp::insertExternalObject(Simulation& System,
 {
   ELog::RegMethod RegA("ContainedComp","insertExternalObject");
   
-  const std::string excludeStr=
-    excludeObj.getHeadRule().complement().display();
+  const HeadRule excludeHR=excludeObj.getHeadRule().complement();
   for(const int CN : insertCells)
     {
       MonteCarlo::Object* outerObj=System.findObject(CN);
       if (outerObj)
-	outerObj->addSurfString(excludeStr);
+	outerObj->addIntersection(excludeHR);
       else
 	ELog::EM<<"Failed to find outerObject: "<<CN<<ELog::endErr;
     }
@@ -705,11 +704,12 @@ ContainedComp::insertObjects(Simulation& System)
   ELog::RegMethod RegA("ContainedComp","insertObjects");
   if (!hasOuterSurf()) return;
 
+  const HeadRule excludeHR(getExclude());
   for(const int CN : insertCells)
     {
       MonteCarlo::Object* outerObj=System.findObject(CN);
       if (outerObj)
-	outerObj->addSurfString(getExclude());
+	outerObj->addIntersection(excludeHR);
 
       else
 	ELog::EM<<"Failed to find outerObject: "<<CN<<ELog::endErr;
@@ -731,6 +731,7 @@ ContainedComp::insertObjects(Simulation& System,
   ELog::RegMethod RegA("ContainedComp","insertObjects");
   if (!hasOuterSurf()) return;
 
+  const HeadRule excludeHR(getExclude());
   for(const int CN : insertCells)
     {
       MonteCarlo::Object* outerObj=System.findObject(CN);
@@ -741,7 +742,7 @@ ContainedComp::insertObjects(Simulation& System,
 	    {
 	      if (HR.isValid(Pts))
 		{
-		  outerObj->addSurfString(getExclude());
+		  outerObj->addIntersection(excludeHR);
 		  break;
 		}
 	    }
@@ -763,7 +764,7 @@ ContainedComp::insertInCell(MonteCarlo::Object& outerObj) const
   ELog::RegMethod RegA("ContainedComp","insertInCell(Obj)");
   
   if (!hasOuterSurf()) return;
-  outerObj.addSurfString(getExclude());
+  outerObj.addIntersection(HeadRule(getExclude()));
   return;
 }
 
@@ -798,11 +799,13 @@ ContainedComp::insertInCell(Simulation& System,
   ELog::RegMethod RegA("ContainedComp","insertInCell(Vec)");
   
   if (!hasOuterSurf()) return;
+
+  const HeadRule excludeHR(getExclude());
   for(const int cellN : cellVec)
     {
       MonteCarlo::Object* outerObj=System.findObject(cellN);
       if (outerObj)
-	outerObj->addSurfString(getExclude());
+	outerObj->addIntersection(excludeHR);
       else
 	throw ColErr::InContainerError<int>(cellN,"Cell not in Simulation");
     }
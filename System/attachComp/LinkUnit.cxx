@@ -197,6 +197,20 @@ LinkUnit::setLinkSurf(const std::string& SList)
   return;
 }
 
+void
+LinkUnit::setLinkSurf(const HeadRule& HR,const int SN) 
+  /*!
+    Set the link rule and the primary link surface
+    separately [used to restore a saved link]
+    \param HR :: Link rule
+    \param SN :: Primary link surface [0 for none]
+  */
+{
+  mainSurf=HR;
+  linkSurf=SN;
+  return;
+}
+
 void
 LinkUnit::setLinkSurf(const HeadRule& HR) 
   /*!
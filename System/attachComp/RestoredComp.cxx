@@ -0,0 +1,117 @@
+/********************************************************************* 
+  CombLayer : MCNP(X) Input builder
+ 
+ * File:   attachComp/RestoredComp.cxx
+ *
+ * Copyright (c) 2004-2019 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+ *
+ ****************************************************************************/
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <cmath>
+#include <complex>
+#include <list>
+#include <vector>
+#include <set>
+#include <map>
+#include <string>
+#include <algorithm>
+#include <memory>
+
+#include "Exception.h"
+#include "FileReport.h"
+#include "GTKreport.h"
+#include "NameStack.h"
+#include "RegMethod.h"
+#include "OutputLog.h"
+#include "BaseVisit.h"
+#include "BaseModVisit.h"
+#include "MatrixBase.h"
+#include "Matrix.h"
+#include "Vec3D.h"
+#include "surfRegister.h"
+#include "Rules.h"
+#include "HeadRule.h"
+#include "LinkUnit.h"
+#include "FixedComp.h"
+#include "ContainedComp.h"
+#include "BaseMap.h"
+#include "CellMap.h"
+#include "SurfMap.h"
+#include "RestoredComp.h"
+
+namespace attachSystem
+{
+
+RestoredComp::RestoredComp(const std::string& Key,const size_t NL,
+			   const size_t resSize) :
+  FixedComp(Key,NL,resSize),ContainedComp(),
+  CellMap(),SurfMap()
+  /*!
+    Constructor 
+    \param Key :: KeyName
+    \param NL :: Number of links
+    \param resSize :: Number of cells to reserve
+  */
+{}
+
+RestoredComp::RestoredComp(const RestoredComp& A) : 
+  FixedComp(A),ContainedComp(A),
+  CellMap(A),SurfMap(A)
+  /*!
+    Copy constructor
+    \param A :: RestoredComp to copy
+  */
+{}
+
+RestoredComp&
+RestoredComp::operator=(const RestoredComp& A)
+  /*!
+    Assignment operator
+    \param A :: RestoredComp to copy
+    \return *this
+  */
+{
+  if (this!=&A)
+    {
+      FixedComp::operator=(A);
+      ContainedComp::operator=(A);
+      CellMap::operator=(A);
+      SurfMap::operator=(A);
+    }
+  return *this;
+}
+
+void
+RestoredComp::setLinkUnit(const size_t Index,const LinkUnit& LUnit)
+  /*!
+    Set a link unit directly
+    \param Index :: Link index
+    \param LUnit :: Link unit to copy
+  */
+{
+  ELog::RegMethod RegA("RestoredComp","setLinkUnit");
+
+  if (Index>=LU.size())
+    throw ColErr::IndexError<size_t>(Index,LU.size(),"Index");
+
+  LU[Index]=LUnit;
+  return;
+}
+
+}  // NAMESPACE attachSystem
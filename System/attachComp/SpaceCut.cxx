@@ -709,7 +709,7 @@ SpaceCut::insertPair(Simulation& System,
       if (!outerObj)
 	throw ColErr::InContainerError<int>
 	  (pCell,"Primary cell does not exist");
-      outerObj->addSurfString(BBox.display());
+      outerObj->addIntersection(BBox);
     }      
   return;
 }
@@ -739,7 +739,7 @@ SpaceCut::insertObjects(Simulation& System)
     {
       MonteCarlo::Object* outerObj=System.findObject(primaryCell);
       if (outerObj)
-	outerObj->addSurfString(outerCut.complement().display());
+	outerObj->addIntersection(outerCut.complement());
       else
 	throw ColErr::InContainerError<int>(primaryCell,
 					    "Cell not in Simulation");
@@ -777,7 +777,7 @@ SpaceCut::insertObjects(Simulation& System,
     {
       MonteCarlo::Object* outerObj=System.findObject(primaryCell);
       if (outerObj)
-	outerObj->addSurfString(outerCut.complement().display());
+	outerObj->addIntersection(outerCut.complement());
       else
 	throw ColErr::InContainerError<int>(primaryCell,
 					    "Cell not in Simulation");
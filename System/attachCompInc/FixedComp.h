@@ -183,6 +183,9 @@ class FixedComp
   LinkUnit getSignedLU(const long int) const;
   bool hasSideIndex(const std::string&) const;
   long int getSideIndex(const std::string&) const;
+  /// Access link point names
+  const std::map<std::string,size_t>& getKeyMap() const
+    { return keyMap; }
   
   std::vector<Geometry::Vec3D> getAllLinkPts() const;
 
@@ -83,6 +83,8 @@ class LinkUnit
   const Geometry::Vec3D& getAxis() const;
 
   int getLinkSurf() const;
+  /// Primary link surface [0 if not set]
+  int getLinkSurfNumber() const { return linkSurf; }
   std::string getLinkString() const;
 
   void setAxis(const Geometry::Vec3D&);
@@ -91,6 +93,7 @@ class LinkUnit
   void setLinkSurf(const int);
   void setLinkSurf(const std::string&);
   void setLinkSurf(const HeadRule&);
+  void setLinkSurf(const HeadRule&,const int);
 
   void addLinkSurf(const int);
   void addLinkSurf(const std::string&);
@@ -0,0 +1,61 @@
+/********************************************************************* 
+  CombLayer : MCNP(X) Input builder
+ 
+ * File:   attachCompInc/RestoredComp.h
+ *
+ * Copyright (c) 2004-2019 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+ *
+ ****************************************************************************/
+#ifndef attachSystem_RestoredComp_h
+#define attachSystem_RestoredComp_h
+
+namespace attachSystem
+{
+
+/*!
+  \class RestoredComp
+  \version 1.0
+  \author S. Ansell
+  \date May 2019
+  \brief Generic component restored from a geometry snapshot
+
+  Holds the link points, named cells/surfaces and outer 
+  surface of a component that was built in a previous run.
+  It is registered under the name of the original component
+  so tallies/sources/weights can refer to it. It does not 
+  have the type of the original component.
+*/
+
+class RestoredComp :
+  public FixedComp,
+  public ContainedComp,
+  public CellMap,
+  public SurfMap
+{
+ public:
+
+  RestoredComp(const std::string&,const size_t,const size_t);
+  RestoredComp(const RestoredComp&);
+  RestoredComp& operator=(const RestoredComp&);
+  virtual ~RestoredComp() {}   ///< Destructor
+
+  void setLinkUnit(const size_t,const LinkUnit&);
+  
+};
+
+}
+
+#endif
@@ -307,6 +307,7 @@ GateValveCylinder::createObjects(Simulation& System)
   ELog::RegMethod RegA("GateValveCylinder","createObjects");
 
   std::string Out;
+  HeadRule HR;
 
   const bool portAExtends(wallThick<=portALen);  // port extends
   const bool portBExtends(wallThick<=portBLen);  // port extends
@@ -316,26 +317,25 @@ GateValveCylinder::createObjects(Simulation& System)
   const std::string frontComp=frontComplement();  // -101
   const std::string backComp=backComplement();    // 102
   // Void 
-  Out=ModelSupport::getComposite(SMap,buildIndex,
-				 " 1 -2 (-7: (3 -4 5 -6))  (307:-301:302) ");
-  makeCell("Void",System,cellIndex++,voidMat,0.0,Out);
+  HR=ModelSupport::getHeadRule(SMap,buildIndex,
+			       " 1 -2 (-7: (3 -4 5 -6))  (307:-301:302) ");
+  makeCell("Void",System,cellIndex++,voidMat,0.0,HR);
 
   // Main body
-  Out=ModelSupport::getComposite(SMap,buildIndex,
-				 " 1 -2 7 -17 (-3:4:-5) ");
-  makeCell("Body",System,cellIndex++,wallMat,0.0,Out);
+  HR=ModelSupport::getHeadRule(SMap,buildIndex," 1 -2 7 -17 (-3:4:-5) ");
+  makeCell("Body",System,cellIndex++,wallMat,0.0,HR);
   // Top body
-  Out=ModelSupport::getComposite
+  HR=ModelSupport::getHeadRule
     (SMap,buildIndex," 11 -12 17 13 -14 -16 5 (-1:2:-3:4:6) ");
-  makeCell("Body",System,cellIndex++,wallMat,0.0,Out);
+  makeCell("Body",System,cellIndex++,wallMat,0.0,HR);
 
   // blade
-  Out=ModelSupport::getComposite(SMap,buildIndex," -307 301 -302 ");
-  makeCell("Blade",System,cellIndex++,bladeMat,0.0,Out);
+  HR=ModelSupport::getHeadRule(SMap,buildIndex," -307 301 -302 ");
+  makeCell("Blade",System,cellIndex++,bladeMat,0.0,HR);
 
   // front plate
-  Out=ModelSupport::getComposite(SMap,buildIndex," -1 11 -17 117 ");
-  makeCell("FrontPlate",System,cellIndex++,wallMat,0.0,Out);
+  HR=ModelSupport::getHeadRule(SMap,buildIndex," -1 11 -17 117 ");
+  makeCell("FrontPlate",System,cellIndex++,wallMat,0.0,HR);
   // seal ring
   Out=ModelSupport::getComposite(SMap,buildIndex," -1 107 -117 ");
   makeCell("FrontSeal",System,cellIndex++,wallMat,0.0,Out+frontStr);
@@ -350,8 +350,8 @@ GateValveCylinder::createObjects(Simulation& System)
     }
        
   // back plate
-  Out=ModelSupport::getComposite(SMap,buildIndex," 2 -12 -17 217 ");
-  makeCell("BackPlate",System,cellIndex++,wallMat,0.0,Out);
+  HR=ModelSupport::getHeadRule(SMap,buildIndex," 2 -12 -17 217 ");
+  makeCell("BackPlate",System,cellIndex++,wallMat,0.0,HR);
   // seal ring
   Out=ModelSupport::getComposite(SMap,buildIndex," 2 107 -217 ");
   makeCell("BackSeal",System,cellIndex++,wallMat,0.0,Out+backStr);
@@ -104,7 +104,9 @@ cellValueSet<N>::cellValueSet(const std::string& KN,
 template<size_t N>
 cellValueSet<N>::cellValueSet(const cellValueSet<N>& A) : 
   keyName(A.keyName),outName(A.outName),tag(A.tag),
-  scaleVec(A.scaleVec),dataMap(A.dataMap),
+  scaleVec(A.scaleVec),cellNum(A.cellNum),numValue(A.numValue),
+  strValue(A.strValue),unsetFlag(A.unsetFlag),strTable(A.strTable),
+  strTableIndex(A.strTableIndex),
   strRegister(A.strRegister),intRegister(A.intRegister)
   /*!
     Copy constructor
@@ -123,7 +125,12 @@ cellValueSet<N>::operator=(const cellValueSet<N>& A)
 {
   if (this!=&A)
     {
-      dataMap=A.dataMap;
+      cellNum=A.cellNum;
+      numValue=A.numValue;
+      strValue=A.strValue;
+      unsetFlag=A.unsetFlag;
+      strTable=A.strTable;
+      strTableIndex=A.strTableIndex;
       strRegister=A.strRegister;
       intRegister=A.intRegister;
       scaleVec=A.scaleVec;
@@ -145,7 +152,12 @@ cellValueSet<N>::clearAll()
     The big reset
   */
 {
-  dataMap.erase(dataMap.begin(),dataMap.end());
+  cellNum.clear();
+  numValue.clear();
+  strValue.clear();
+  unsetFlag.clear();
+  strTable.clear();
+  strTableIndex.clear();
   strRegister.erase(strRegister.begin(),strRegister.end());
   intRegister.erase(intRegister.begin(),intRegister.end());
   return;
@@ -191,21 +203,154 @@ cellValueSet<N>::getStrIndex(const int CN) const
 
   return mc->second;
 }
+
+template<size_t N>
+size_t
+cellValueSet<N>::cellRow(const int CN)
+  /*!
+    Get the row of a cell with all the values set to default.
+    Cells normally arrive in order so are added at the end.
+    \param CN :: Cell number
+    \return row index
+  */
+{
+  size_t row(cellNum.size());
+  if (cellNum.empty() || CN>cellNum.back())
+    {
+      cellNum.push_back(CN);
+      numValue.resize(numValue.size()+N,0.0);
+      strValue.resize(strValue.size()+N,-1);
+      unsetFlag.resize(unsetFlag.size()+N,1);
+      return row;
+    }
+
+  std::vector<int>::iterator vc=
+    std::lower_bound(cellNum.begin(),cellNum.end(),CN);
+  row=static_cast<size_t>(vc-cellNum.begin());
+  if (*vc!=CN)
+    {
+      cellNum.insert(vc,CN);
+      numValue.insert(numValue.begin()+
+		      static_cast<long int>(row*N),N,0.0);
+      strValue.insert(strValue.begin()+
+		      static_cast<long int>(row*N),N,-1);
+      unsetFlag.insert(unsetFlag.begin()+
+		       static_cast<long int>(row*N),N,1);
+    }
+  else
+    {
+      for(size_t i=row*N;i<(row+1)*N;i++)
+	{
+	  numValue[i]=0.0;
+	  strValue[i]=-1;
+	  unsetFlag[i]=1;
+	}
+    }
+  return row;
+}
+
+template<size_t N>
+void
+cellValueSet<N>::setItem(const size_t row,const size_t index,
+			 const double V)
+  /*!
+    Set a number value. The value is held as it would
+    be written [StrFunc::makeString]. Values past N are ignored.
+    \param row :: Cell row
+    \param index :: Value index
+    \param V :: Value
+  */
+{
+  if (index>=N) return;
+  const size_t I(row*N+index);
+  double D(V);
+  StrFunc::convert(StrFunc::makeString(V),D);
+  numValue[I]=D;
+  strValue[I]=-1;
+  unsetFlag[I]=0;
+  return;
+}
+
+template<size_t N>
+void
+cellValueSet<N>::setItem(const size_t row,const size_t index,
+			 const std::string& V)
+  /*!
+    Set a value from a string : def / number / string.
+    Values past N are ignored.
+    \param row :: Cell row
+    \param index :: Value index
+    \param V :: Value
+  */
+{
+  const size_t I(row*N+index);
+  if (index>=N || V=="def" || V=="Def")
+    return;
+
+  double D;
+  if (StrFunc::convert(V,D))
+    {
+      numValue[I]=D;
+      strValue[I]=-1;
+    }
+  else
+    {
+      std::map<std::string,int>::const_iterator mc=
+	strTableIndex.find(V);
+      if (mc==strTableIndex.end())
+	{
+	  strTable.push_back(V);
+	  mc=strTableIndex.emplace
+	    (V,static_cast<int>(strTable.size()-1)).first;
+	}
+      strValue[I]=mc->second;
+    }
+  unsetFlag[I]=0;
+  return;
+}
+
+template<size_t N>
+bool
+cellValueSet<N>::sameRow(const size_t rowA,const size_t rowB) const
+  /*!
+    Determine if two cells have the same values
+    \param rowA :: Cell row
+    \param rowB :: Cell row
+    \return true if all values are equal
+  */
+{
+  for(size_t index=0;index<N;index++)
+    {
+      const size_t IA(rowA*N+index);
+      const size_t IB(rowB*N+index);
+      if (unsetFlag[IA]!=unsetFlag[IB])
+	return 0;
+      if (!unsetFlag[IA])
+	{
+	  if (strValue[IA]!=strValue[IB])
+	    return 0;
+	  if (strValue[IA]<0 &&
+	      std::abs(numValue[IA]-numValue[IB])>Geometry::zeroTol)
+	    return 0;
+	}
+    }
+  return 1;
+}
   
 template<size_t N>  
 bool
 cellValueSet<N>::simpleSplit(std::vector<std::tuple<int,int>>& initCell,
-			     std::vector<valTYPE>& outData) const
+			     std::vector<size_t>& outData) const
 /*!
     Group the individual values into equal ranges. The 
     outData is a list of ranges with equal value. The
     goal of this method is to minimize the number of fluka cards. e.g
     cell 1 to 10 might all have the same importance values, so they can
     be expressed in FLUKA as a single importance/bias card with a range 
-    of cells.
+    of cells. A range is broken by a missing cell number.
 
     \param initCell :: initialization range
-    \param dataValue :: initialization range
+    \param outData :: row of the values of each range
     \return true if output required
    */
 {
@@ -214,77 +359,39 @@ cellValueSet<N>::simpleSplit(std::vector<std::tuple<int,int>>& initCell,
   initCell.clear();
   outData.clear();
 
-  if (dataMap.empty()) return 0;
-  const int lastCN=dataMap.rbegin()->first+1;       //ordered map
+  if (cellNum.empty()) return 0;
 
-  int prev(0);
-  valTYPE V;
-  for(int CN=dataMap.begin()->first;CN<=lastCN;CN++)
+  size_t prev(0);
+  for(size_t i=1;i<cellNum.size();i++)
     {
-      typename dataTYPE::const_iterator mc=dataMap.find(CN);	  
-      if (mc==dataMap.end())
+      if (cellNum[i]!=cellNum[i-1]+1 || !sameRow(prev,i))
 	{
-	  if (prev)
-	    {
-	      initCell.push_back(TITEM(prev,CN-1));
-	      outData.push_back(V);
-	      prev=0;
-	    }
-	}
-      else
-	{
-	  if (prev)
-	    {
-	      for(size_t index=0;index<N;index++)
-		{
-		  const int& VDef=V[index].first;
-		  const std::string& VS=V[index].second;
-		  const int& ADef=mc->second[index].first;
-		  const std::string& AS=mc->second[index].second;
-
-		  double VV,AV;
-		  int sumFlag=(VDef<1) ? 0 : StrFunc::convert(VS,VV);
-		  sumFlag+= (ADef<1) ? 0 : StrFunc::convert(AS,AV);
-
-		  if (VDef!=ADef ||           // diff flag
-		      (VDef &&                // def = def is a pass
-		       ((sumFlag!=2 && AS!=VS) ||
-			(sumFlag==2 && (std::abs(VV-AV)>Geometry::zeroTol))) ))
-		    {
-		      initCell.push_back(TITEM(prev,CN-1));
-		      outData.push_back(V);
-		      prev=CN;
-		      V=mc->second;
-		      break;
-		    }
-		}
-	    }
-	  else // new thing just initializs
-	    {
-	      prev=CN;
-	      V=mc->second;
-	    }
+	  initCell.push_back(TITEM(cellNum[prev],cellNum[i-1]));
+	  outData.push_back(prev);
+	  prev=i;
 	}
     }
-  return (initCell.empty()) ? 0 : 1;
+  initCell.push_back(TITEM(cellNum[prev],cellNum.back()));
+  outData.push_back(prev);
+  return 1;
 }
   
 template<size_t N>  
 bool
 cellValueSet<N>::cellSplit(const std::vector<int>& cellN,
 			   std::vector<std::tuple<int,int>>& initCell,
-			   std::vector<valTYPE>& outData) const
+			   std::vector<size_t>& outData) const
 /*!
     Group the individual values into equal ranges. The 
     outData is a list of ranges with equal value. The
     goal of this method is to minimize the number of fluka cards. e.g
     cell 1 to 10 might all have the same importance values, so they can
     be expressed in FLUKA as a single importance/bias card with a range 
-    of cells.
+    of cells. A range is broken by a cell with no value.
 
     \param cellN :: Cell values [normally excluding 0]
     \param initCell :: initialization range
-    \param dataValue :: initialization range
+    \param outData :: row of the values of each range
     \return true if output required
    */
 {
@@ -292,67 +399,73 @@ cellValueSet<N>::cellSplit(const std::vector<int>& cellN,
   initCell.clear();
   outData.clear();
  
-  if (dataMap.empty() || cellN.empty()) return 0;
-  size_t prev(0);
-  valTYPE V;
+  if (cellNum.empty() || cellN.empty()) return 0;
+
+  size_t prev(0);        // index+1 in cellN of range start
+  size_t prevRow(0);     // row of range start
+  size_t row(0);         // search point [cellN normally in order]
   for(size_t i=0;i<cellN.size();i++)
     {
       const int CN=cellN[i];
-      typename dataTYPE::const_iterator mc=dataMap.find(CN);
-      if (mc==dataMap.end())
+      std::vector<int>::const_iterator vc=
+	(row<cellNum.size() && cellNum[row]<=CN) ?
+	std::lower_bound(cellNum.begin()+static_cast<long int>(row),
+			 cellNum.end(),CN) :
+	std::lower_bound(cellNum.begin(),cellNum.end(),CN);
+      row=static_cast<size_t>(vc-cellNum.begin());
+
+      if (vc==cellNum.end() || *vc!=CN)
 	{
 	  if (prev)
 	    {
 	      initCell.push_back(TITEM(cellN[prev-1],cellN[i-1]));
-	      outData.push_back(V);
+	      outData.push_back(prevRow);
 	      prev=0;
 	    }
 	}
-      else
+      else if (!prev)
 	{
-	  if (prev)
-	    {
-	      for(size_t index=0;index<N;index++)
-		{
-		  const int& VDef=V[index].first;
-		  const std::string& VS=V[index].second;
-		  const int& ADef=mc->second[index].first;
-		  const std::string& AS=mc->second[index].second;
-
-		  double VV,AV;
-		  int sumFlag=(VDef<1) ? 0 : StrFunc::convert(VS,VV);
-		  sumFlag+= (ADef<1) ? 0 : StrFunc::convert(AS,AV);
-
-		  if (VDef!=ADef ||           // diff flag
-		      (VDef &&                // def = def is a pass
-		       ((sumFlag!=2 && AS!=VS) ||
-			(sumFlag==2 && (std::abs(VV-AV)>Geometry::zeroTol))) ))
-		    {
-		      initCell.push_back(TITEM(cellN[prev-1],cellN[i-1]));
-		      outData.push_back(V);
-		      prev=i+1;
-		      V=mc->second;
-		      break;
-		    }
-		}
-	    }
-	  else if (!prev)
-	    {
-	      prev=i+1;
-	      V=mc->second;
-	    }
+	  prev=i+1;
+	  prevRow=row;
+	}
+      else if (!sameRow(prevRow,row))
+	{
+	  initCell.push_back(TITEM(cellN[prev-1],cellN[i-1]));
+	  outData.push_back(prevRow);
+	  prev=i+1;
+	  prevRow=row;
 	}
     }
 
-
   if (prev)
     {
       initCell.push_back(TITEM(cellN[prev-1],cellN.back()));
-      outData.push_back(V);
+      outData.push_back(prevRow);
     }
   return (initCell.empty()) ? 0 : 1;
 }
 
+template<size_t N> 
+void
+cellValueSet<N>::setValue(const int cN,const size_t index,
+			  const double V)
+  /*!
+    Set a single value of a cell [others are unchanged]
+    \param cN :: Cell number   
+    \param index :: Value index
+    \param V :: value for cell
+  */
+{
+  if (index>=N)
+    throw ColErr::IndexError<size_t>(index,N,"cellValueSet::setValue");
+
+  std::vector<int>::const_iterator vc=
+    std::lower_bound(cellNum.begin(),cellNum.end(),cN);
+  const size_t row=(vc!=cellNum.end() && *vc==cN) ?
+    static_cast<size_t>(vc-cellNum.begin()) : cellRow(cN);
+  setItem(row,index,V);
+  return;
+}
 
 template<size_t N> 
 void
@@ -362,8 +475,7 @@ cellValueSet<N>::setValues(const int cN)
     \param cN :: Cell number   
   */
 {
-  valTYPE A;
-  dataMap[cN]=A;
+  cellRow(cN);
   return;
 }
 
@@ -376,10 +488,8 @@ cellValueSet<N>::setValues(const int cN,const double V)
     \param V :: value for cell
   */
 {
-  valTYPE A;
-  A[0].first=1;
-  A[0].second=StrFunc::makeString(V);
-  dataMap[cN]=A;
+  const size_t row=cellRow(cN);
+  setItem(row,0,V);
   return;
 }
 
@@ -395,12 +505,9 @@ cellValueSet<N>::setValues(const int cN,
     \param V2 :: value for cell
   */
 {
-  valTYPE A;
-  A[0].first=1;
-  A[0].second=StrFunc::makeString(V);
-  A[1].first=1;
-  A[1].second=StrFunc::makeString(V2);
-  dataMap[cN]=A;
+  const size_t row=cellRow(cN);
+  setItem(row,0,V);
+  setItem(row,1,V2);
   return;
 }
 
@@ -416,14 +523,10 @@ cellValueSet<N>::setValues(const int cN,const double V,
     \param V3 :: value for cell
   */
 {
-  valTYPE A;
-  A[0].first=1;         // 1: values
-  A[0].second=StrFunc::makeString(V);
-  A[1].first=1;
-  A[1].second=StrFunc::makeString(V2);
-  A[2].first=1;
-  A[2].second=StrFunc::makeString(V3);
-  dataMap[cN]=A;
+  const size_t row=cellRow(cN);
+  setItem(row,0,V);
+  setItem(row,1,V2);
+  setItem(row,2,V3);
   return;
 }
 
@@ -436,16 +539,8 @@ cellValueSet<N>::setValues(const int cN,const std::string& V)
     \param V :: value for cell
   */
 {
-  valTYPE A;
-  if (V=="def" || V=="Def")
-    A[0].first=0;
-  else
-    {
-      double D;
-      A[0].first= (StrFunc::convert(V,D)) ? 1 : -1;
-      A[0].second=V;
-    }
-  dataMap[cN]=A;
+  const size_t row=cellRow(cN);
+  setItem(row,0,V);
   return;
 }
   
@@ -460,21 +555,10 @@ cellValueSet<N>::setValues(const int cN,const std::string& V1,
     \param V2 :: value for cell
   */
 {
-  valTYPE A;
+  const size_t row=cellRow(cN);
   const std::vector<const std::string*> VStr({&V1,&V2});
   for(size_t i=0;i<VStr.size() && i<N;i++)
-    {
-      if (*VStr[i]=="def" || *VStr[i]=="Def")
-	A[i].first=0;
-      else
-	{
-	  double D;
-	  A[i].first= (StrFunc::convert(*VStr[i],D)) ? 1 : -1;
-	  A[i].second= *VStr[i];
-	}
-      
-    }
-  dataMap[cN]=A;
+    setItem(row,i,*VStr[i]);
   return;
 }
 
@@ -491,20 +575,10 @@ cellValueSet<N>::setValues(const int cN,const std::string& V1,
     \param V3 :: value for cell    
   */
 {
-  valTYPE A;
+  const size_t row=cellRow(cN);
   const std::vector<const std::string*> VStr({&V1,&V2,&V3});
   for(size_t i=0;i<VStr.size() && i<N;i++)
-    {
-      if (*VStr[i]=="def" || *VStr[i]=="Def")
-	A[i].first=0;
-      else
-	{
-	  double D;
-	  A[i].first= (StrFunc::convert(*VStr[i],D)) ? 1 : -1;
-	  A[i].second= *VStr[i];
-	}
-    }
-  dataMap[cN]=A;
+    setItem(row,i,*VStr[i]);
   return;
 }
 
@@ -574,77 +648,92 @@ cellValueSet<N>::setValues(const std::string& cStr,
 
 template<size_t N>
 void
-cellValueSet<N>::writeFLUKA(std::ostream& OX,
-			    const std::string& ControlStr) const 
+cellValueSet<N>::writeRange(std::ostream& OX,
+			    const std::string& ControlStr,
+			    const std::vector<std::tuple<int,int>>& Bgroup,
+			    const std::vector<size_t>& Bdata) const 
 /*!
-    Process is to write keyName ControlStr units 
+    Write a card for each range
     \param OX :: Output stream
     \param ControlStr units [%0/%1/%2] for cell range/Value
+    \param Bgroup :: Cell ranges
+    \param Bdata :: Row of the values of each range
   */
 {
-  ELog::RegMethod RegA("cellValueSet","writeFLUKA[no-cell]");
+  ELog::RegMethod RegA("cellValueSet","writeRange");
   
   typedef std::tuple<int,int> TITEM;
 
   std::ostringstream cx;
-  std::vector<TITEM> Bgroup;
-  std::vector<valTYPE> Bdata;
+  const std::vector<std::string> Units=StrFunc::StrParts(ControlStr);
+  std::vector<std::string> SArray(3+N);
 
-  if (simpleSplit(Bgroup,Bdata))
+  for(size_t index=0;index<Bgroup.size();index++)
     {
-      const std::vector<std::string> Units=StrFunc::StrParts(ControlStr);
-      std::vector<std::string> SArray(3+N);
+      const TITEM& tc(Bgroup[index]);
+      const size_t row(Bdata[index]);
 
-      for(size_t index=0;index<Bgroup.size();index++)
-	{
-	  const TITEM& tc(Bgroup[index]);
-	  const valTYPE& dArray(Bdata[index]);
-
-	  const int AA=std::get<0>(tc);
-	  const int AB=std::get<1>(tc);
-	  SArray[0]=(AA<0) ? getStrIndex(AA) : std::to_string(AA);
-	  SArray[1]=(AB<0) ? getStrIndex(AB) : std::to_string(AB);
+      const int AA=std::get<0>(tc);
+      const int AB=std::get<1>(tc);
+      SArray[0]=(AA<0) ? getStrIndex(AA) : std::to_string(AA);
+      SArray[1]=(AB<0) ? getStrIndex(AB) : std::to_string(AB);
 
-	  for(size_t i=0;i<N;i++)
-	    {
-	      if (dArray[i].first==1)
-		{
-		  double D;
-		  StrFunc::convert(dArray[i].second,D);
-		  SArray[2+i]=StrFunc::makeString(D*scaleVec[i]);
-		}
-	      else if (dArray[i].first == -1)
-		SArray[2+i]=dArray[i].second;
-	      else
-		SArray[2+i]="-";
-	    }
-	  cx.str("");
-	  cx<<outName<<" ";
+      for(size_t i=0;i<N;i++)
+	{
+	  const size_t I(row*N+i);
+	  if (unsetFlag[I])
+	    SArray[2+i]="-";
+	  else if (strValue[I]>=0)
+	    SArray[2+i]=strTable[static_cast<size_t>(strValue[I])];
+	  else
+	    SArray[2+i]=StrFunc::makeString(numValue[I]*scaleVec[i]);
+	}
+      cx.str("");
+      cx<<outName<<" ";
 
-	  for(const std::string& UC : Units)
+      for(const std::string& UC : Units)
+	{
+	  if (UC.size()==2 &&
+	      (UC[0]=='%' || UC[0]=='R' ||
+	       UC[0]=='M' || UC[0]=='P'))
 	    {
-	      if (UC.size()==2 &&
-		  (UC[0]=='%' || UC[0]=='R' ||
-		   UC[0]=='M' || UC[0]=='P'))
-		{
-		  const size_t SA=(static_cast<size_t>(UC[1]-'0') % (N+2));
-		  if (UC[0]=='%')
-		    cx<<SArray[SA]<<" ";
-		  else if (UC[0]=='M' || UC[0]=='R')
-		    cx<<UC[0]<<SArray[SA]<<" ";
-		  else if (UC[0]=='P')
-		    cx<<StrFunc::toUpperString(SArray[SA])<<" ";
-		}
-	      else
-		cx<<UC<<" ";
+	      const size_t SA=(static_cast<size_t>(UC[1]-'0') % (N+2));
+	      if (UC[0]=='%')
+		cx<<SArray[SA]<<" ";
+	      else if (UC[0]=='M' || UC[0]=='R')
+		cx<<UC[0]<<SArray[SA]<<" ";
+	      else if (UC[0]=='P')
+		cx<<StrFunc::toUpperString(SArray[SA])<<" ";
 	    }
-	  cx<<tag;
-	  StrFunc::writeFLUKA(cx.str(),OX);
+	  else
+	    cx<<UC<<" ";
 	}
+      cx<<tag;
+      StrFunc::writeFLUKA(cx.str(),OX);
     }
   return;
 }
 
+template<size_t N>
+void
+cellValueSet<N>::writeFLUKA(std::ostream& OX,
+			    const std::string& ControlStr) const 
+/*!
+    Process is to write keyName ControlStr units 
+    \param OX :: Output stream
+    \param ControlStr units [%0/%1/%2] for cell range/Value
+  */
+{
+  ELog::RegMethod RegA("cellValueSet","writeFLUKA[no-cell]");
+  
+  std::vector<std::tuple<int,int>> Bgroup;
+  std::vector<size_t> Bdata;
+
+  if (simpleSplit(Bgroup,Bdata))
+    writeRange(OX,ControlStr,Bgroup,Bdata);
+  return;
+}
+
 template<size_t N>
 void
 cellValueSet<N>::writeFLUKA(std::ostream& OX,
@@ -659,65 +748,11 @@ cellValueSet<N>::writeFLUKA(std::ostream& OX,
 {
   ELog::RegMethod RegA("cellValueSet","writeFLUKA");
   
-  typedef std::tuple<int,int> TITEM;
-
-  std::ostringstream cx;
-  std::vector<TITEM> Bgroup;
-  std::vector<valTYPE> Bdata;
+  std::vector<std::tuple<int,int>> Bgroup;
+  std::vector<size_t> Bdata;
 
   if (cellSplit(cellN,Bgroup,Bdata))
-    {	
-      const std::vector<std::string> Units=StrFunc::StrParts(ControlStr);
-      std::vector<std::string> SArray(3+N);
-
-      for(size_t index=0;index<Bgroup.size();index++)
-	{
-	  const TITEM& tc(Bgroup[index]);
-	  const valTYPE& dArray(Bdata[index]);
-
-	  const int AA=std::get<0>(tc);
-	  const int AB=std::get<1>(tc);
-	  SArray[0]=(AA<0) ? getStrIndex(AA) : std::to_string(AA);
-	  SArray[1]=(AB<0) ? getStrIndex(AB) : std::to_string(AB);
-	  for(size_t i=0;i<N;i++)
-	    {
-	      if (dArray[i].first==1)
-		{
-		  double D;
-		  StrFunc::convert(dArray[i].second,D);
-		  SArray[2+i]=StrFunc::makeString(D*scaleVec[i]);
-		}
-	      else if (dArray[i].first == -1)
-		SArray[2+i]=dArray[i].second;
-	      else
-		SArray[2+i]="-";
-	    }
-	  cx.str("");
-	  cx<<outName<<" ";
-
-	  for(const std::string& UC : Units)
-	    {
-	      if (UC.size()==2 &&
-		  (UC[0]=='%' || UC[0]=='R' || UC[0]=='M'
-		   || UC[0]=='P'))
-		{
-		  const size_t SA=(static_cast<size_t>(UC[1]-'0') % (N+2));
-		  if (UC[0]=='%')
-		    cx<<SArray[SA]<<" ";
-		  else if (UC[0]=='M' || UC[0]=='R')
-		    cx<<UC[0]<<SArray[SA]<<" ";
-		  else if (UC[0]=='P')
-		    cx<<StrFunc::toUpperString(SArray[SA])<<" ";
-		}
-	      else
-		cx<<UC<<" ";
-	    }
-	  cx<<tag;
-
-
-	  StrFunc::writeFLUKA(cx.str(),OX);
-	}
-    }
+    writeRange(OX,ControlStr,Bgroup,Bdata);
   return;
 }
 
@@ -31,6 +31,11 @@ namespace flukaSystem
   \date March 2018
   \author S.Ansell
   \brief Processes the physics cards in the FLUKA output
+
+  Values are held in columns [cell*N+index] against a sorted
+  cell vector. Each value is default [unset], a number or a
+  string [index into strTable], so ranges of equal cells are
+  found in a single pass without re-reading the strings.
 */
 
 template <size_t N>
@@ -38,26 +43,35 @@ class cellValueSet
 {
  private:
 
-  /// Data type [-1:string / 0:def / 1 double]
-  typedef  std::array<std::pair<int,std::string>,N> valTYPE;  
-  /// map type [-ve int for string type]
-  typedef  std::map<int,valTYPE> dataTYPE;
-
   const std::string keyName;               ///< Key name
   const std::string outName;               ///< Output name for FLUKA
   const std::string tag;                   ///< Tag name
 
   std::array<double,N> scaleVec;           ///< Scaling for values
-  dataTYPE dataMap;                        ///< Values for cell
+
+  std::vector<int> cellNum;                ///< Cells [sorted, -ve string]
+  std::vector<double> numValue;            ///< Number values
+  std::vector<int> strValue;               ///< String values [-1 : number]
+  std::vector<bool> unsetFlag;             ///< Default values
+  std::vector<std::string> strTable;       ///< String values
+  std::map<std::string,int> strTableIndex; ///< String value : index
 
   std::map<int,std::string> strRegister;   ///< string register
   std::map<std::string,int> intRegister;   ///< string to int regier
+
+  size_t cellRow(const int);
+  void setItem(const size_t,const size_t,const double);
+  void setItem(const size_t,const size_t,const std::string&);
+  bool sameRow(const size_t,const size_t) const;
   
   bool simpleSplit(std::vector<std::tuple<int,int>>&,
-		   std::vector<valTYPE>&) const;
+		   std::vector<size_t>&) const;
   bool cellSplit(const std::vector<int>&,
 		 std::vector<std::tuple<int,int>>&,
-		 std::vector<valTYPE>&) const;
+		 std::vector<size_t>&) const;
+  void writeRange(std::ostream&,const std::string&,
+		  const std::vector<std::tuple<int,int>>&,
+		  const std::vector<size_t>&) const;
 
   int makeStrIndex(const std::string&);
   const std::string& getStrIndex(const int) const;
@@ -75,6 +89,8 @@ class cellValueSet
   virtual ~cellValueSet();
 
   void clearAll();
+  /// Number of cells set
+  size_t size() const { return cellNum.size(); }
 
   void setValue(const int,const size_t,const double);
   void setValues(const int);    
@@ -28,6 +28,7 @@
 #include <vector>
 #include <map>
 #include <iterator>
+#include <algorithm>
 
 #include "Exception.h"
 #include "FileReport.h"
@@ -184,15 +185,43 @@ Code::subStackPtr(const size_t AS)
 
 
 
-template<typename T>
-T
-Code::Eval(varList* Vars)
+template<> double Code::zeroType();
+template<> Geometry::Vec3D Code::zeroType();
+
+int
+Code::evalStack(varList* Vars,double& DOut,
+		Geometry::Vec3D& VOut) const
   /*!
     The function that evaluates everything
     \param Vars :: Vector of variable pointers
-    \returns value of Function expression
+    \param DOut :: Value if a double
+    \param VOut :: Value if a vector
+    \retval 0 :: double result
+    \retval 1 :: Vec3D result
+    \retval -1 :: invalid operation
   */
 {
+  // small expressions do not need the heap
+  const size_t localSize(16);
+  int localType[localSize];
+  double localStack[localSize];
+  Geometry::Vec3D localVec[localSize];
+  std::vector<int> heapType;
+  std::vector<double> heapStack;
+  std::vector<Geometry::Vec3D> heapVec;
+  if (StackSize>localSize)
+    {
+      heapType.resize(StackSize);
+      heapStack.resize(StackSize);
+      heapVec.resize(StackSize);
+    }
+  int* stackType=(StackSize>localSize) ? heapType.data() : localType;
+  double* Stack=(StackSize>localSize) ? heapStack.data() : localStack;
+  Geometry::Vec3D* StackVec=
+    (StackSize>localSize) ? heapVec.data() : localVec;
+  std::fill(stackType,stackType+std::max(StackSize,size_t(1)),0);
+  std::fill(Stack,Stack+std::max(StackSize,size_t(1)),0.0);
+  
   const size_t ByteCodeSize = ByteCode.size();
   size_t IP(0);       // Bytecode Pointer
   size_t DP(0);       // Immediated points (data)
@@ -200,9 +229,6 @@ Code::Eval(varList* Vars)
   size_t SP(0);       // Stack pointer  
   SP--;
 
-  std::vector<int> stackType(StackSize);
-  std::vector<double> Stack(StackSize);
-  std::vector<Geometry::Vec3D> StackVec(StackSize);
   while (IP<ByteCodeSize)
     {
       switch(ByteCode[IP])
@@ -217,13 +243,13 @@ Code::Eval(varList* Vars)
 	  else if (stackType[SP]==0)  // double
 	    Stack[SP] = fabs(Stack[SP]); 
 	  else
-	    return zeroType<T>();
+	    return -1;
 	  break;
 	  
 	case  Opcodes::cAcos: 
 	  if(stackType[SP]==1 || 
 	     (Stack[SP] < -1 || Stack[SP] > 1))
-	    return zeroType<T>();
+	    return -1;
 	  Stack[SP] = acos(Stack[SP]); 
 	  break;
 
@@ -231,13 +257,13 @@ Code::Eval(varList* Vars)
 	  if(stackType[SP]==0)
 	    Stack[SP] = acosh(Stack[SP]); 
 	  else 
-	    return zeroType<T>();
+	    return -1;
 	  break;
 
 	case Opcodes::cAsin: 
 	  if(stackType[SP]==1 || 
 	     Stack[SP] < -1 || Stack[SP] > 1)
-	    return zeroType<T>();
+	    return -1;
 	  Stack[SP] = asin(Stack[SP]); 
 	  break;
 	  
@@ -245,19 +271,19 @@ Code::Eval(varList* Vars)
 	  if(stackType[SP]==0)
 	    Stack[SP] = asinh(Stack[SP]); 
 	  else 
-	    return zeroType<T>();
+	    return -1;
 	  break;
 
 	case  Opcodes::cAtan: 
 	  if(stackType[SP]==1)
-	    return zeroType<T>();
+	    return -1;
 	  Stack[SP] = atan(Stack[SP]); 
 	  break;
 
 
 	case Opcodes::cAtan2: 
 	  if(!SP || stackType[SP-1]==1 || stackType[SP]==1)
-	    return zeroType<T>();
+	    return -1;
 
 	  Stack[SP-1] = atan2(Stack[SP-1], Stack[SP]);
 	  SP--; 
@@ -267,79 +293,79 @@ Code::Eval(varList* Vars)
 	  if(stackType[SP]==0)
 	    Stack[SP] = atanh(Stack[SP]); 
 	  else 
-	    return zeroType<T>();
+	    return -1;
 	  break;
 
 	case Opcodes::cCeil: 
 	  if(stackType[SP]==0)
 	    Stack[SP] = ceil(Stack[SP]); 
 	  else 
-	    return zeroType<T>();
+	    return -1;
 	  break;
 
 	case Opcodes::cCos: 
 	  if(stackType[SP]==0)
 	    Stack[SP] = cos(Stack[SP]); 
 	  else 
-	    return zeroType<T>();
+	    return -1;
 	  break;
 	
 	case Opcodes::cCosd: 
 	  if(stackType[SP]==0)
 	    Stack[SP] = cos(M_PI*Stack[SP]/180.0); 
 	  else 
-	    return zeroType<T>();
+	    return -1;
 	  break;
 
 	case  Opcodes::cCosh: 
 	  if(stackType[SP]==0)
 	    Stack[SP] = cosh(Stack[SP]); 
 	  else 
-	    return zeroType<T>();
+	    return -1;
 	  break;
 
 	case  Opcodes::cCot:
 	  if(stackType[SP]==0)
 	    {
 	      const double t = tan(Stack[SP]);
-	      if(t == 0) zeroType<T>();
+	      if(t == 0) zeroType<double>();
 	      Stack[SP] = 1/t; 
 	    }
 	  else 
-	    return zeroType<T>();
+	    return -1;
 	  break;
 
 	case  Opcodes::cCotd:
 	  if(stackType[SP]==0)
 	    {
 	      const double t = tan(M_PI*Stack[SP]/180.0);
-	      if(t == 0) zeroType<T>();
+	      if(t == 0) zeroType<double>();
 	      Stack[SP] = 1/t; 
 	    }
 	  else 
-	    return zeroType<T>();
+	    return -1;
 	  break;
 
 	case  Opcodes::cCsc:
 	  if(stackType[SP]==0)
 	    {
 	      const double t = sin(Stack[SP]);
-	      if(t == 0) zeroType<T>();
+	      if(t == 0) zeroType<double>();
 	      Stack[SP] = 1/t; 
 	    }
 	  else 
-	    return zeroType<T>();
+	    return -1;
 	  break;
 
 	case  Opcodes::cCscd:
 	  if(stackType[SP]==0)
 	    {
 	      const double t = sin(M_PI*Stack[SP]/180.0);
-	      if(t == 0) zeroType<T>();
+	      if(t == 0) zeroType<double>();
 	      Stack[SP] = 1/t; 
 	    }
 	  else 
-	    return zeroType<T>();
+	    return -1;
 	  break;
 
 	case Opcodes::cDot: 
@@ -350,54 +376,54 @@ Code::Eval(varList* Vars)
 	      SP--;
 	    }
 	  else 
-	    return zeroType<T>();
+	    return -1;
 	  break;
 
 	case Opcodes::cExp: 
 	  if(stackType[SP]==0)
 	    Stack[SP] = exp(Stack[SP]); 
 	  else 
-	    return zeroType<T>();
+	    return -1;
 	  break;
 
 	case Opcodes::cFloor: 
 	  if(stackType[SP]==0)
 	    Stack[SP] = floor(Stack[SP]); 
 	  else 
-	    return zeroType<T>();
+	    return -1;
 	  break;
 	      
 	case Opcodes::cInt: 
 	  if(stackType[SP]==0)
 	    Stack[SP] = int(Stack[SP]+0.5); 
 	  else 
-	    return zeroType<T>();
+	    return -1;
 	  break;
 
 	case Opcodes::cLog: 
 	  if(stackType[SP]==0 && Stack[SP] <= 0.0)
 	    Stack[SP] = log(Stack[SP]); 
 	  else 
-	    return zeroType<T>();
+	    return -1;
 	  break;
 
 	case Opcodes::cLog10: 
 	  if(stackType[SP]==0 && Stack[SP] <= 0.0)
 	    Stack[SP] = log10(Stack[SP]); 
 	  else 
-	    return zeroType<T>();
+	    return -1;
 	  break;
 
 	case Opcodes::cMax: 
 	  if(!SP || stackType[SP-1]==1 || stackType[SP]==1)
-	    return zeroType<T>();
+	    return -1;
 	  Stack[SP-1] = (Stack[SP-1]>Stack[SP]) ? Stack[SP-1] : Stack[SP];
 	  SP--; 
 	  break;
 
 	case Opcodes::cMin: 
 	  if(!SP || stackType[SP-1]==1 || stackType[SP]==1)
-	    return zeroType<T>();
+	    return -1;
 	  Stack[SP-1] = (Stack[SP-1]<Stack[SP]) ? Stack[SP-1] : Stack[SP];
 	  SP--; 
 	  break;
@@ -406,22 +432,22 @@ Code::Eval(varList* Vars)
 	  if(stackType[SP]==0)
 	    {
 	      const double t = cos(Stack[SP]);
-	      if(t == 0) zeroType<T>();
+	      if(t == 0) zeroType<double>();
 	      Stack[SP] = 1/t; 
 	    }
 	  else 
-	    return zeroType<T>();
+	    return -1;
 	  break;
 
 	case  Opcodes::cSecd:
 	  if(stackType[SP]==0)
 	    {
 	      const double t = cos(M_PI*Stack[SP]/180.0);
-	      if(t == 0) zeroType<T>();
+	      if(t == 0) zeroType<double>();
 	      Stack[SP] = 1/t; 
 	    }
 	  else 
-	    return zeroType<T>();
+	    return -1;
 	  break;
 
 
@@ -429,49 +455,49 @@ Code::Eval(varList* Vars)
 	  if(stackType[SP]==0)
 	    Stack[SP] = sin(Stack[SP]); 
 	  else 
-	    return zeroType<T>();
+	    return -1;
 	  break;
 
 	case Opcodes::cSind: 
 	  if(stackType[SP]==0)
 	    Stack[SP] = sin(M_PI*Stack[SP]/180.0); 
 	  else 
-	    return zeroType<T>();
+	    return -1;
 	  break;
 
 	case Opcodes::cSinh: 
 	  if(stackType[SP]==0)
 	    Stack[SP] = sinh(Stack[SP]); 
 	  else 
-	    return zeroType<T>();
+	    return -1;
 	  break;
 
 	case Opcodes::cSqrt: 
 	  if(stackType[SP]==0)
 	    Stack[SP] = sqrt(Stack[SP]); 
 	  else 
-	    return zeroType<T>();
+	    return -1;
 	  break;
 
 	case Opcodes::cTan: 
 	  if(stackType[SP]==0)
 	    Stack[SP] = tan(Stack[SP]); 
 	  else 
-	    return zeroType<T>();
+	    return -1;
 	  break;
 
 	case Opcodes::cTand: 
 	  if(stackType[SP]==0)
 	    Stack[SP] = tan(M_PI*Stack[SP]/180.0); 
 	  else 
-	    return zeroType<T>();
+	    return -1;
 	  break;
 
 	case Opcodes::cTanh: 
 	  if(stackType[SP]==0)
 	    Stack[SP] = tanh(Stack[SP]); 
 	  else 
-	    return zeroType<T>();
+	    return -1;
 	  break;
 
 	case Opcodes::cVec3D: 
@@ -484,7 +510,7 @@ Code::Eval(varList* Vars)
 	      SP-=2;
 	    }
 	  else 
-	    return zeroType<T>();
+	    return -1;
 	  break;
 
 	case Opcodes::cImmed: 
@@ -508,7 +534,7 @@ Code::Eval(varList* Vars)
 	  else if  (stackType[SP]==0)
 	    Stack[SP] = -Stack[SP]; 
 	  else 
-	    return zeroType<T>();
+	    return -1;
 	  break;
 
 	case Opcodes::cAdd: 
@@ -517,7 +543,7 @@ Code::Eval(varList* Vars)
 	  else if (SP && stackType[SP]==0 && stackType[SP-1]==0)
 	    Stack[SP-1] += Stack[SP]; 
 	  else 
-	    return zeroType<T>();
+	    return -1;
 	  SP--;
 	  break;
 	  
@@ -527,7 +553,7 @@ Code::Eval(varList* Vars)
 	  else if (SP && stackType[SP]==0 && stackType[SP-1]==0)
 	    Stack[SP-1] -= Stack[SP]; 
 	  else 
-	    return zeroType<T>();
+	    return -1;
 	  SP--;
 	  break;
 
@@ -544,7 +570,7 @@ Code::Eval(varList* Vars)
 	  else if (SP && stackType[SP]==0 && stackType[SP-1]==1)
 	    StackVec[SP-1] *= Stack[SP];
 	  else 
-	    return zeroType<T>();
+	    return -1;
 	  SP--;
 	  break;
 	  
@@ -556,7 +582,7 @@ Code::Eval(varList* Vars)
 		   Stack[SP]!=0.0)
 	    StackVec[SP-1] /= Stack[SP];
 	  else 
-	    return zeroType<T>();
+	    return -1;
 	  SP--;
 	  break;
 	  
@@ -565,7 +591,7 @@ Code::Eval(varList* Vars)
 	      stackType[SP-1]==0 && Stack[SP]!=0)
 	    Stack[SP-1] = fmod(Stack[SP-1], Stack[SP]);
 	  else
-	    return zeroType<T>();
+	    return -1;
 	  SP--; 
 	  break;
 
@@ -573,7 +599,7 @@ Code::Eval(varList* Vars)
 	  if (SP && stackType[SP]==0 && stackType[SP-1]==0)
 	    Stack[SP-1] = pow(Stack[SP-1], Stack[SP]);
 	  else
-	    return zeroType<T>();
+	    return -1;
 	  SP--; 
 	  break;
 	      
@@ -582,21 +608,21 @@ Code::Eval(varList* Vars)
 	  if(stackType[SP]==0)
 	    Stack[SP] = 180.0*Stack[SP]/M_PI; 
 	  else 
-	    return zeroType<T>();
+	    return -1;
 	  break;
 	  
 	case  Opcodes::cRad: 
 	  if(stackType[SP]==0)
 	    Stack[SP] = M_PI*Stack[SP]/180.0; 
 	  else 
-	    return zeroType<T>();
+	    return -1;
 	  break;
 
 	case Opcodes::cInv:
 	  if(stackType[SP]==0 && Stack[SP]!=0)
 	    Stack[SP] = 1.0/Stack[SP];
 	  else 
-	    return zeroType<T>();
+	    return -1;
 	  break;
 
 	case Opcodes::cEqual: 
@@ -608,7 +634,7 @@ Code::Eval(varList* Vars)
 	default:
 	  if (ByteCode[IP]<0)
 	    {
-	      if (SP>=Stack.size())
+	      if (SP>=StackSize)
 		throw ColErr::InContainerError<size_t>
 		  (SP,"Code::Eval has looped");
 	    }
@@ -623,9 +649,61 @@ Code::Eval(varList* Vars)
       IP++;
     }
 
-  return (stackType[SP]) ? 
-    typeConvert<T>(StackVec[SP]) : 
-    typeConvert<T>(Stack[SP]);
+  if (stackType[SP])
+    {
+      VOut=StackVec[SP];
+      return 1;
+    }
+  DOut=Stack[SP];
+  return 0;
+}
+
+template<typename T>
+T
+Code::getResult(const int flag,const double& DValue,
+		const Geometry::Vec3D& VValue)
+  /*!
+    Convert an evaluated result to the output type
+    \param flag :: Result of evalStack
+    \param DValue :: double result
+    \param VValue :: Vec3D result
+    \return value of the expression
+  */
+{
+  if (flag<0)
+    return zeroType<T>();
+  return (flag) ? typeConvert<T>(VValue) : typeConvert<T>(DValue);
+}
+
+template<typename T>
+T
+Code::Eval(varList* Vars) const
+  /*!
+    The function that evaluates everything
+    \param Vars :: Vector of variable pointers
+    \returns value of Function expression
+  */
+{
+  double DValue(0.0);
+  Geometry::Vec3D VValue;
+  const int flag=evalStack(Vars,DValue,VValue);
+  return getResult<T>(flag,DValue,VValue);
+}
+
+std::vector<int>
+Code::getVarIndex() const
+  /*!
+    Get the variables used in the expression
+    \return variable indexes [sorted/unique]
+  */
+{
+  std::vector<int> Out;
+  for(const int BC : ByteCode)
+    if (BC>=Opcodes::varBegin)
+      Out.push_back(BC-Opcodes::varBegin);
+  std::sort(Out.begin(),Out.end());
+  Out.erase(std::unique(Out.begin(),Out.end()),Out.end());
+  return Out;
 }
 
 template<>
@@ -814,8 +892,12 @@ Code::printByteCode(std::ostream& OFS) const
 
 
 ///\cond TEMPLATE
-template double Code::Eval(varList*);
-template Geometry::Vec3D Code::Eval(varList*);
+template double Code::Eval(varList*) const;
+template Geometry::Vec3D Code::Eval(varList*) const;
+template double
+Code::getResult(const int,const double&,const Geometry::Vec3D&);
+template Geometry::Vec3D
+Code::getResult(const int,const double&,const Geometry::Vec3D&);
 
 template double Code::typeConvert(const Geometry::Vec3D&);
 template Geometry::Vec3D Code::typeConvert(const double&);
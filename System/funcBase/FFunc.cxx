@@ -26,6 +26,7 @@
 #include <cmath>
 #include <vector>
 #include <map>
+#include <atomic>
 
 #include "Exception.h"
 #include "FileReport.h"
@@ -45,8 +46,23 @@
 // FFunc
 //-----------------------------------------
 
+/*!
+  \struct FFunc::cacheUnit
+  \brief Last evaluated value of the function
+*/
+struct FFunc::cacheUnit
+{
+  std::atomic<int> state;    ///< 0 : empty / 1 : being set / 2 : valid
+  int flag;                  ///< Result type [0 double / 1 Vec3D]
+  double DValue;             ///< double result
+  Geometry::Vec3D VValue;    ///< Vec3D result
+
+  /// Constructor
+  cacheUnit() : state(0),flag(0),DValue(0.0) {}
+};
+
 FFunc::FFunc(varList* VA,const int I,const Code& CObj) :
-  FItem(VA,I),BaseUnit(CObj)
+  FItem(VA,I),BaseUnit(CObj),CPtr(new cacheUnit)
   /*!
     Standard constructor
     \param VA :: VarList pointer
@@ -56,7 +72,7 @@ FFunc::FFunc(varList* VA,const int I,const Code& CObj) :
 {}
 
 FFunc::FFunc(const FFunc& A) :
-  FItem(A),BaseUnit(A.BaseUnit)
+  FItem(A),BaseUnit(A.BaseUnit),CPtr(new cacheUnit)
   /*!
     Standard copy constructor
     \param A :: FFunc object to copy
@@ -75,6 +91,7 @@ FFunc::operator=(const FFunc& A)
     {
       FItem::operator=(A);
       BaseUnit=A.BaseUnit;
+      clearCache();
     }
   return *this;
 }
@@ -94,7 +111,49 @@ FFunc::~FFunc()
   /*!
     Standard Destructor 
   */
-{}
+{
+  delete CPtr;
+}
+
+void
+FFunc::clearCache()
+  /*!
+    Force the next read to evaluate the code
+  */
+{
+  CPtr->state=0;
+  return;
+}
+
+int
+FFunc::evalResult(double& DValue,Geometry::Vec3D& VValue) const
+  /*!
+    Get the cached result or evaluate the code. Only
+    the first thread to evaluate stores the result.
+    \param DValue :: double result
+    \param VValue :: Vec3D result
+    \return result type [Code::evalStack]
+  */
+{
+  if (CPtr->state.load(std::memory_order_acquire)==2)
+    {
+      DValue=CPtr->DValue;
+      VValue=CPtr->VValue;
+      return CPtr->flag;
+    }
+  
+  const int flag=BaseUnit.evalStack(VListPtr,DValue,VValue);
+  int empty(0);
+  if (flag>=0 &&
+      CPtr->state.compare_exchange_strong(empty,1,std::memory_order_acq_rel))
+    {
+      CPtr->flag=flag;
+      CPtr->DValue=DValue;
+      CPtr->VValue=VValue;
+      CPtr->state.store(2,std::memory_order_release);
+    }
+  return flag;
+}
 
 void
 FFunc::setValue(const Code& AC)
@@ -104,6 +163,7 @@ FFunc::setValue(const Code& AC)
   */
 {
   BaseUnit=AC;
+  clearCache();
   return;
 }
 
@@ -119,11 +179,12 @@ FFunc::getValue(Geometry::Vec3D& V) const
     \return 1 if appropiate eval / 0 otherwise
   */
 {
-  ELog::RegMethod RegA("FFunc","getValue(Vec3D)");
-  Code BC(BaseUnit);
+  double DValue(0.0);
+  Geometry::Vec3D VValue;
+  const int flag=evalResult(DValue,VValue);
   try
     {
-      V=BC.Eval<Geometry::Vec3D>(FItem::VListPtr);
+      V=Code::getResult<Geometry::Vec3D>(flag,DValue,VValue);
     }
   catch(ColErr::TypeConvError<double,Geometry::Vec3D>&)
     {
@@ -141,8 +202,10 @@ FFunc::getValue(double& V) const
     \return 1 if appropiate eval / 0 otherwise
   */
 {
-  Code BC(BaseUnit);
-  V=BC.Eval<double>(FItem::VListPtr);
+  double DValue(0.0);
+  Geometry::Vec3D VValue;
+  const int flag=evalResult(DValue,VValue);
+  V=Code::getResult<double>(flag,DValue,VValue);
   const_cast<int&>(active)++;
   return 1;
 }
@@ -155,8 +218,10 @@ FFunc::getValue(int& V) const
     \return Code expression 
   */
 {
-  Code BC(BaseUnit);
-  V=static_cast<int>(BC.Eval<double>(VListPtr));
+  double DValue(0.0);
+  Geometry::Vec3D VValue;
+  const int flag=evalResult(DValue,VValue);
+  V=static_cast<int>(Code::getResult<double>(flag,DValue,VValue));
   const_cast<int&>(active)++;
   return 1;
 }
@@ -169,8 +234,10 @@ FFunc::getValue(long int& V) const
     \return Code expression 
   */
 {
-  Code BC(BaseUnit);
-  V=static_cast<long int>(BC.Eval<double>(VListPtr));
+  double DValue(0.0);
+  Geometry::Vec3D VValue;
+  const int flag=evalResult(DValue,VValue);
+  V=static_cast<long int>(Code::getResult<double>(flag,DValue,VValue));
   const_cast<int&>(active)++;
   return 1;
 }
@@ -184,8 +251,10 @@ FFunc::getValue(size_t& V) const
     \return Code expression 
   */
 {
-  Code BC(BaseUnit);
-  V=static_cast<size_t>(BC.Eval<double>(VListPtr));
+  double DValue(0.0);
+  Geometry::Vec3D VValue;
+  const int flag=evalResult(DValue,VValue);
+  V=static_cast<size_t>(Code::getResult<double>(flag,DValue,VValue));
   const_cast<int&>(active)++;
   return 1;
 }
@@ -198,8 +267,10 @@ FFunc::getValue(std::string& V) const
     \return Code expression 
   */
 {
-  Code BC(BaseUnit);
-  double Val=BC.Eval<double>(VListPtr);
+  double DValue(0.0);
+  Geometry::Vec3D VValue;
+  const int flag=evalResult(DValue,VValue);
+  double Val=Code::getResult<double>(flag,DValue,VValue);
   std::stringstream cx;
   cx<<Val;
   V=cx.str();
@@ -97,12 +97,16 @@ FuncDataBase::~FuncDataBase()
 const FItem*
 FuncDataBase::findItem(const std::string& Key) const
   /*!
-    Finds a variable item
+    Finds a variable item. A name that is not found is 
+    recorded as a missing variable.
     \param Key :: string to search
     \return FItem pointer (or 0 on failure to find)
   */
 {
-   return VList.findVar(Key);
+  const FItem* FI=VList.findVar(Key);
+  if (!FI)
+    VList.addMissing(Key);
+  return FI;
 }
 
 int
@@ -28,8 +28,10 @@
 #include <vector>
 #include <list>
 #include <map>
+#include <set>
 #include <algorithm>
 #include <functional>
+#include <unordered_map>
 
 #include "Exception.h"
 #include "FileReport.h"
@@ -44,29 +46,32 @@
 #include "FItem.h"
 #include "varList.h"
 
+/*!
+  \struct varList::hashUnit
+  \brief Hash table of the variable names
+*/
+struct varList::hashUnit
+{
+  std::unordered_map<std::string,FItem*> Map;   ///< Name : variable
+  std::set<std::string> Missing;   ///< Looked up but not present
+};
+
 varList::varList() :
-  varNum(0)
+  varNum(0),HPtr(new hashUnit)
   /*!
     Default constructor
   */
 {}
 
 varList::varList(const varList& A) :
-  varNum(A.varNum)
+  varNum(A.varNum),HPtr(new hashUnit)
   /*!
     Standard Copy constructor.
     Makes a memory copy of the FItem*
     \param A :: varList to copy
   */
 {
-  std::map<std::string,FItem*>::const_iterator vc;
-  for(vc=A.varName.begin();vc!=A.varName.end();vc++)
-    {
-      FItem* Ptr=vc->second->clone();
-      varName.insert(std::pair<std::string,FItem*>(vc->first,Ptr));
-      varItem.insert(std::pair<int,FItem*>(Ptr->getIndex(),Ptr));
-    }
-  return;
+  copyItems(A);
 }
 
 varList&
@@ -80,15 +85,9 @@ varList::operator=(const varList& A)
 {
   if (this!=&A)
     {
-      varNum=A.varNum;
       deleteMem();
-      std::map<std::string,FItem*>::const_iterator vc;
-      for(vc=A.varName.begin();vc!=A.varName.end();vc++)
-        {
-	  FItem* Ptr=vc->second->clone();
-	  varName.insert(std::pair<std::string,FItem*>(vc->first,Ptr));
-	  varItem.insert(std::pair<int,FItem*>(Ptr->getIndex(),Ptr));
-	}
+      varNum=A.varNum;
+      copyItems(A);
     }
   return *this;
 }
@@ -100,31 +99,158 @@ varList::~varList()
   */
 {
   deleteMem();
+  delete HPtr;
+}
+
+void
+varList::copyItems(const varList& A)
+  /*!
+    Copy the items of a varList. The copies evaluate
+    their functions against this list.
+    \param A :: varList to copy
+  */
+{
+  for(const varStore::value_type& VC : A.varName)
+    {
+      FItem* Ptr=VC.second->clone();
+      Ptr->setVList(this);
+      insertVar(VC.first,Ptr);
+    }
+  HPtr->Missing=A.HPtr->Missing;
+  return;
 }
 
 void
 varList::resetActive()
   /*!
-    Reset the active unit
+    Reset the active unit and the missing names. The function 
+    caches are cleared so that the variables they use are read again.
   */
 {
+  HPtr->Missing.clear();
   for(varStore::value_type& VC : varName)
-    VC.second->resetActive();
-      
+    {
+      VC.second->resetActive();
+      FFunc* FPtr=dynamic_cast<FFunc*>(VC.second);
+      if (FPtr)
+	FPtr->clearCache();
+    }
+  return;
 }
 
-
 void
 varList::deleteMem() 
   /*!
     Erase and clear the list of variables
   */
 {
-  std::map<int,FItem*>::iterator vc;
-  for(vc=varItem.begin();vc!=varItem.end();vc++)
-    delete vc->second;
-  varItem.erase(varItem.begin(),varItem.end());
-  varName.erase(varName.begin(),varName.end());
+  for(FItem* Ptr : varItem)
+    delete Ptr;
+  varItem.clear();
+  varName.clear();
+  HPtr->Map.clear();
+  HPtr->Missing.clear();
+  depMap.clear();
+  return;
+}
+
+void
+varList::insertVar(const std::string& Name,FItem* Ptr)
+  /*!
+    Add a new variable to the name/index lists
+    \param Name :: Name of variable [not present]
+    \param Ptr :: Variable [managed]
+  */
+{
+  const size_t index=static_cast<size_t>(Ptr->getIndex());
+  if (index>=varItem.size())
+    varItem.resize(index+1,0);
+  varItem[index]=Ptr;
+  varName.emplace(Name,Ptr);
+  HPtr->Map.emplace(Name,Ptr);
+  addDepend(Ptr);
+  return;
+}
+
+void
+varList::eraseVar(const varStore::iterator& vc)
+  /*!
+    Remove and delete a variable from the name/index lists
+    \param vc :: Variable position
+  */
+{
+  FItem* Ptr=vc->second;
+  removeDepend(Ptr);
+  varItem[static_cast<size_t>(Ptr->getIndex())]=0;
+  HPtr->Map.erase(vc->first);
+  varName.erase(vc);
+  delete Ptr;
+  return;
+}
+
+void
+varList::addDepend(const FItem* Ptr)
+  /*!
+    Register the variables that a function uses
+    \param Ptr :: Variable [only functions are registered]
+  */
+{
+  const FFunc* FPtr=dynamic_cast<const FFunc*>(Ptr);
+  if (FPtr)
+    for(const int varIndex : FPtr->getVarIndex())
+      depMap[varIndex].push_back(FPtr->getIndex());
+  return;
+}
+
+void
+varList::removeDepend(const FItem* Ptr)
+  /*!
+    Remove the variables that a function uses
+    \param Ptr :: Variable [only functions are registered]
+  */
+{
+  const FFunc* FPtr=dynamic_cast<const FFunc*>(Ptr);
+  if (FPtr)
+    for(const int varIndex : FPtr->getVarIndex())
+      {
+	std::vector<int>& DVec=depMap[varIndex];
+	DVec.erase(std::remove(DVec.begin(),DVec.end(),FPtr->getIndex()),
+		   DVec.end());
+      }
+  return;
+}
+
+void
+varList::changedVar(const int Key)
+  /*!
+    A variable has changed : clear the cached value of
+    every function that uses it [directly or indirectly]
+    \param Key :: Index of the variable
+  */
+{
+  std::vector<char> visited(varItem.size()+1,0);
+  std::vector<int> Stack({Key});
+  while(!Stack.empty())
+    {
+      const int index=Stack.back();
+      Stack.pop_back();
+      std::map<int,std::vector<int>>::const_iterator mc=depMap.find(index);
+      if (mc==depMap.end()) continue;
+      for(const int funcIndex : mc->second)
+	{
+	  const size_t FI=static_cast<size_t>(funcIndex);
+	  if (FI<varItem.size() && !visited[FI])
+	    {
+	      visited[FI]=1;
+	      FFunc* FPtr=dynamic_cast<FFunc*>(varItem[FI]);
+	      if (FPtr)
+		{
+		  FPtr->clearCache();
+		  Stack.push_back(funcIndex);
+		}
+	    }
+	}
+    }
   return;
 }
 
@@ -137,12 +263,9 @@ varList::findVar(const std::string& Key) const
     \retval FItem pointer
   */
 {
-  std::map<std::string,FItem*>::const_iterator vc;
-  vc=varName.find(Key);
-  if (vc!=varName.end())
-    return vc->second;
-
-  return 0;
+  std::unordered_map<std::string,FItem*>::const_iterator vc=
+    HPtr->Map.find(Key);
+  return (vc!=HPtr->Map.end()) ? vc->second : 0;
 }
 
 const FItem*
@@ -155,11 +278,8 @@ varList::findVar(const int Key) const
     \retval FuncDefinition if item exists
   */
 {
-  std::map<int,FItem*>::const_iterator vc;
-  vc=varItem.find(Key);
-  if (vc!=varItem.end())
-    return vc->second;
-  return 0;
+  return (Key>=0 && static_cast<size_t>(Key)<varItem.size()) ?
+    varItem[static_cast<size_t>(Key)] : 0;
 }
 
 FItem*
@@ -172,11 +292,8 @@ varList::findVar(const int Key)
     \retval FuncDefinition if item exists
   */
 {
-  std::map<int,FItem*>::iterator vc;
-  vc=varItem.find(Key);
-  if (vc!=varItem.end())
-    return vc->second;
-  return 0;
+  return (Key>=0 && static_cast<size_t>(Key)<varItem.size()) ?
+    varItem[static_cast<size_t>(Key)] : 0;
 }
 
 FItem* 
@@ -188,12 +305,9 @@ varList::findVar(const std::string& Key)
     \retval FItem pointer
   */
 {
-  std::map<std::string,FItem*>::iterator vc;
-  vc=varName.find(Key);
-  if (vc!=varName.end())
-    return vc->second;
-
-  return 0;
+  std::unordered_map<std::string,FItem*>::iterator vc=
+    HPtr->Map.find(Key);
+  return (vc!=HPtr->Map.end()) ? vc->second : 0;
 }
 
 
@@ -216,23 +330,20 @@ varList::copyVar(const std::string& newKey,const std::string& oldKey)
   if (bc==varName.end())
     throw ColErr::InContainerError<std::string>(oldKey,"Var item not found");
 
+  int oldIndex(-1);
   ac=varName.find(newKey);
   if (ac!=varName.end())
     {
-      const int I=ac->second->getIndex();
-      delete ac->second;
-
-      std::map<int,FItem*>::iterator ic;
-      ic=varItem.find(I);
-      varName.erase(ac);
-      varItem.erase(ic);
+      oldIndex=ac->second->getIndex();
+      eraseVar(ac);
     }
   FItem* Ptr=bc->second->clone();
   Ptr->setIndex(varNum);
   varNum++;
     // Now insert into master lists
-  varName.insert(std::pair<std::string,FItem*>(newKey,Ptr));
-  varItem.insert(std::pair<int,FItem*>(Ptr->getIndex(),Ptr));
+  insertVar(newKey,Ptr);
+  if (oldIndex>=0)
+    changedVar(oldIndex);
 
   return;
 }
@@ -352,7 +463,20 @@ varList::setValue(const int Key,const T& Value)
 {
   FItem* FPtr=findVar(Key);
   if (FPtr)
-    FPtr->setValue(Value);
+    {
+      removeDepend(FPtr);
+      try
+	{
+	  FPtr->setValue(Value);
+	}
+      catch (ColErr::ExBase&)
+	{
+	  addDepend(FPtr);
+	  throw;
+	}
+      addDepend(FPtr);
+      changedVar(Key);
+    }
   return;
 }
 
@@ -370,14 +494,9 @@ varList::removeVar(const std::string& Name)
   if (mc==varName.end())
     throw ColErr::InContainerError<std::string>(Name,"Name");
 
-  std::map<int,FItem*>::iterator ic=varItem.find(mc->second->getIndex());
-  if (ic==varItem.end())
-    throw ColErr::InContainerError<int>(mc->second->getIndex(),
-                                        "NAME [INT] "+Name);
-
-  delete mc->second;
-  varItem.erase(ic);
-  varName.erase(mc);
+  const int I=mc->second->getIndex();
+  eraseVar(mc);
+  changedVar(I);
   return;
 }
 
@@ -432,23 +551,17 @@ varList::addVar(const std::string& Name,const Code& Value)
       // Note that the variable number is re-used 
       // despite the change in variable.
       const int I=vc->second->getIndex();
-
-      delete vc->second;
-      std::map<int,FItem*>::iterator ac;
-      ac=varItem.find(I);
-      varName.erase(vc);
-      varItem.erase(ac);
+      eraseVar(vc);
       Ptr=createFType<Code>(I,Value);
+      insertVar(Name,Ptr);
+      changedVar(I);
+      return;
     }
-  else
   // Need to make a completely new item
-    {
-      Ptr=createFType(varNum,Value);
-      varNum++;
-    }
+  Ptr=createFType(varNum,Value);
+  varNum++;
   // Now insert into master lists
-  varName.emplace(Name,Ptr);
-  varItem.emplace(Ptr->getIndex(),Ptr);
+  insertVar(Name,Ptr);
   return;
 }
 
@@ -472,23 +585,17 @@ varList::addVar(const std::string& Name,const T& Value)
       // Note that the variable number is re-used 
       // despite the change in variable.
       const int I=vc->second->getIndex();
-
-      delete vc->second;
-      std::map<int,FItem*>::iterator ac;
-      ac=varItem.find(I);
-      varName.erase(vc);
-      varItem.erase(ac);
+      eraseVar(vc);
       Ptr=createFType<T>(I,Value);
+      insertVar(Name,Ptr);
+      changedVar(I);
+      return;
     }
-  else
   // Need to make a completely new item
-    {
-      Ptr=createFType(varNum,Value);
-      varNum++;
-    }
+  Ptr=createFType(varNum,Value);
+  varNum++;
   // Now insert into master lists
-  varName.insert(std::pair<std::string,FItem*>(Name,Ptr));
-  varItem.insert(std::pair<int,FItem*>(Ptr->getIndex(),Ptr));
+  insertVar(Name,Ptr);
   return;
 }
 
@@ -506,18 +613,47 @@ varList::setVar(const std::string& Name,const T& Value)
   vc=varName.find(Name);
   if (vc==varName.end())
     throw ColErr::InContainerError<std::string>(Name,"varList::setVar");
+  FItem* Ptr=vc->second;
+  removeDepend(Ptr);
   try
     {
-      vc->second->setValue(Value);
+      Ptr->setValue(Value);
     }
   catch (ColErr::ExBase&)
     {
       // Wrong type?
+      addDepend(Ptr);
       addVar(Name,Value);
+      return;
     }
+  addDepend(Ptr);
+  changedVar(Ptr->getIndex());
+  return;
+}
+
+void
+varList::addMissing(const std::string& Key) const
+  /*!
+    Record a name that was looked up but is not a variable
+    [a default value was used]
+    \param Key :: Name of variable
+  */
+{
+  HPtr->Missing.insert(Key);
   return;
 }
 
+std::vector<std::string>
+varList::getMissing() const
+  /*!
+    Names looked up that were not variables at the time
+    \return sorted vector of names
+  */
+{
+  return std::vector<std::string>
+    (HPtr->Missing.begin(),HPtr->Missing.end());
+}
+
 std::vector<std::string>
 varList::getKeys() const
   /*!
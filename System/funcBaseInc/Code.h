@@ -81,13 +81,18 @@ class Code
 
  public:
 
+  template<typename T>
+  static T getResult(const int,const double&,const Geometry::Vec3D&);
+
   Code();
   Code(const Code&);
   Code& operator=(const Code&);
   ~Code();
 
+  int evalStack(varList*,double&,Geometry::Vec3D&) const;
   template<typename T>
-  T Eval(varList*);
+  T Eval(varList*) const;
+  std::vector<int> getVarIndex() const;
 
   void clear();
   int popByte();
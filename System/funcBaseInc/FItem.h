@@ -132,15 +132,21 @@ class FValue : public FItem
   \date April 2006
   \version 1.0
   Holds just the code item of the parser (the only bit that
-  is really needed)
+  is really needed). The evaluated result is cached until
+  varList reports that a variable it uses has changed.
 */
 
 class FFunc : public FItem
 {
  private:
 
+  struct cacheUnit;
+
   Code BaseUnit;    ///< Code unit of a compile Function
+  cacheUnit* CPtr;  ///< Cached result
 
+  int evalResult(double&,Geometry::Vec3D&) const;
+  
  public:
 
   FFunc(varList*,const int,const Code&);
@@ -150,6 +156,9 @@ class FFunc : public FItem
   virtual ~FFunc();
 
   void setValue(const Code&);
+  void clearCache();
+  /// Variables used by the function
+  std::vector<int> getVarIndex() const { return BaseUnit.getVarIndex(); }
 
   virtual int getValue(Geometry::Vec3D&) const;  
   virtual int getValue(int&) const;     
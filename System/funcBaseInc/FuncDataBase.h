@@ -141,6 +141,9 @@ class FuncDataBase
 
   /// access keys
   std::vector<std::string> getKeys() const { return VList.getKeys(); }
+  /// access names looked up but not found
+  std::vector<std::string> getMissing() const
+    { return VList.getMissing(); }
   std::string variableHash() const;
 
   // RESET of active
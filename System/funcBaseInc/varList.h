@@ -31,6 +31,9 @@
 
   This class holds the variable name + number 
   relative to the actual variable type object. 
+  Names are also held in a hash table for lookup and
+  each variable keeps the functions that use it so that
+  a change only clears the cached results of those functions.
 */
 
 class FItem;
@@ -43,12 +46,23 @@ class varList
 
  private:
 
+  struct hashUnit;
+  
   int varNum;                              ///< Current max var
 
   varStore varName;                        ///< Var by name
-  std::map<int,FItem*> varItem;            ///< Var by number
+  std::vector<FItem*> varItem;             ///< Var by number
+  hashUnit* HPtr;                          ///< Var by name [hashed]
+  /// Functions that use the variable [var index : function index]
+  std::map<int,std::vector<int>> depMap; 
 
   void deleteMem();
+  void copyItems(const varList&);
+  void insertVar(const std::string&,FItem*);
+  void eraseVar(const varStore::iterator&);
+  void addDepend(const FItem*);
+  void removeDepend(const FItem*);
+  void changedVar(const int);
 
  public:
 
@@ -88,7 +102,9 @@ class varList
   FItem* createFType(const int,const T&);
 
   void resetActive();
+  void addMissing(const std::string&) const;
   
+  std::vector<std::string> getMissing() const;
   std::vector<std::string> getKeys() const;
   void writeActive(std::ostream&) const;
   void writeAll(std::ostream&) const;
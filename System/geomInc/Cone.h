@@ -70,6 +70,10 @@ class Cone : public Quadratic
     { A.Accept(*this); }
   
   int side(const Geometry::Vec3D&) const;
+  /// Block side [not the quadratic form]
+  void sideBlock(const Geometry::Vec3D* Pts,const size_t N,
+		 signed char* Out) const
+    { Surface::sideBlock(Pts,N,Out); }
   int onSurface(const Geometry::Vec3D&) const;
   Geometry::Vec3D surfaceNormal(const Geometry::Vec3D&) const;    
 
@@ -76,6 +76,7 @@ class Cylinder : public Quadratic
     { A.Accept(*this); }
 
   int side(const Geometry::Vec3D&) const;
+  void sideBlock(const Geometry::Vec3D*,const size_t,signed char*) const;
   int onSurface(const Geometry::Vec3D&) const;
   double distance(const Geometry::Vec3D&) const;
 
@@ -87,6 +87,7 @@ class Plane : public Quadratic
   int setPlane(const Geometry::Vec3D&,const double);
 
   int side(const Geometry::Vec3D&) const;
+  void sideBlock(const Geometry::Vec3D*,const size_t,signed char*) const;
   int onSurface(const Geometry::Vec3D&) const;
   // stuff for finding intersections etc.
   double dotProd(const Plane&) const;   
@@ -82,6 +82,8 @@ class Quadratic : public Surface
 
   virtual int setSurface(const std::string&);
   virtual int side(const Geometry::Vec3D&) const; 
+  virtual void sideBlock(const Geometry::Vec3D*,const size_t,
+			 signed char*) const;
 
   virtual void setBaseEqn();      ///< Abstract set baseEqn 
   
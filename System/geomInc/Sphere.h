@@ -72,6 +72,7 @@ class Sphere : public Quadratic
 
   int setSurface(const std::string&);
   int side(const Geometry::Vec3D&) const;
+  void sideBlock(const Geometry::Vec3D*,const size_t,signed char*) const;
   int onSurface(const Geometry::Vec3D&) const;
   double distance(const Geometry::Vec3D&) const;
 
@@ -84,6 +84,8 @@ class Surface
   int applyTransform(const std::map<int,Transform>&);
   int sideDirection(const Geometry::Vec3D&,
 		    const Geometry::Vec3D&) const;
+  virtual void sideBlock(const Geometry::Vec3D*,const size_t,
+			 signed char*) const;
 
   /// \cond ABSTRACT
   virtual int setSurface(const std::string&) =0; 
@@ -0,0 +1,87 @@
+/********************************************************************* 
+  CombLayer : MCNP(X) Input builder
+ 
+ * File:   geomInc/surfHash.h
+ *
+ * Copyright (c) 2004-2019 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+ *
+ ****************************************************************************/
+#ifndef ModelSupport_surfHash_h
+#define ModelSupport_surfHash_h
+
+namespace Geometry
+{
+  class Surface;
+}
+
+namespace ModelSupport
+{
+
+/*!
+  \class surfHash
+  \version 1.0
+  \author S. Ansell
+  \date May 2019
+  \brief Tolerance bucketed index of planes/cylinders/spheres
+
+  Each surface is reduced to a short key (plane : distance+normal,
+  cylinder : radius+unsigned axis, sphere : radius+centre)
+  which is quantised into buckets. Buckets next to a value
+  within tolerance are also probed so that every surface
+  that could pass operator== is returned as a candidate.
+  Surfaces are hashed when first needed since some are
+  inserted before their parameters are set.
+*/
+
+class surfHash
+{
+ private:
+
+  static const double bucketSize;      ///< Quantisation step
+  static const double edgeTol;         ///< Probe range at bucket edge
+
+  /// Bucket : surface numbers
+  std::unordered_map<size_t,std::set<int>> Bucket;
+  std::map<int,size_t> surfKey;        ///< Surface : bucket key
+  /// Surfaces not yet hashed
+  std::map<int,const Geometry::Surface*> pending;
+
+  static size_t keyValues(const Geometry::Surface*,const bool,
+			  std::vector<double>&);
+  static size_t combine(const size_t,const long int);
+
+  void flush();
+
+ public:
+
+  static bool isHashed(const Geometry::Surface*);
+
+  surfHash();
+  surfHash(const surfHash&);
+  surfHash& operator=(const surfHash&);
+  ~surfHash() {}                ///< Destructor
+
+  void clear();
+  void addSurface(const int,const Geometry::Surface*);
+  void removeSurface(const int);
+  void rebuild(const std::map<int,Geometry::Surface*>&);
+
+  std::vector<int> findCandidates(const Geometry::Surface*,const bool);
+};
+
+}
+
+#endif
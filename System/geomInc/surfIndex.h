@@ -29,6 +29,7 @@ namespace Geometry
 
 namespace ModelSupport
 {
+  class surfHash;
 
 /*!
   \class surfIndex 
@@ -49,6 +50,7 @@ class surfIndex
   int uniqNum;                      ///< uniq number
   STYPE SMap;                       ///< Index of kept surfaces
   std::map<int,int> holdMap;        ///< Hold/Write map :: surfaceN : write/no-write flag
+  surfHash* HPtr;                   ///< Equal/opposite search index
   
   surfIndex();
 
@@ -107,6 +109,9 @@ class surfIndex
 		    std::map<int,Geometry::Surface*>&) const;
   void removeOpposite(const int);
   int findOpposite(const Geometry::Surface*) const;
+  std::vector<int> hashCandidates(const Geometry::Surface*,
+				  const bool) const;
+  void rehash();
 
   int readOutputSurfaces(const std::string&);
 };
@@ -304,6 +304,39 @@ Cylinder::side(const Geometry::Vec3D& Pt) const
   return Quadratic::side(Pt);
 }
 
+void
+Cylinder::sideBlock(const Geometry::Vec3D* Pts,const size_t N,
+		    signed char* Out) const
+  /*!
+    Side of a block of points [same result as side]
+    \param Pts :: Points to test
+    \param N :: Number of points
+    \param Out :: Side of each point [-1/0/1] (size N)
+  */
+{
+  if (!Nvec)
+    {
+      Quadratic::sideBlock(Pts,N,Out);
+      return;
+    }
+  // unit masks of the two axes normal to the cylinder
+  Geometry::Vec3D AX,AY;
+  AX[Nvec % 3]=1.0;
+  AY[(Nvec+1) % 3]=1.0;
+  const double RSqr(Radius*Radius);
+  for(size_t i=0;i<N;i++)
+    {
+      const Geometry::Vec3D Pt(Pts[i]-Centre);
+      const double x=AX.X()*Pt.X()+AX.Y()*Pt.Y()+AX.Z()*Pt.Z();
+      const double y=AY.X()*Pt.X()+AY.Y()*Pt.Y()+AY.Z()*Pt.Z();
+      const double displace=x*x+y*y-RSqr;
+      Out[i]=static_cast<signed char>
+	((displace>=Geometry::parallelTol)-
+	 (displace<= -Geometry::parallelTol));
+    }
+  return;
+}
+
 int 
 Cylinder::onSurface(const Geometry::Vec3D& Pt) const 
   /*!
@@ -192,15 +192,13 @@ Mesh3D::getCoordinate(const std::vector<double>& Vec,
     \return positions [Origin non - offset
    */
 {
-  size_t offset(NF[0]);
+  size_t offset(0);
   size_t I(0);
-  while(Index>offset)
+  while(I+1<NF.size() && Index>offset+NF[I])
     {
       offset+=NF[I];
       I++;
     }
-  offset-=NF[I];
-         
   
   return Vec[I]+static_cast<double>(Index-offset)*
     (Vec[I+1]-Vec[I])/static_cast<double>(NF[I]);
@@ -549,6 +549,28 @@ Plane::side(const Geometry::Vec3D& A) const
   return 0;
 }
 
+void
+Plane::sideBlock(const Geometry::Vec3D* Pts,const size_t N,
+		 signed char* Out) const
+  /*!
+    Side of a block of points [same result as side]
+    \param Pts :: Points to test
+    \param N :: Number of points
+    \param Out :: Side of each point [-1/0/1] (size N)
+  */
+{
+  const double nx(NormV.X());
+  const double ny(NormV.Y());
+  const double nz(NormV.Z());
+  for(size_t i=0;i<N;i++)
+    {
+      const double Dp=nx*Pts[i].X()+ny*Pts[i].Y()+nz*Pts[i].Z()-Dist;
+      Out[i]=static_cast<signed char>
+	((Dp>Geometry::zeroTol)-(Dp< -Geometry::zeroTol));
+    }
+  return;
+}
+
 void
 Plane::reversePtValid(const int sign,const Geometry::Vec3D& A)
   /*!
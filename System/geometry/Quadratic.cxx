@@ -210,6 +210,31 @@ Quadratic::side(const Geometry::Vec3D& Pt) const
   return (res>0) ? 1 : -1;
 }
 
+void
+Quadratic::sideBlock(const Geometry::Vec3D* Pts,const size_t N,
+		     signed char* Out) const
+  /*!
+    Side of a block of points [same result as side]
+    \param Pts :: Points to test
+    \param N :: Number of points
+    \param Out :: Side of each point [-1/0/1] (size N)
+  */
+{
+  const double* E(BaseEqn.data());
+  for(size_t i=0;i<N;i++)
+    {
+      const double x(Pts[i].X());
+      const double y(Pts[i].Y());
+      const double z(Pts[i].Z());
+      const double res=E[0]*x*x+E[1]*y*y+E[2]*z*z+
+	E[3]*x*y+E[4]*x*z+E[5]*y*z+
+	E[6]*x+E[7]*y+E[8]*z+E[9];
+      Out[i]=static_cast<signed char>
+	((res>=Geometry::zeroTol)-(res<= -Geometry::zeroTol));
+    }
+  return;
+}
+
 
 Geometry::Vec3D
 Quadratic::surfaceNormal(const Geometry::Vec3D& Pt) const
@@ -225,6 +225,26 @@ Sphere::side(const Geometry::Vec3D& Pt) const
   return (Xv.dotProd(Xv)>Radius*Radius) ? 1 : -1;
 }
 
+void
+Sphere::sideBlock(const Geometry::Vec3D* Pts,const size_t N,
+		  signed char* Out) const
+  /*!
+    Side of a block of points [same result as side]
+    \param Pts :: Points to test
+    \param N :: Number of points
+    \param Out :: Side of each point [-1/1] (size N)
+  */
+{
+  const double RSqr(Radius*Radius);
+  for(size_t i=0;i<N;i++)
+    {
+      const Geometry::Vec3D Xv=Pts[i]-Centre;
+      Out[i]=static_cast<signed char>
+	(2*(Xv.dotProd(Xv)>RSqr)-1);
+    }
+  return;
+}
+
 int
 Sphere::onSurface(const Geometry::Vec3D& Pt) const
   /*!
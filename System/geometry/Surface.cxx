@@ -215,7 +215,21 @@ Surface::sideDirection(const Geometry::Vec3D& Pt,
   const Geometry::Vec3D N=surfaceNormal(Pt);
   return (N.dotProd(uVec)>0.0) ? 1 : -1;
 }
-
+void
+Surface::sideBlock(const Geometry::Vec3D* Pts,const size_t N,
+		   signed char* Out) const
+  /*!
+    Side of a block of points [see side]. The common surfaces
+    override this with loops the compiler can vectorise.
+    \param Pts :: Points to test
+    \param N :: Number of points
+    \param Out :: Side of each point [-1/0/1] (size N)
+  */
+{
+  for(size_t i=0;i<N;i++)
+    Out[i]=static_cast<signed char>(side(Pts[i]));
+  return;
+}
 
 void
 Surface::rotate(const Geometry::Quaternion& QM)
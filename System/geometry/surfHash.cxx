@@ -0,0 +1,310 @@
+/********************************************************************* 
+  CombLayer : MCNP(X) Input builder
+ 
+ * File:   geometry/surfHash.cxx
+ *
+ * Copyright (c) 2004-2019 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+ *
+ ****************************************************************************/
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <cmath>
+#include <vector>
+#include <set>
+#include <map>
+#include <unordered_map>
+#include <string>
+#include <algorithm>
+#include <functional>
+#include <typeinfo>
+
+#include "Exception.h"
+#include "FileReport.h"
+#include "GTKreport.h"
+#include "NameStack.h"
+#include "RegMethod.h"
+#include "OutputLog.h"
+#include "BaseVisit.h"
+#include "BaseModVisit.h"
+#include "MatrixBase.h"
+#include "Matrix.h"
+#include "Vec3D.h"
+#include "Surface.h"
+#include "Quadratic.h"
+#include "Cylinder.h"
+#include "Plane.h"
+#include "Sphere.h"
+#include "surfHash.h"
+
+namespace ModelSupport
+{
+
+const double surfHash::bucketSize(1e-5);
+const double surfHash::edgeTol(10.0*Geometry::zeroTol);
+
+surfHash::surfHash()
+  /*!
+    Constructor
+  */
+{}
+
+surfHash::surfHash(const surfHash& A) :
+  Bucket(A.Bucket),surfKey(A.surfKey),pending(A.pending)
+  /*!
+    Copy constructor
+    \param A :: surfHash to copy
+  */
+{}
+
+surfHash&
+surfHash::operator=(const surfHash& A)
+  /*!
+    Assignment operator
+    \param A :: surfHash to copy
+    \return *this
+  */
+{
+  if (this!=&A)
+    {
+      Bucket=A.Bucket;
+      surfKey=A.surfKey;
+      pending=A.pending;
+    }
+  return *this;
+}
+
+bool
+surfHash::isHashed(const Geometry::Surface* SPtr)
+  /*!
+    Determine if the surface type is held in the index.
+    Only exact types are used so that a dynamic_cast
+    of the type matches the candidates
+    \param SPtr :: Surface
+    \return true if surface type can be hashed
+  */
+{
+  if (!SPtr) return 0;
+  const std::type_info& TI(typeid(*SPtr));
+  return (TI==typeid(Geometry::Plane) ||
+	  TI==typeid(Geometry::Cylinder) ||
+	  TI==typeid(Geometry::Sphere));
+}
+
+size_t
+surfHash::keyValues(const Geometry::Surface* SPtr,const bool oppFlag,
+		    std::vector<double>& Values)
+  /*!
+    Get the values that must agree (within zeroTol) for
+    two surfaces to be equal.
+    \param SPtr :: Surface
+    \param oppFlag :: Values for the opposite plane
+    \param Values :: key values
+    \return type tag [0 if not hashed]
+  */
+{
+  Values.clear();
+  if (!isHashed(SPtr)) return 0;
+
+  const Geometry::Plane* PPtr=
+    dynamic_cast<const Geometry::Plane*>(SPtr);
+  if (PPtr)
+    {
+      const double sign((oppFlag) ? -1.0 : 1.0);
+      const Geometry::Vec3D& N=PPtr->getNormal();
+      Values={sign*PPtr->getDistance(),sign*N[0],sign*N[1],sign*N[2]};
+      return 1;
+    }
+  // only planes have an opposite
+  if (oppFlag) return 0;
+
+  const Geometry::Cylinder* CPtr=
+    dynamic_cast<const Geometry::Cylinder*>(SPtr);
+  if (CPtr)
+    {
+      // centre is not used : it can be displaced along the axis
+      const Geometry::Vec3D& N=CPtr->getNormal();
+      Values={CPtr->getRadius(),
+	      std::abs(N[0]),std::abs(N[1]),std::abs(N[2])};
+      return 2;
+    }
+  const Geometry::Sphere* SphPtr=
+    dynamic_cast<const Geometry::Sphere*>(SPtr);
+  if (SphPtr)
+    {
+      const Geometry::Vec3D& C=SphPtr->getCentre();
+      Values={SphPtr->getRadius(),C[0],C[1],C[2]};
+      return 3;
+    }
+  return 0;
+}
+
+size_t
+surfHash::combine(const size_t seed,const long int Q)
+  /*!
+    Combine a quantised value into a hash
+    \param seed :: current hash
+    \param Q :: quantised value
+    \return new hash
+  */
+{
+  return seed ^ (std::hash<long int>()(Q)+0x9e3779b97f4a7c15UL+
+		 (seed<<6)+(seed>>2));
+}
+
+void
+surfHash::clear()
+  /*!
+    Remove all the surfaces
+  */
+{
+  Bucket.clear();
+  surfKey.clear();
+  pending.clear();
+  return;
+}
+
+void
+surfHash::addSurface(const int SN,const Geometry::Surface* SPtr)
+  /*!
+    Add a surface [hashed on next search]
+    \param SN :: Surface number [map key]
+    \param SPtr :: Surface
+  */
+{
+  removeSurface(SN);
+  if (isHashed(SPtr))
+    pending[SN]=SPtr;
+  return;
+}
+
+void
+surfHash::removeSurface(const int SN)
+  /*!
+    Remove a surface from the index
+    \param SN :: Surface number [map key]
+  */
+{
+  pending.erase(SN);
+
+  std::map<int,size_t>::iterator mc=surfKey.find(SN);
+  if (mc!=surfKey.end())
+    {
+      std::unordered_map<size_t,std::set<int>>::iterator bc=
+	Bucket.find(mc->second);
+      if (bc!=Bucket.end())
+	{
+	  bc->second.erase(SN);
+	  if (bc->second.empty())
+	    Bucket.erase(bc);
+	}
+      surfKey.erase(mc);
+    }
+  return;
+}
+
+void
+surfHash::rebuild(const std::map<int,Geometry::Surface*>& SMap)
+  /*!
+    Rebuild the index [after surfaces have moved]
+    \param SMap :: Surface map
+  */
+{
+  clear();
+  for(const std::map<int,Geometry::Surface*>::value_type& SItem : SMap)
+    addSurface(SItem.first,SItem.second);
+  return;
+}
+
+void
+surfHash::flush()
+  /*!
+    Hash the pending surfaces
+  */
+{
+  std::vector<double> Values;
+  for(const std::map<int,const Geometry::Surface*>::value_type& PItem
+	: pending)
+    {
+      size_t key=keyValues(PItem.second,0,Values);
+      for(const double V : Values)
+	key=combine(key,static_cast<long int>(std::floor(V/bucketSize)));
+      Bucket[key].insert(PItem.first);
+      surfKey.emplace(PItem.first,key);
+    }
+  pending.clear();
+  return;
+}
+
+std::vector<int>
+surfHash::findCandidates(const Geometry::Surface* SPtr,const bool oppFlag)
+  /*!
+    Find all the surfaces that could be equal/opposite
+    to the surface. Candidates must still be checked.
+    \param SPtr :: Surface to compare
+    \param oppFlag :: look for opposite planes
+    \return surface numbers [sorted]
+  */
+{
+  std::set<int> Out;
+
+  std::vector<double> Values;
+  const size_t tag=keyValues(SPtr,oppFlag,Values);
+  if (!tag) return std::vector<int>();
+
+  flush();
+
+  // quantised values and neighbour buckets within tolerance
+  std::vector<std::vector<long int>> QVec;
+  for(const double V : Values)
+    {
+      const double QD=std::floor(V/bucketSize);
+      const long int Q=static_cast<long int>(QD);
+      std::vector<long int> QItem({Q});
+      if (V-QD*bucketSize<edgeTol)
+	QItem.push_back(Q-1);
+      if ((QD+1.0)*bucketSize-V<edgeTol)
+	QItem.push_back(Q+1);
+      QVec.push_back(QItem);
+    }
+
+  // loop over all the bucket combinations
+  std::vector<size_t> Index(QVec.size(),0);
+  while(1)
+    {
+      size_t key(tag);
+      for(size_t i=0;i<QVec.size();i++)
+	key=combine(key,QVec[i][Index[i]]);
+
+      std::unordered_map<size_t,std::set<int>>::const_iterator bc=
+	Bucket.find(key);
+      if (bc!=Bucket.end())
+	Out.insert(bc->second.begin(),bc->second.end());
+
+      size_t i;
+      for(i=0;i<Index.size();i++)
+	{
+	  Index[i]++;
+	  if (Index[i]<QVec[i].size()) break;
+	  Index[i]=0;
+	}
+      if (i==Index.size()) break;
+    }
+  return std::vector<int>(Out.begin(),Out.end());
+}
+
+} // NAMESPACE ModelSupport
@@ -26,6 +26,8 @@
 #include <cmath>
 #include <vector>
 #include <map>
+#include <set>
+#include <unordered_map>
 #include <list>
 #include <stack>
 #include <string>
@@ -62,13 +64,15 @@
 #include "surfaceFactory.h"
 #include "surfRegister.h"
 #include "surfIndex.h"
+#include "surfHash.h"
 
 #include "Debug.h"
 
 namespace ModelSupport
 {
 
-surfIndex::surfIndex() : uniqNum(1)
+surfIndex::surfIndex() :
+  uniqNum(1),HPtr(new surfHash())
   /*!
     Constructor
   */
@@ -93,6 +97,7 @@ surfIndex::~surfIndex()
   STYPE::iterator mc;
   for(mc=SMap.begin();mc!=SMap.end();mc++)
     delete mc->second;
+  delete HPtr;
 }
 
 void
@@ -105,6 +110,7 @@ surfIndex::reset()
   for(mc=SMap.begin();mc!=SMap.end();mc++)
     delete mc->second;
   SMap.erase(SMap.begin(),SMap.end());
+  HPtr->clear();
   return;
 }
 
@@ -143,7 +149,10 @@ surfIndex::addSurface(Geometry::Surface* SPtr)
   Geometry::Surface* NewPtr=ModelSupport::equalSurface(SPtr);
   // Now find if we have copy
   if (NewPtr==SPtr)
-    SMap.insert(STYPE::value_type(SPtr->getName(),SPtr));
+    {
+      SMap.insert(STYPE::value_type(SPtr->getName(),SPtr));
+      HPtr->addSurface(SPtr->getName(),SPtr);
+    }
   else
     delete SPtr;
 
@@ -184,6 +193,7 @@ surfIndex::insertSurface(Geometry::Surface* SPtr)
     }
 
   SMap.insert(STYPE::value_type(SPtr->getName(),SPtr));
+  HPtr->addSurface(SPtr->getName(),SPtr);
 
   return;
 }
@@ -199,7 +209,18 @@ surfIndex::findOpposite(const Geometry::Surface* SPtr)  const
 
   const Geometry::Plane* PPtr=
     dynamic_cast<const Geometry::Plane*>(SPtr);
-  if (PPtr)
+  if (PPtr && surfHash::isHashed(PPtr))
+    {
+      const std::vector<int> candidates=HPtr->findCandidates(PPtr,1);
+      for(const int SN : candidates)
+	{
+	  STYPE::const_iterator mc=SMap.find(SN);
+	  if (mc!=SMap.end() &&
+	      ModelSupport::oppositeSurfaces(PPtr,mc->second))
+	    return mc->first;
+	}
+    }
+  else if (PPtr)
     {
       STYPE::const_iterator mc;
       for(mc=SMap.begin();mc!=SMap.end();mc++)
@@ -221,6 +242,7 @@ surfIndex::removeOpposite(const int SN)
   STYPE::iterator sc=SMap.find(SN);
   if (sc!=SMap.end())
     {
+      HPtr->removeSurface(sc->first);
       delete sc->second;
       SMap.erase(sc);
     }
@@ -247,6 +269,7 @@ surfIndex::removeEqualSurface(const int SNum)
   
   if (NewPtr!=vc->second)
     {
+      HPtr->removeSurface(vc->first);
       delete vc->second;
       SMap.erase(vc);
     }
@@ -290,11 +313,13 @@ surfIndex::createSurf(const int surfN)
       delete mp->second;
       outPtr=new T(surfN,0);
       mp->second=outPtr;
+      HPtr->addSurface(surfN,outPtr);
       ELog::EM<<"Reasigned exiting surface"<<surfN<<ELog::endWarn;
       return outPtr;
     }
   outPtr=new T(surfN,0);
   SMap.insert(STYPE::value_type(surfN,outPtr));
+  HPtr->addSurface(surfN,outPtr);
   return outPtr;
 }
 
@@ -369,6 +394,7 @@ surfIndex::createSurface(const int SN,const int TN,const std::string& SLine)
   if (mc!=SMap.end())
     throw ColErr::InContainerError<int>(SN,"Surface in use");
   SMap.emplace(SN,SPtr);
+  HPtr->addSurface(SN,SPtr);
   return; 
 }
 
@@ -385,6 +411,7 @@ surfIndex::deleteSurface(const int surfN)
   if (mf==SMap.end())
     throw ColErr::InContainerError<int>(surfN,"surfN");
 
+  HPtr->removeSurface(surfN);
   delete mf->second;
   SMap.erase(mf);
 
@@ -449,6 +476,7 @@ surfIndex::renumber(const int origNum,const int newNum)
       return;
     }
   Geometry::Surface* SPtr=mc->second;
+  HPtr->removeSurface(origNum);
   SMap.erase(mc);
   SPtr->setName(newNum);
   insertSurface(SPtr);
@@ -789,6 +817,31 @@ surfIndex::processSurfaces(const std::string& InputLine)
   return 1;
 }
 
+std::vector<int>
+surfIndex::hashCandidates(const Geometry::Surface* SPtr,
+			  const bool oppFlag) const
+  /*!
+    Get the surfaces that might be equal/opposite to SPtr
+    from the hash index
+    \param SPtr :: Surface to compare
+    \param oppFlag :: look for opposite planes
+    \return surface numbers [sorted] 
+   */
+{
+  return HPtr->findCandidates(SPtr,oppFlag);
+}
+
+void
+surfIndex::rehash()
+  /*!
+    Rebuild the hash index after surfaces have been 
+    moved in place (e.g. master rotation)
+   */
+{
+  HPtr->rebuild(SMap);
+  return;
+}
+
 int
 surfIndex::findEqualSurf(const int sBegin,const int sEnd,
 			 std::map<int,Geometry::Surface*>& EQMap) const
@@ -3,7 +3,7 @@
  
  * File:   log/NameStack.cxx
  *
- * Copyright (c) 2004-2015 by Stuart Ansell
+ * Copyright (c) 2004-2019 by Stuart Ansell
  *
  * This program is free software: you can redistribute it and/or modify
  * it under the terms of the GNU General Public License as published by
@@ -23,23 +23,44 @@
 #include <string>
 #include <vector>
 #include <map>
+#include <chrono>
 
+#include "ProfileTree.h"
 #include "NameStack.h"
 
 namespace ELog
 {
 
+bool NameStack::profileFlag(0);
+
+void
+NameStack::setProfile(const std::string& FName)
+  /*!
+    Start timing all the registered calls. Must be
+    called before any threads are started.
+    \param FName :: Output file for the report at exit
+  */
+{
+  ProfileTree::setOutput(FName);
+  profileFlag=1;
+  return;
+}
+  
 NameStack::NameStack() :
-  extraLevel(0),indentLevel(0)
+  extraLevel(0),indentLevel(0),PTree(0)
   /*!
     Constructor
   */
-{}
+{
+  Class.reserve(128);
+  Method.reserve(128);
+}
 
 NameStack::NameStack(const NameStack& A) :
   key(A.key),Class(A.Class),Method(A.Method),
   Extra(A.Extra),extraLevel(A.extraLevel),
-  indentLevel(A.indentLevel)
+  indentLevel(A.indentLevel),
+  PTree((A.PTree) ? new ProfileTree(*A.PTree) : 0)
   /*!
     Copy Constructor
     \param A :: NameStack to copy
@@ -62,10 +83,25 @@ NameStack::operator=(const NameStack& A)
       Extra=A.Extra;
       extraLevel=A.extraLevel;
       indentLevel=A.indentLevel;
+      delete PTree;
+      PTree=(A.PTree) ? new ProfileTree(*A.PTree) : 0;
     }
   return *this;
 }
 
+NameStack::~NameStack()
+  /*!
+    Destructor : the call timings are added to the
+    master profile [thread end]
+  */
+{
+  if (PTree)
+    {
+      ProfileTree::addThread(*PTree);
+      delete PTree;
+    }
+}
+
 void
 NameStack::clear()
  /*!
@@ -82,16 +118,20 @@ NameStack::clear()
 }
 
 void
-NameStack::addComp(const std::string& CN,
-		   const std::string& MN)
+NameStack::addComp(const char* CN,const char* MN)
   /*!
     Adds a component to the class names series
-    \param CN :: Class name
-    \param MN :: Method name
+    \param CN :: Class name [not copied]
+    \param MN :: Method name [not copied]
   */
 {
   Class.push_back(CN);
   Method.push_back(MN);
+  if (profileFlag)
+    {
+      if (!PTree) PTree=new ProfileTree;
+      PTree->enter(CN,MN,Class.size());
+    }
   return;
 }
   
@@ -103,6 +143,8 @@ NameStack::popBack()
 {
   if (!Class.empty())
     {
+      if (PTree && PTree->activeDepth()==Class.size())
+	PTree->leave();
       if (extraLevel==Class.size())
 	{
 	  Extra.clear();
@@ -144,7 +186,7 @@ NameStack::getBase() const
   */
 {
   return (Class.empty()) ?  
-    "" : Class.back()+"::"+Method.back();
+    "" : std::string(Class.back())+"::"+Method.back();
 }
 
 std::string
@@ -158,7 +200,7 @@ NameStack::getItem(const long int Index) const
 {
   if (Class.empty()) return "";
   if (!Index) 
-    return Class.back()+"::"+Method.back();
+    return std::string(Class.back())+"::"+Method.back();
   
   const size_t CSize=Class.size();
  
@@ -166,7 +208,7 @@ NameStack::getItem(const long int Index) const
 		    ? (CSize-static_cast<size_t>(1-Index)) 
 		    : static_cast<size_t>(Index));
 
-  return (itx<CSize) ? Class[itx]+"::"+Method[itx] : "";
+  return (itx<CSize) ? std::string(Class[itx])+"::"+Method[itx] : "";
 } 
 
 std::string
@@ -176,13 +218,14 @@ NameStack::getFull() const
     \return BaseItem
   */
 {
-  std::vector<std::string>::const_iterator vc(Class.begin());
-  std::vector<std::string>::const_iterator ac(Method.begin());
-  std::string Out=*vc+"::"+*ac;
+  if (Class.empty()) return "";
+  std::vector<const char*>::const_iterator vc(Class.begin());
+  std::vector<const char*>::const_iterator ac(Method.begin());
+  std::string Out=std::string(*vc)+"::"+*ac;
   for(ac++,vc++;vc!=Class.end();vc++,ac++)
     {
       Out+="#";
-      Out+=*vc+"::"+*ac;
+      Out+=std::string(*vc)+"::"+*ac;
     }
   if (!Extra.empty())
     {
@@ -199,15 +242,16 @@ NameStack::getFullTree() const
     \return BaseItem
   */
 {
-  std::vector<std::string>::const_iterator vc(Class.begin());
-  std::vector<std::string>::const_iterator ac(Method.begin());
+  if (Class.empty()) return "";
+  std::vector<const char*>::const_iterator vc(Class.begin());
+  std::vector<const char*>::const_iterator ac(Method.begin());
   size_t indent(2);
-  std::string Out=*vc+"::"+*ac;
+  std::string Out=std::string(*vc)+"::"+*ac;
   for(ac++,vc++;vc!=Class.end();vc++,ac++,indent+=2)
     {
       Out+='\n';
       Out+=std::string(indent,' ');
-      Out+=*vc+"::"+*ac;
+      Out+=std::string(*vc)+"::"+*ac;
     }
   if (!Extra.empty())
     {
@@ -37,6 +37,8 @@
 namespace ELog
 {
 
+thread_local bool quietThread(0);
+
 template<typename RepClass>
 OutputLog<RepClass>::OutputLog() :
   colourFlag(0),activeBits(255),actionBits(0),
@@ -226,6 +228,8 @@ OutputLog<RepClass>::report(const std::string& M,const int T)
 {
   static int length(0);
 
+  if (quietThread) return;
+
   std::string cxItem=M;
   std::string::size_type pos;
 
@@ -300,6 +304,7 @@ OutputLog<RepClass>::report(const int T)
     \param T :: Type of error 
   */
 {
+  if (quietThread) return;
   report(cx.str(),T);
   cx.str("");
   makeAction(T);
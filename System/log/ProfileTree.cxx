@@ -0,0 +1,341 @@
+/*********************************************************************
+  CombLayer : MCNP(X) Input builder
+
+ * File:   log/ProfileTree.cxx
+ *
+ * Copyright (c) 2004-2019 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ****************************************************************************/
+#include <fstream>
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <map>
+#include <set>
+#include <tuple>
+#include <algorithm>
+#include <chrono>
+#include <mutex>
+
+#include "ProfileTree.h"
+
+namespace ELog
+{
+
+/*!
+  \class profileStore
+  \brief Master tree of all the finished threads
+
+  Written out on destruction [program exit] which is
+  after all the thread_local stacks have been merged.
+  The main thread stack is never deleted so its tree
+  is added at this point.
+*/
+class profileStore
+{
+ public:
+
+  std::mutex storeLock;        ///< Lock for the merge
+  std::string FName;           ///< Output file [empty : none]
+  ProfileTree Master;          ///< Merged tree
+  ProfileTree::mainFUNC mainTree;   ///< Main thread tree [if set]
+
+  profileStore() : mainTree(0) {}  ///< Constructor
+  ~profileStore();
+};
+
+profileStore::~profileStore()
+  /*!
+    Destructor : write the folded stacks and the summary
+  */
+{
+  if (!FName.empty())
+    {
+      const ProfileTree* MPtr=(mainTree) ? mainTree() : 0;
+      if (MPtr)
+	{
+	  ProfileTree Closed(*MPtr);
+	  Closed.closeAll();
+	  Master.merge(Closed);
+	}
+      std::ofstream OX(FName.c_str());
+      Master.writeFolded(OX);
+      OX.close();
+      std::ofstream SX((FName+".sum").c_str());
+      Master.writeSummary(SX);
+      SX.close();
+    }
+}
+
+static profileStore&
+getStore()
+  /*!
+    Access the master store
+    \return static store
+  */
+{
+  static profileStore PS;
+  return PS;
+}
+
+ProfileTree::ProfileTree() :
+  Nodes({{"",0,{},0,0.0,0.0}})
+  /*!
+    Constructor [root node only]
+  */
+{}
+
+ProfileTree::ProfileTree(const ProfileTree& A) :
+  Nodes(A.Nodes),Active(A.Active)
+  /*!
+    Copy Constructor
+    \param A :: ProfileTree to copy
+  */
+{}
+
+ProfileTree&
+ProfileTree::operator=(const ProfileTree& A)
+  /*!
+    Assignment operator
+    \param A :: ProfileTree to copy
+    \return *this
+  */
+{
+  if (this!=&A)
+    {
+      Nodes=A.Nodes;
+      Active=A.Active;
+    }
+  return *this;
+}
+
+void
+ProfileTree::setOutput(const std::string& FName)
+  /*!
+    Set the file for the report at program exit
+    \param FName :: File name [folded stacks / .sum for the summary]
+  */
+{
+  profileStore& PS=getStore();
+  std::lock_guard<std::mutex> lockA(PS.storeLock);
+  PS.FName=FName;
+  return;
+}
+
+void
+ProfileTree::addThread(const ProfileTree& A)
+  /*!
+    Merge the tree of a finished thread into the master
+    \param A :: Thread tree
+  */
+{
+  ProfileTree Closed(A);
+  Closed.closeAll();
+
+  profileStore& PS=getStore();
+  std::lock_guard<std::mutex> lockA(PS.storeLock);
+  PS.Master.merge(Closed);
+  return;
+}
+
+void
+ProfileTree::setMainTree(const mainFUNC MF)
+  /*!
+    Set the access to the main thread tree which is
+    added to the master at program exit
+    \param MF :: Function returning the tree [0 if not profiled]
+  */
+{
+  profileStore& PS=getStore();
+  std::lock_guard<std::mutex> lockA(PS.storeLock);
+  PS.mainTree=MF;
+  return;
+}
+
+size_t
+ProfileTree::addNode(const size_t parentIndex,const std::string& Name)
+  /*!
+    Find/create the child of a node
+    \param parentIndex :: Parent node
+    \param Name :: class::method
+    \return child node index
+  */
+{
+  std::map<std::string,size_t>::const_iterator mc=
+    Nodes[parentIndex].child.find(Name);
+  if (mc!=Nodes[parentIndex].child.end())
+    return mc->second;
+
+  const size_t index=Nodes.size();
+  Nodes.push_back({Name,parentIndex,{},0,0.0,0.0});
+  Nodes[parentIndex].child.emplace(Name,index);
+  return index;
+}
+
+void
+ProfileTree::enter(const char* CN,const char* MN,const size_t depth)
+  /*!
+    Open a call
+    \param CN :: Class name
+    \param MN :: Method name
+    \param depth :: NameStack depth of the call
+  */
+{
+  const size_t parentIndex=(Active.empty()) ? 0 : Active.back().node;
+  std::string Name(CN);
+  Name+="::";
+  Name+=MN;
+  Active.push_back({addNode(parentIndex,Name),depth,
+	            clockTYPE::now(),0.0});
+  return;
+}
+
+void
+ProfileTree::leave()
+  /*!
+    Close the last open call
+  */
+{
+  if (Active.empty()) return;
+
+  const profFrame& PF(Active.back());
+  const double T=std::chrono::duration<double>
+    (clockTYPE::now()-PF.start).count();
+  profNode& PN(Nodes[PF.node]);
+  PN.count++;
+  PN.incTime+=T;
+  PN.exTime+=T-PF.childTime;
+  Active.pop_back();
+  if (!Active.empty())
+    Active.back().childTime+=T;
+  return;
+}
+
+void
+ProfileTree::closeAll()
+  /*!
+    Close all the open calls [at the current time]
+  */
+{
+  while(!Active.empty())
+    leave();
+  return;
+}
+
+void
+ProfileTree::mergeNode(const ProfileTree& A,const size_t AIndex,
+		       const size_t index)
+  /*!
+    Add the values of a node (and its children)
+    \param A :: Tree to add
+    \param AIndex :: Node in A
+    \param index :: Matching node in this
+  */
+{
+  const profNode& APN(A.Nodes[AIndex]);
+  Nodes[index].count+=APN.count;
+  Nodes[index].incTime+=APN.incTime;
+  Nodes[index].exTime+=APN.exTime;
+  for(const auto& [name,childIndex] : APN.child)
+    mergeNode(A,childIndex,addNode(index,name));
+  return;
+}
+
+void
+ProfileTree::merge(const ProfileTree& A)
+  /*!
+    Add a tree to this tree
+    \param A :: Tree to add [closed]
+  */
+{
+  mergeNode(A,0,0);
+  return;
+}
+
+std::string
+ProfileTree::pathName(const size_t index) const
+  /*!
+    Full call path of a node
+    \param index :: Node
+    \return path separated by ;
+  */
+{
+  std::string Out(Nodes[index].name);
+  for(size_t i=Nodes[index].parent;i;i=Nodes[i].parent)
+    Out=Nodes[i].name+";"+Out;
+  return Out;
+}
+
+void
+ProfileTree::writeFolded(std::ostream& OX) const
+  /*!
+    Write each call path with its exclusive time in
+    microseconds [flamegraph.pl folded stack format]
+    \param OX :: Output stream
+  */
+{
+  for(size_t i=1;i<Nodes.size();i++)
+    {
+      const long int uSec=
+	static_cast<long int>(Nodes[i].exTime*1e6+0.5);
+      if (uSec>0)
+	OX<<pathName(i)<<" "<<uSec<<std::endl;
+    }
+  return;
+}
+
+void
+ProfileTree::writeSummary(std::ostream& OX) const
+  /*!
+    Write the calls/inclusive/exclusive time of each
+    class::method. Inclusive time of recursive calls
+    is only counted at the outer call.
+    \param OX :: Output stream
+  */
+{
+  // name : count / inclusive / exclusive
+  typedef std::tuple<size_t,double,double> STYPE;
+  std::map<std::string,STYPE> Sum;
+  for(size_t i=1;i<Nodes.size();i++)
+    {
+      const profNode& PN(Nodes[i]);
+      bool recursive(0);
+      for(size_t j=PN.parent;j && !recursive;j=Nodes[j].parent)
+	recursive=(Nodes[j].name==PN.name);
+
+      STYPE& SItem=Sum[PN.name];
+      std::get<0>(SItem)+=PN.count;
+      if (!recursive)
+	std::get<1>(SItem)+=PN.incTime;
+      std::get<2>(SItem)+=PN.exTime;
+    }
+
+  std::vector<std::pair<std::string,STYPE>> SVec(Sum.begin(),Sum.end());
+  std::sort(SVec.begin(),SVec.end(),
+	    [](const std::pair<std::string,STYPE>& A,
+	       const std::pair<std::string,STYPE>& B)
+	    { return std::get<2>(A.second)>std::get<2>(B.second); });
+
+  OX<<"# exclusive[s] inclusive[s] calls class::method"<<std::endl;
+  for(const auto& [name,SItem] : SVec)
+    OX<<std::setw(14)<<std::get<2>(SItem)<<" "
+      <<std::setw(14)<<std::get<1>(SItem)<<" "
+      <<std::setw(12)<<std::get<0>(SItem)<<" "<<name<<std::endl;
+  return;
+}
+
+} // NAMESPACE ELog
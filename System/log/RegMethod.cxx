@@ -3,7 +3,7 @@
  
  * File:   log/RegMethod.cxx
  *
- * Copyright (c) 2004-2016 by Stuart Ansell
+ * Copyright (c) 2004-2019 by Stuart Ansell
  *
  * This program is free software: you can redistribute it and/or modify
  * it under the terms of the GNU General Public License as published by
@@ -23,9 +23,12 @@
 #include <sstream>
 #include <map>
 #include <vector>
+#include <chrono>
+#include <thread>
 
 #include <iostream>
 
+#include "ProfileTree.h"
 #include "NameStack.h"
 #include "RegMethod.h"
 
@@ -33,25 +36,83 @@
 namespace ELog
 {
 
-NameStack RegMethod::Base;
+static NameStack*
+mainStack()
+  /*!
+    Stack of the main thread. It is never deleted so that
+    it is still valid in the static destructors [MemStack/EM]
+    which run after the thread_local objects have gone.
+    \return main thread stack
+  */
+{
+  static NameStack* MPtr(new NameStack);
+  return MPtr;
+}
+
+static const ProfileTree*
+mainProfile()
+  /*!
+    Call timings of the main thread for the profile report
+    \return tree [0 if not profiled]
+  */
+{
+  return mainStack()->getProfile();
+}
+
+NameStack&
+RegMethod::getStack()
+  /*!
+    Stack of the current thread. The first thread to register
+    [before any are started] is the main thread.
+    \return NameStack
+  */
+{
+  static const std::thread::id mainID(std::this_thread::get_id());
+  thread_local NameStack* TPtr(0);
+
+  if (!TPtr)
+    {
+      if (std::this_thread::get_id()==mainID)
+	{
+	  TPtr=mainStack();
+	  ProfileTree::setMainTree(&mainProfile);
+	}
+      else
+	{
+	  thread_local NameStack threadBase;
+	  TPtr=&threadBase;
+	}
+    }
+  return *TPtr;
+}
+
+RegMethod::RegMethod(const char* CN,const char* MN) :
+  BasePtr(&getStack()),indentLevel(0)
+  /*!
+    Constructor add name to stack [no copy]
+    \param CN :: Class name [literal]
+    \param MN :: Method name [literal]
+  */
+{
+  BasePtr->addComp(CN,MN);
+}
 
 RegMethod::RegMethod(const std::string& CN,
 		     const std::string& MN) :
-  indentLevel(0)
+  BasePtr(&getStack()),CName(CN),MName(MN),indentLevel(0)
   /*!
     Constructor add name to stack
     \param CN :: Class name
     \param MN :: Method name
   */
 {
-  Base.addComp(CN,MN);
-
+  BasePtr->addComp(CName.c_str(),MName.c_str());
 }
 
 RegMethod::RegMethod(const std::string& CN,
 		     const std::string& MN,
 		     const int param) :
-  indentLevel(0)
+  BasePtr(&getStack()),MName(MN),indentLevel(0)
   /*!
     Constructor add name to stack
     \param CN :: Class name
@@ -61,7 +122,8 @@ RegMethod::RegMethod(const std::string& CN,
 {
   std::ostringstream cx;
   cx<<"<"<<param<<">";
-  Base.addComp(CN+cx.str(),MN);
+  CName=CN+cx.str();
+  BasePtr->addComp(CName.c_str(),MName.c_str());
 }
 
 RegMethod::~RegMethod() 
@@ -69,9 +131,9 @@ RegMethod::~RegMethod()
     Destructor removes one from the stack
   */
 {
-  Base.popBack();
+  BasePtr->popBack();
   if (indentLevel) 
-    Base.addIndent(-indentLevel);
+    BasePtr->addIndent(-indentLevel);
 }
 
 void
@@ -82,7 +144,7 @@ RegMethod::setTrack(const std::string& ES)
     \param ES :: Extra string
   */
 {
-  Base.setExtra(ES);
+  BasePtr->setExtra(ES);
   return;
 }
 
@@ -92,7 +154,7 @@ RegMethod::clearTrack()
     Clear the extra track
    */
 {
-  Base.clearExtra();
+  BasePtr->clearExtra();
   return;
 }
   
@@ -103,7 +165,7 @@ RegMethod::incIndent()
   */
 {
   indentLevel+=2;
-  Base.addIndent(2);
+  BasePtr->addIndent(2);
   return;
 }
 
@@ -114,7 +176,7 @@ RegMethod::decIndent()
   */
 {
   indentLevel-=2;
-  Base.addIndent(-2);
+  BasePtr->addIndent(-2);
   return;
 }
 
@@ -30,8 +30,8 @@
 namespace ELog
 {
 
-std::vector<int> debugMethod::ABase;  
-int debugMethod::debugCnt(0);
+thread_local std::vector<int> debugMethod::ABase;  
+thread_local int debugMethod::debugCnt(0);
 
 debugMethod::debugMethod()
   /*!
@@ -3,7 +3,7 @@
  
  * File:   logInc/NameStack.h
  *
- * Copyright (c) 2004-2015 by Stuart Ansell
+ * Copyright (c) 2004-2019 by Stuart Ansell
  *
  * This program is free software: you can redistribute it and/or modify
  * it under the terms of the GNU General Public License as published by
@@ -24,30 +24,40 @@
 
 namespace ELog
 {
+  class ProfileTree;
+  
   /*!
     \class NameStack 
     \brief Holds a list of items for a calling stack
     \author S. Ansell
     \version 1.0
     \date June 2009
+
+    The names are not copied: they must exist until
+    they are popped [string literals or RegMethod members].
   */
 class NameStack
 {
  private:
 
+  static bool profileFlag;              ///< Profile the calls
+  
   std::map<std::string,int> key;        ///< Key names
-  std::vector<std::string> Class;       ///< Class Name
-  std::vector<std::string> Method;      ///< Method Name
+  std::vector<const char*> Class;       ///< Class Name
+  std::vector<const char*> Method;      ///< Method Name
   std::string Extra;                    ///< Extra tag if neeed
   size_t extraLevel;                    ///< Extra tag if neeed
   long int indentLevel;                 ///< Indent level
-
+  ProfileTree* PTree;                   ///< Call timing [if profiled]
+  
  public:
 
+  static void setProfile(const std::string&);
+  
   NameStack();
   NameStack(const NameStack&);
   NameStack& operator=(const NameStack&);
-  ~NameStack() {}    ///< Destructor
+  ~NameStack();
 
   void clear(); 
 
@@ -55,7 +65,7 @@ class NameStack
   void setExtra(const std::string&);
   /// Remove extra output for exception [early]
   void clearExtra() { Extra.clear(); }
-  void addComp(const std::string&,const std::string&);
+  void addComp(const char*,const char*);
   void popBack();
 
   
@@ -71,6 +81,8 @@ class NameStack
   void addIndent(const long int);
   /// Output of the indent level
   long int indent() const { return indentLevel; }
+  /// Call timings [0 if not profiled]
+  const ProfileTree* getProfile() const { return PTree; }
   
 };
 
@@ -39,6 +39,9 @@ namespace ELog
 
   enum { basic=1,warn=2,error=4,debug=8,diag=16,crit=32,trace=64 };
 
+  /// Drop all output from the calling thread [worker threads]
+  extern thread_local bool quietThread;
+
 /*!
   \class OutputLog
   \brief A master error log
@@ -112,12 +115,12 @@ class OutputLog
   /// Template specialization to get input
   template<typename InputType>
   OutputLog& operator<<(const InputType& A)
-    { cx<<A; return *this; }
+    { if (!quietThread) cx<<A; return *this; }
   
   /// Special to pick up modifications to the stream
   OutputLog& operator<<(std::ostream& (*f)(std::ostream&) )
     {
-      f(cx);
+      if (!quietThread) f(cx);
       return *this;
     }
 
@@ -0,0 +1,110 @@
+/*********************************************************************
+  CombLayer : MCNP(X) Input builder
+
+ * File:   logInc/ProfileTree.h
+ *
+ * Copyright (c) 2004-2019 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ****************************************************************************/
+#ifndef ELog_ProfileTree_h
+#define ELog_ProfileTree_h
+
+namespace ELog
+{
+  /*!
+    \class ProfileTree
+    \brief Call tree of class::method timings
+    \author S. Ansell
+    \version 1.0
+    \date May 2019
+
+    Filled from the RegMethod stack when profiling is
+    active. Each thread has its own tree which is merged
+    into a master tree when the thread ends. The master
+    tree is written at program exit as folded stacks
+    (flame graph input) and a flat summary.
+  */
+class ProfileTree
+{
+ public:
+
+  /// Access to the tree of the main thread [never ended]
+  typedef const ProfileTree* (*mainFUNC)();
+
+ private:
+
+  /// Clock for the timing
+  typedef std::chrono::steady_clock clockTYPE;
+
+  /*!
+    \struct profNode
+    \brief Accumulated values for one call path
+  */
+  struct profNode
+  {
+    std::string name;                     ///< class::method
+    size_t parent;                        ///< Parent node
+    std::map<std::string,size_t> child;   ///< Child nodes by name
+    size_t count;                         ///< Number of calls
+    double incTime;                       ///< Inclusive time [s]
+    double exTime;                        ///< Exclusive time [s]
+  };
+
+  /*!
+    \struct profFrame
+    \brief Open call on the stack
+  */
+  struct profFrame
+  {
+    size_t node;                          ///< Node index
+    size_t depth;                         ///< NameStack depth
+    clockTYPE::time_point start;          ///< Entry time
+    double childTime;                     ///< Time in children [s]
+  };
+
+  std::vector<profNode> Nodes;            ///< Call tree [0 : root]
+  std::vector<profFrame> Active;          ///< Open calls
+
+  size_t addNode(const size_t,const std::string&);
+  void mergeNode(const ProfileTree&,const size_t,const size_t);
+  std::string pathName(const size_t) const;
+
+ public:
+
+  ProfileTree();
+  ProfileTree(const ProfileTree&);
+  ProfileTree& operator=(const ProfileTree&);
+  ~ProfileTree() {}    ///< Destructor
+
+  static void setOutput(const std::string&);
+  static void addThread(const ProfileTree&);
+  static void setMainTree(mainFUNC);
+
+  void enter(const char*,const char*,const size_t);
+  /// NameStack depth of the last open call [0 if none]
+  size_t activeDepth() const
+    { return (Active.empty()) ? 0 : Active.back().depth; }
+  void leave();
+  void closeAll();
+
+  void merge(const ProfileTree&);
+  void writeFolded(std::ostream&) const;
+  void writeSummary(std::ostream&) const;
+};
+
+}
+
+#endif
@@ -3,7 +3,7 @@
  
  * File:   logInc/RegMethod.h
  *
- * Copyright (c) 2004-2016 by Stuart Ansell
+ * Copyright (c) 2004-2019 by Stuart Ansell
  *
  * This program is free software: you can redistribute it and/or modify
  * it under the terms of the GNU General Public License as published by
@@ -33,24 +33,30 @@ namespace ELog
 
     This class is called as a registration class.
     It keeps location etc possible for 
+    exceptions. String literals are registered without
+    a copy; other names are held in the object.
   */
 
 class RegMethod
 {
  private:
 
-  static NameStack Base;           ///< Singleton of base to register
-
+  NameStack* BasePtr;              ///< Stack of this thread
+  std::string CName;               ///< Class name [if not literal]
+  std::string MName;               ///< Method name [if not literal]
   int indentLevel;                 ///< Additional indent
   /// \cond NOWRITTEN
   RegMethod(const RegMethod&);
   RegMethod& operator=(const RegMethod&);
   /// \endcond NOWRITTEN
 
+  static NameStack& getStack();
+
  public:
 
   /// Access NameStack pointer
-  NameStack* getBasePtr() { return &Base; }
+  NameStack* getBasePtr() { return BasePtr; }
+  RegMethod(const char*,const char*);
   RegMethod(const std::string&,const std::string&);
   RegMethod(const std::string&,const std::string&,const int);
   ~RegMethod();
@@ -59,11 +65,12 @@ class RegMethod
   void clearTrack();
   
   /// Access string
-  static std::string getBase() { return Base.getBase(); }
+  static std::string getBase() { return getStack().getBase(); }
   /// Access string
-  static std::string getFull() { return Base.getFullTree(); }
+  static std::string getFull() { return getStack().getFullTree(); }
   /// Access particular item 
-  static std::string getItem(const int I) { return Base.getItem(I); }
+  static std::string getItem(const int I)
+    { return getStack().getItem(I); }
 
   void incIndent();
   void decIndent();
@@ -40,8 +40,8 @@ class debugMethod
 {
  private:
 
-  static int debugCnt;            ///< Current sum of ABase
-  static std::vector<int> ABase;  ///< Singleton actives
+  static thread_local int debugCnt;            ///< Current sum of ABase
+  static thread_local std::vector<int> ABase;  ///< Per-thread actives
 
   /// \cond NOWRITTEN
   debugMethod(const debugMethod&);
@@ -27,6 +27,7 @@
 #include <vector>
 #include <set>
 #include <map>
+#include <array>
 #include <stack>
 #include <string>
 #include <sstream>
@@ -49,6 +50,7 @@
 #include "MapSupport.h"
 #include "RotCounter.h"
 #include "BnId.h"
+#include "BDD.h"
 #include "AcompTools.h"
 #include "Acomp.h"
 
@@ -655,104 +657,45 @@ Acomp::copySimilar(const Acomp& A)
   return 0;
 }
 
-void
-Acomp::addUnit(const std::vector<int>& Index,
-	       const BnId& BX)
-  /*!
-    Given a single BnId unit and an index
-    adds it to the main Units object.
-    \param Index :: number , surfNumber
-    \param BX :: binary component
-  */
-{
-  int flag,S;
-  size_t V;
-  for(size_t i=0;i<BX.Size();i++)
-    {
-      flag=BX[i];
-      if (flag)
-        {
-	  signSplit(flag,S,V); // sets S and V
-	  if (V>Index.size())
-	    throw ColErr::IndexError<size_t>(V,Index.size(),
-					     "Acomp::addUnit ");
-	  Units.insert(S*Index[i]);
-	}
-    }
-  return;
-}
+// -------------------------------------
+//   PUBLIC FUNCTIONS 
+// -------------------------------------
+
 
 void
-Acomp::assignDNF(const std::vector<int>& Index,const std::vector<BnId>& A)
+Acomp::assignCover(const std::vector<std::vector<int>>& Cubes,
+		   const bool cnfFlag)
   /*!
-    Assign the object to the Essentual PI in the vector
-    A. This will make the form DNF.
-    \param Index :: SurfNumbers
-    \param A :: Vector of BnId's that are valid
+    Assign the object to a cover from the BDD. 
+    \param Cubes :: Cubes [intersections] of the DNF / cubes
+    of the complement for the CNF
+    \param cnfFlag :: Make the CNF [each cube complemented
+    into a union]
   */
 {
   clear();
-  if (A.empty()) return;
-  
-  if (A.size()==1)  //special case for single intersection 
-    {
-      Intersect=1;
-      addUnit(Index,A[0]);
-      return;
-    }
-  
-  Intersect=0;               // union of intersection
-  std::vector<BnId>::const_iterator vc;
-  for(vc=A.begin();vc!=A.end();vc++)
-    {
-      Acomp Px(Inter);  
-      Px.addUnit(Index,*vc);
-      addComp(Px);
-    }
-  return;
-}
+  if (Cubes.empty()) return;
 
-void
-Acomp::assignCNF(const std::vector<int>& Index,
-		 const std::vector<BnId>& A)
-  /*!
-    Assign the object to the Essentual PI in the vector
-    A. This will make the form DNF.
-    \param Index :: SurfNumbers
-    \param A :: Vector of BnId's that are valid
-  */
-{
-  Units.clear();
-  deleteComp();
-  if (A.empty())
-    return;
-  
-  if (A.size()==1)  //special case for single union
+  const int sign=(cnfFlag) ? -1 : 1;
+  if (Cubes.size()==1)  //special case for single intersection/union
     {
-      Intersect=0;
-      addUnit(Index,A[0]);
+      Intersect=(cnfFlag) ? 0 : 1;
+      for(const int SN : Cubes.front())
+	Units.insert(sign*SN);
       return;
     }
-  
-  Intersect=1;               // intersection of union 
-  std::vector<BnId>::const_iterator vc;
-  for(vc=A.begin();vc!=A.end();vc++)
+
+  Intersect=(cnfFlag) ? 1 : 0;
+  for(const std::vector<int>& CItem : Cubes)
     {
-      Acomp Px(Union);      // Union
-      BnId X=*vc;
-      X.reverse();
-      Px.addUnit(Index,X);
+      Acomp Px((cnfFlag) ? Union : Inter);
+      for(const int SN : CItem)
+	Px.Units.insert(sign*SN);
       addComp(Px);
     }
   return;
 }
 
-
-// -------------------------------------
-//   PUBLIC FUNCTIONS 
-// -------------------------------------
-
-
 void
 Acomp::Sort()
   /*!
@@ -829,22 +772,8 @@ Acomp::logicalCover(const Acomp& A) const
 	}
     } 
 
-  std::vector<int> keyNumbers;
-  if (Aflag)  // then 
-    keyNumbers.assign(BLit.begin(),BLit.end());
-  else
-    keyNumbers.assign(ALit.begin(),ALit.end());
-
-  std::map<int,int> Base;       // keynumber :: trueth value
-  for(const int CN : keyNumbers)
-    Base.emplace(CN,0);   // all false
-  do
-    {
-      if (isTrue(Base) != A.isTrue(Base))
-	return 0;
-    } while (!MapSupport::iterateBinMap(Base));
-  
-  return 1;
+  BDD BObj((Aflag) ? BLit : ALit);
+  return (makeBDD(BObj)==A.makeBDD(BObj)) ? 1 : 0;
 }
 
 
@@ -888,33 +817,12 @@ Acomp::logicalIntersectCover(const Acomp& A) const
 	}
     } 
 
-  std::vector<int> keyNumbers;
-  Acomp pairCC(1);
-  pairCC.Comp.push_back(*this);
-  pairCC.Comp.push_back(A);
-
-  if (ADiffFlag)  // then
-    keyNumbers.assign(BLit.begin(),BLit.end());
-  else
-    keyNumbers.assign(ALit.begin(),ALit.end());
-  
-  std::map<int,int> Base;       // keynumber :: trueth value
-  for(const int CN : keyNumbers)
-    Base.emplace(CN,0);   // all false
+  BDD BObj((ADiffFlag) ? BLit : ALit);
+  const size_t TNode=makeBDD(BObj);
+  const size_t ANode=A.makeBDD(BObj);
+  const size_t pairNode=BObj.andNode(TNode,ANode);
 
-  bool tOut(1),aOut(1);
-  do
-    {
-      const bool pairCCFlag=pairCC.isTrue(Base);
-      const bool TFlag=this->isTrue(Base);
-      const bool AFlag=A.isTrue(Base);
-
-      if (TFlag!=pairCCFlag) tOut=0;
-      if (AFlag!=pairCCFlag) aOut=0;
-      if (!aOut && !tOut) return 0;
-    } while (!MapSupport::iterateBinMap(Base));
-
-  return (tOut ? 1 : 0 ) | (aOut ? 2 : 0 );
+  return ((TNode==pairNode) ? 1 : 0 ) | ((ANode==pairNode) ? 2 : 0 );
 }
 
   
@@ -932,20 +840,9 @@ Acomp::logicalEqual(const Acomp& A) const
   getAbsLiterals(ALitMap);
   A.getAbsLiterals(ALitMap);
 
-  
-  const std::vector<int> keyNumbers(ALitMap.begin(),ALitMap.end());    
-  std::map<int,int> Base;       // keynumber :: trueth value
-  for(const int CN : ALitMap)
-    Base.emplace(CN,0);
-
-  do
-    {
-      if (isTrue(Base) != A.isTrue(Base))
-	return 0;
-
-    } while (!MapSupport::iterateBinMap(Base));
-
-  return 1;
+  // reduced diagrams are equal if the nodes are the same
+  BDD BObj(ALitMap);
+  return (makeBDD(BObj)==A.makeBDD(BObj));
 }
 
 
@@ -1119,249 +1016,6 @@ Acomp::removeEqComp()
 }
 
 
-int
-Acomp::makePI(std::vector<BnId>& DNFobj) const
-  /*!
-    This method finds the principle implicants.
-    \param DNFobj :: A vector of Binary ID from a true 
-    vectors of keyvalues.
-    \returns number of PIs found.
-    \todo  Can we set this up to get non-pairs
-    i.e. one pass.
-    
-  */
-{
-  if (DNFobj.empty())   // no work to do return.
-    return 0;
-  // Note: need to store PI components separately
-  // since we don't want to loop continuously through them
-  std::vector<BnId> Work;       // Working copy
-  std::vector<BnId> PIComp;     // Store for PI componends
-  std::vector<BnId> Tmod;       // store modified components
-  int changeCount(0);           // Number change
-  std::vector<BnId>::iterator uend;     // itor to remove unique
-  // Need to make an initial copy.
-  Work=DNFobj;
-
-  int cnt(0);
-  do
-    {
-      cnt++;
-      // Deal with tri-state objects ??
-      sort(Work.begin(),Work.end());
-      uend=unique(Work.begin(),Work.end());
-      Work.erase(uend,Work.end());
-      Tmod.clear();                  // erase all at the start
-
-      //set PI status to 1
-      for_each( Work.begin(),Work.end(),
-		std::bind2nd(std::mem_fun_ref(&BnId::setPI),1) );
-
-      //Collect into pairs which have a difference of +/- one 
-      // object
-      // Can sort this realive to 
-      std::vector<BnId>::iterator vc;
-      for(vc=Work.begin();vc!=Work.end();vc++)
-	{
-	  const size_t GrpIndex(vc->TrueCount()+1);
-	  std::vector<BnId>::iterator oc=vc+1;
-
-	  for(oc=vc+1;oc!=Work.end();oc++)
-	    {
-	      const size_t OCnt=oc->TrueCount();
-			
-
-	      if (OCnt>GrpIndex)
-		break;
-	      if (OCnt==GrpIndex)
-	        {
-		  std::pair<int,BnId> cVal=vc->makeCombination(*oc);
-		  if (cVal.first==1)   // was complementary
-		    {
-		      Tmod.push_back(cVal.second);
-		      oc->setPI(0);         
-		      vc->setPI(0);
-		      changeCount++;       // 1 changed
-		    }
-		}
-	    }
-	}
-
-      for(const BnId& BI : Work)
-	if (BI.PIstatus()==1)
-	  PIComp.push_back(BI);
-      
-      Work=Tmod;
-    } while (!Tmod.empty());
-  // Copy over the unit.
-
-  return makeEPI(DNFobj,PIComp);
-}
-
-
-int
-Acomp::makeEPI(std::vector<BnId>& DNFobj,
-	       std::vector<BnId>& PIform) const
-  /*!
-    Creates an essentual PI list (note: this is 
-    not unique).
-    Given the list form the EPI based on the Quine-McClusky method.
-
-    \param DNFobj :: Object in DNF form 
-    \param PIform :: List of rules in Prime Implicant form
-       It is set on exit (to the EPI)
-    \returns :: 1 if successful and 0 if failed
-  */
-{
-  ELog::RegMethod RegA("Acomp","makeEPI");
-
-  const int debug(0);
-  if (PIform.empty())
-    return 0;
-  
-  std::vector<BnId> EPI;  // Created Here.
-
-  std::vector<int> EPIvalue;
-  // Make zeroed matrix.
-  Geometry::MatrixBase<int> Grid(PIform.size(),DNFobj.size()); 
-  std::vector<size_t> DNFactive(DNFobj.size());       // DNF that active
-  std::vector<size_t> PIactive(PIform.size());        // PI that are active
-  std::vector<int> DNFscore(DNFobj.size());        // Number in each channel
-  std::vector<int> PIscore(DNFobj.size());        // Number in each channel
-  
-  //Populate
-  for(size_t pc=0;pc!=PIform.size();pc++)
-    PIactive[pc]=pc;
-  
-  for(size_t ic=0;ic!=DNFobj.size();ic++)
-    {
-      DNFactive[ic]=ic;                            //populate (avoid a loop)
-      for(size_t pc=0;pc!=PIform.size();pc++)
-	{
-	  if (PIform[pc].equivalent(DNFobj[ic]))
-	    {
-	      Grid[pc][ic]=1;
-	      DNFscore[ic]++;
-	    }
-	}
-      if (DNFscore[ic]==0)
-	{
-	  ELog::EM<<"PIForm:"<<ELog::endCrit;
-	  for(const BnId& BI : PIform)
-	    ELog::EM<<BI<<ELog::endDiag;
-
-	  ELog::EM<<"Error with DNF / EPI determination at "<<ic<<ELog::endCrit;
-	  ELog::EM<<" Items "<<DNFobj[ic]<<ELog::endCrit;
-	  return 0;
-	}
-    }
-  /// DEBUG PRINT 
-  //  printImplicates(PIform,Grid);
-  /// END DEBUG
-
-  std::vector<size_t>::iterator dx;
-  std::vector<size_t>::iterator ddx;    // DNF active iterator
-  std::vector<size_t>::iterator px;     // PIactive iterator
-
-  // 
-  // First remove singlets:
-  // 
-  for(dx=DNFactive.begin();dx!=DNFactive.end();dx++)
-    {
-      if (*dx!=ULONG_MAX && DNFscore[*dx]==1)        // EPI (definately)
-	{
-	  for(px=PIactive.begin();
-	      px!=PIactive.end() && !Grid[*px][*dx];px++) ;
-	  if (px!=PIactive.end())
-	    {
-	      EPI.push_back(PIform[*px]);
-	      // remove all minterm that the EPI covered
-	      for(ddx=DNFactive.begin();ddx!=DNFactive.end();ddx++)
-		if (*ddx!=ULONG_MAX && Grid[*px][*ddx])
-		  *ddx= ULONG_MAX;      //mark for deletion (later)
-	      // Can remove PIactive now.
-	      PIactive.erase(px,px+1);
-	    }
-	}
-    }
-  // Remove dead items from active list
-  DNFactive.erase(
-    remove_if(DNFactive.begin(),DNFactive.end(),
-	      std::bind(std::equal_to<size_t>(),
-			std::placeholders::_1,ULONG_MAX)),
-    DNFactive.end());
-
-
-  /// DEBUG PRINT 
-  if (debug)
-    {
-      for(px=PIactive.begin();px!=PIactive.end();px++)
-	{
-	  ELog::EM<<PIform[*px]<<":";
-	  for(ddx=DNFactive.begin();ddx!=DNFactive.end();ddx++)
-	    ELog::EM<<((Grid[*px][*ddx]) ? " 1" : " 0");
-	  ELog::EM<<ELog::endDebug;
-	}
-      ELog::EM<<"END OF TABLE "<<ELog::endDebug;
-    }
-
-  // Ok -- now the hard work...
-  // need to find shortest "combination" that spans
-  // the remaining table.
-  
-  // First Make a new matrix for speed.  Useful ???
-  Geometry::MatrixBase<int> Cmat(PIactive.size(),DNFactive.size());  // corrolation matrix
-  size_t cm(0);
-  for(px=PIactive.begin();px!=PIactive.end();px++)
-    {
-      size_t dm(0);
-      for(ddx=DNFactive.begin();ddx!=DNFactive.end();ddx++)
-	{
-	  if (Grid[*px][*ddx])
-	    Cmat[cm][dm]=1;
-	  dm++;
-	} 
-      cm++;
-    }
-
-  const size_t Dsize(DNFactive.size());
-  const size_t Psize(PIactive.size());
-  //icount == depth of search ie 
-
-  for(size_t Icount=1;Icount<Psize;Icount++)
-    {
-      // This counter is a ripple counter, ie 1,2,3 where no numbers 
-      // are the same. BUT it is acutally 0->N 0->N 0->N
-      // index by A, A+1 ,A+2  etc
-      RotaryCounter<size_t> Index(Icount,Psize);
-      do {
-	size_t di;
-	for(di=0;di<Dsize;di++)   //check each orignal position
-	  {
-	    size_t vecI;
-	    for(vecI=0;vecI<Icount &&
-		  !Cmat[Index[vecI]][di];vecI++) ;
-	    if (vecI==Icount)
-	      break;
-	  }
-	if (di==Dsize)          // SUCCESS!!!!!
-	  {
-	    for(size_t iout=0;iout<Icount;iout++)
-	      EPI.push_back(PIform[Index[iout]]);
-	    DNFobj=EPI;
-	    return 1;;
-	  }
-      } while(!(++Index));
-    }
-
-  //OH well that means every PIactive is a EPI :-(
-  for(px=PIactive.begin();px!=PIactive.end();px++)
-    EPI.push_back(PIform[*px]);
-  DNFobj=EPI;
-
-  return 1;
-}
-
 std::vector<int>
 Acomp::getKeys() const
   /*!
@@ -1374,86 +1028,47 @@ Acomp::getKeys() const
   return std::vector<int>(litMap.begin(),litMap.end());
 }
 
-int
-Acomp::getDNFobject(std::vector<int>& keyNumbers,
-		    std::vector<BnId>& DNFobj) const
-  /*!
-    Creates the DNF items (ie the binary list
-    of true statements) It forms a sum of products.
-    The original is not changed by the keynumbers and the 
-    DNF objects are output into the function parameters.
-    \param keyNumbers :: index list of the DNFobj. The
-    [bitNum]->rule/key number.
-    \param DNFobj :: write out the DNF object into BnId form
-    \retval 0 :: on success.
-    \retval -1 :: on error.
-  */
-{
-  std::set<int> litMap;       // keynumber
-  std::map<int,int> Base;         // keynumber :: value
-  getAbsLiterals(litMap);
-  
-  if (litMap.empty())
-    return -1;
-  
-  keyNumbers.assign(litMap.begin(),litMap.end());
-
-  for(const int CN : litMap)
-    Base.emplace(CN,0);
-
-  DNFobj.clear();  
-  BnId State(keyNumbers.size(),0);                 //zero base
-
-  do
-    {
-      if (isTrue(Base))
-	{
-	  State.setState(keyNumbers,Base);
-	  DNFobj.push_back(State);
-	}
-    } while (!MapSupport::iterateBinMap(Base));
-
-  return 0;
-}
- 
-
 int
 Acomp::makeDNFobject()
   /*!
-    Sets the object to the DNF form.
+    Sets the object to the DNF form [irredundant
+    sum of products from the BDD].
     \retval 0 on failure
     \retval Number of DNF components
   */
 {
-  std::vector<BnId> DNFobj;
-  std::vector<int> keyNumbers;
-  if (!getDNFobject(keyNumbers,DNFobj))
-    {      
-      if (makePI(DNFobj))
-	assignDNF(keyNumbers,DNFobj);
+  std::set<int> litMap;
+  getAbsLiterals(litMap);
+  if (litMap.empty())
+    return 0;
 
-      return static_cast<int>(DNFobj.size());
-    }
-  return 0;
+  BDD BObj(litMap);
+  const std::vector<BDD::CUBE> Cubes=BObj.cover(makeBDD(BObj));
+  if (!Cubes.empty())
+    assignCover(Cubes,0);
+  return static_cast<int>(Cubes.size());
 }
 
 int
 Acomp::makeCNFobject()
   /*!
-    Sets the object to the CNF form.
+    Sets the object to the CNF form. The clauses are the 
+    complement of the cover of the complement.
     \retval 0 on failure
     \retval Number of CNF components
   */
 {
-  std::vector<BnId> CNFobj;
-  std::vector<int> keyNumbers;
-  if (!getCNFobject(keyNumbers,CNFobj))
-    {
-      if (makePI(CNFobj))
-	assignCNF(keyNumbers,CNFobj);
-      return static_cast<int>(CNFobj.size());
-    }
-  return 0;
+  std::set<int> litMap;
+  getAbsLiterals(litMap);
+  if (litMap.empty())
+    return 0;
+
+  BDD BObj(litMap);
+  const std::vector<BDD::CUBE> Cubes=
+    BObj.cover(BObj.notNode(makeBDD(BObj)));
+  if (!Cubes.empty())
+    assignCover(Cubes,1);
+  return static_cast<int>(Cubes.size());
 }
 
 int
@@ -1484,63 +1099,20 @@ Acomp::getDNFpart(std::vector<Acomp>& Parts) const
       return static_cast<int>(Parts.size());
     }
   
-  std::vector<int> keyNumbers;
-  std::vector<BnId> DNFobj;
-  if (!getDNFobject(keyNumbers,DNFobj))
-    {
-      if (makePI(DNFobj))
-	{
-	  for(const BnId& BI : DNFobj)
-	    {
-	      // make an intersection and add components
-	      Acomp Aitem(Inter); 
-	      Aitem.addUnit(keyNumbers,BI);
-	      Parts.push_back(Aitem);
-	    }
-	}	  
-      return static_cast<int>(Parts.size());
-    }
-  return 0;
-}
-
-int
-Acomp::getCNFobject(std::vector<int>& keyNumbers,
-		    std::vector<BnId>& CNFobj) const
-  /*!
-    Creates the CNF items (ie the binary list
-    of false statements) It forms a sum of products.
-    The original is not changed by the keynumbers and the 
-    DNF objects are output into the function parameters.
-    \param keyNumbers :: index list of the CNFobj. The
-    [bitNum]->rule/key number.
-    \param CNFobj :: write out the CNF object into BnId form
-    \retval 0 :: on success.
-    \retval -1 :: on error.
-  */
-{
-  std::set<int> litMap;       // keynumber :: number of occurances
-  std::map<int,int> Base;         // keynumber :: value
+  std::set<int> litMap;
   getAbsLiterals(litMap);
-  
-  if (litMap.size()<1)
-    return -1;
-
-  keyNumbers.assign(litMap.begin(),litMap.end());
-  for(const int CN : keyNumbers)
-    Base.emplace(CN,1);
+  if (litMap.empty())
+    return 0;
 
-  CNFobj.clear();
-  BnId State(Base.size(),0);    //zero base  
-  do
+  BDD BObj(litMap);
+  for(const BDD::CUBE& CItem : BObj.cover(makeBDD(BObj)))
     {
-      State.mapState(keyNumbers,Base);
-      if (!isTrue(Base))
-	{
-	  CNFobj.push_back(State);
-	}
-    } while(++State);
- 
-  return 0;
+      // make an intersection and add components
+      Acomp Aitem(Inter); 
+      Aitem.Units.insert(CItem.begin(),CItem.end());
+      Parts.push_back(Aitem);
+    }
+  return static_cast<int>(Parts.size());
 }
 
 int
@@ -1602,6 +1174,27 @@ Acomp::isTrue(const std::map<int,int>& Base) const
   return 0;
 }
 
+size_t
+Acomp::makeBDD(BDD& BObj) const
+  /*!
+    Build the function in a BDD
+    \param BObj :: BDD [containing all the literals]
+    \return node of the function
+  */
+{
+  if (Units.empty() && Comp.empty())
+    return (trueFlag == -1) ? BDD::falseNode : BDD::trueNode;
+
+  size_t Out=(Intersect) ? BDD::trueNode : BDD::falseNode;
+  for(const int uv : Units)
+    Out=(Intersect) ? BObj.andNode(Out,BObj.literal(uv)) :
+      BObj.orNode(Out,BObj.literal(uv));
+  for(const Acomp& AC : Comp)
+    Out=(Intersect) ? BObj.andNode(Out,AC.makeBDD(BObj)) :
+      BObj.orNode(Out,AC.makeBDD(BObj));
+  return Out;
+}
+
 std::pair<Acomp,Acomp>
 Acomp::algDiv(const Acomp& G)
   /*!
@@ -637,7 +637,7 @@ bool
 Algebra::logicalEqual(const Algebra& A) const
   /*!
     Calculate if two functions are logically
-    equivilent (exhaustive search)
+    equivilent [same BDD]
     \param A :: Algrebra to test
     \return True/False
    */
@@ -0,0 +1,359 @@
+/*********************************************************************
+  CombLayer : MCNP(X) Input builder
+
+ * File:   monte/BDD.cxx
+ *
+ * Copyright (c) 2004-2019 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ****************************************************************************/
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <cmath>
+#include <vector>
+#include <array>
+#include <set>
+#include <map>
+#include <string>
+#include <sstream>
+#include <algorithm>
+
+#include "Exception.h"
+#include "FileReport.h"
+#include "NameStack.h"
+#include "RegMethod.h"
+#include "OutputLog.h"
+#include "BDD.h"
+
+namespace MonteCarlo
+{
+
+const size_t BDD::falseNode(0);
+const size_t BDD::trueNode(1);
+
+BDD::BDD(const std::set<int>& Literals) :
+  keyNumbers(Literals.begin(),Literals.end())
+  /*!
+    Constructor
+    \param Literals :: Literal numbers [positive] in order
+  */
+{
+  for(size_t i=0;i<keyNumbers.size();i++)
+    keyLevel.emplace(keyNumbers[i],i);
+
+  // constants are below all the literals
+  const size_t NL(keyNumbers.size());
+  Nodes.push_back(bddNode({NL,falseNode,falseNode}));
+  Nodes.push_back(bddNode({NL,trueNode,trueNode}));
+}
+
+BDD::BDD(const BDD& A) :
+  keyNumbers(A.keyNumbers),keyLevel(A.keyLevel),
+  Nodes(A.Nodes),uniqueTable(A.uniqueTable),
+  opCache(A.opCache),coverCache(A.coverCache)
+  /*!
+    Copy constructor
+    \param A :: BDD to copy
+  */
+{}
+
+BDD&
+BDD::operator=(const BDD& A)
+  /*!
+    Assignment operator
+    \param A :: BDD to copy
+    \return *this
+  */
+{
+  if (this!=&A)
+    {
+      keyNumbers=A.keyNumbers;
+      keyLevel=A.keyLevel;
+      Nodes=A.Nodes;
+      uniqueTable=A.uniqueTable;
+      opCache=A.opCache;
+      coverCache=A.coverCache;
+    }
+  return *this;
+}
+
+size_t
+BDD::makeNode(const size_t level,const size_t low,const size_t high)
+  /*!
+    Find/create the reduced node
+    \param level :: Literal level
+    \param low :: Node if the literal is false
+    \param high :: Node if the literal is true
+    \return node index
+  */
+{
+  if (low==high) return low;
+
+  const std::array<size_t,3> key({level,low,high});
+  std::map<std::array<size_t,3>,size_t>::const_iterator mc=
+    uniqueTable.find(key);
+  if (mc!=uniqueTable.end())
+    return mc->second;
+
+  Nodes.push_back(bddNode({level,low,high}));
+  uniqueTable.emplace(key,Nodes.size()-1);
+  return Nodes.size()-1;
+}
+
+size_t
+BDD::topLevel(const size_t A,const size_t B) const
+  /*!
+    Get the first level of two nodes
+    \param A :: Node
+    \param B :: Node
+    \return lowest level
+  */
+{
+  return std::min(Nodes[A].level,Nodes[B].level);
+}
+
+void
+BDD::cofactor(const size_t N,const size_t level,
+	      size_t& low,size_t& high) const
+  /*!
+    Get the nodes with the literal at level set false/true
+    \param N :: Node
+    \param level :: Level [at or above the node]
+    \param low :: Node with the literal false
+    \param high :: Node with the literal true
+  */
+{
+  if (Nodes[N].level==level)
+    {
+      low=Nodes[N].low;
+      high=Nodes[N].high;
+    }
+  else
+    {
+      low=N;
+      high=N;
+    }
+  return;
+}
+
+size_t
+BDD::apply(const bddOp op,const size_t AIn,const size_t BIn)
+  /*!
+    Carry out an operation on two nodes
+    \param op :: Operation [B not used for not]
+    \param AIn :: First node
+    \param BIn :: Second node
+    \return result node
+  */
+{
+  size_t A(AIn);
+  size_t B(BIn);
+  switch(op)
+    {
+    case bddOp::andOp:
+      if (A==falseNode || B==falseNode) return falseNode;
+      if (A==trueNode || A==B) return B;
+      if (B==trueNode) return A;
+      if (A>B) std::swap(A,B);
+      break;
+    case bddOp::orOp:
+      if (A==trueNode || B==trueNode) return trueNode;
+      if (A==falseNode || A==B) return B;
+      if (B==falseNode) return A;
+      if (A>B) std::swap(A,B);
+      break;
+    case bddOp::notOp:
+      if (A==falseNode) return trueNode;
+      if (A==trueNode) return falseNode;
+      B=0;
+      break;
+    }
+
+  const std::array<size_t,3> key({static_cast<size_t>(op),A,B});
+  std::map<std::array<size_t,3>,size_t>::const_iterator mc=
+    opCache.find(key);
+  if (mc!=opCache.end())
+    return mc->second;
+
+  const size_t level=(op==bddOp::notOp) ?
+    Nodes[A].level : topLevel(A,B);
+  size_t ALow,AHigh,BLow,BHigh;
+  cofactor(A,level,ALow,AHigh);
+  cofactor(B,level,BLow,BHigh);
+
+  const size_t low=apply(op,ALow,BLow);
+  const size_t high=apply(op,AHigh,BHigh);
+  const size_t Out=makeNode(level,low,high);
+  opCache.emplace(key,Out);
+  return Out;
+}
+
+size_t
+BDD::literal(const int SN)
+  /*!
+    Get the node of a single literal
+    \param SN :: Signed literal [-ve for complement]
+    \return node
+  */
+{
+  std::map<int,size_t>::const_iterator mc=keyLevel.find(std::abs(SN));
+  if (mc==keyLevel.end())
+    throw ColErr::InContainerError<int>(SN,"BDD literal");
+  return (SN>0) ? makeNode(mc->second,falseNode,trueNode) :
+    makeNode(mc->second,trueNode,falseNode);
+}
+
+size_t
+BDD::andNode(const size_t A,const size_t B)
+  /*!
+    Intersection of two functions
+    \param A :: Node
+    \param B :: Node
+    \return A.B
+  */
+{
+  return apply(bddOp::andOp,A,B);
+}
+
+size_t
+BDD::orNode(const size_t A,const size_t B)
+  /*!
+    Union of two functions
+    \param A :: Node
+    \param B :: Node
+    \return A+B
+  */
+{
+  return apply(bddOp::orOp,A,B);
+}
+
+size_t
+BDD::notNode(const size_t A)
+  /*!
+    Complement of a function
+    \param A :: Node
+    \return A'
+  */
+{
+  return apply(bddOp::notOp,A,0);
+}
+
+size_t
+BDD::ISOP(const size_t L,const size_t U,std::vector<CUBE>& Cubes)
+  /*!
+    Irredundant sum of products of a function between
+    L and U [Minato-Morreale]. Each cube is prime within U
+    and no cube can be removed.
+    \param L :: Lower function [must be covered]
+    \param U :: Upper function [cover must be within]
+    \param Cubes :: Cubes of the cover
+    \return node of the cover
+  */
+{
+  Cubes.clear();
+  if (L==falseNode)
+    return falseNode;
+  if (U==trueNode)
+    {
+      Cubes.push_back(CUBE());
+      return trueNode;
+    }
+
+  const std::pair<size_t,size_t> key(L,U);
+  std::map<std::pair<size_t,size_t>,
+	   std::pair<size_t,std::vector<CUBE>>>::const_iterator mc=
+    coverCache.find(key);
+  if (mc!=coverCache.end())
+    {
+      Cubes=mc->second.second;
+      return mc->second.first;
+    }
+
+  const size_t level=topLevel(L,U);
+  size_t L0,L1,U0,U1;
+  cofactor(L,level,L0,L1);
+  cofactor(U,level,U0,U1);
+
+  // cubes that need the literal false / true
+  std::vector<CUBE> C0,C1,CD;
+  const size_t R0=ISOP(andNode(L0,notNode(U1)),U0,C0);
+  const size_t R1=ISOP(andNode(L1,notNode(U0)),U1,C1);
+  // remainder without the literal
+  const size_t LD=orNode(andNode(L0,notNode(R0)),
+			 andNode(L1,notNode(R1)));
+  const size_t RD=ISOP(LD,andNode(U0,U1),CD);
+
+  const int SN=keyNumbers[level];
+  for(CUBE& CItem : C0)
+    {
+      CItem.push_back(-SN);
+      Cubes.push_back(CItem);
+    }
+  for(CUBE& CItem : C1)
+    {
+      CItem.push_back(SN);
+      Cubes.push_back(CItem);
+    }
+  Cubes.insert(Cubes.end(),CD.begin(),CD.end());
+
+  const size_t Out=orNode(makeNode(level,R0,R1),RD);
+  coverCache.emplace(key,std::pair<size_t,std::vector<CUBE>>(Out,Cubes));
+  return Out;
+}
+
+std::vector<BDD::CUBE>
+BDD::cover(const size_t N)
+  /*!
+    Get an irredundant sum of products of a function.
+    The CNF of a function is the complement of the cover
+    of the complement.
+    \param N :: Node of the function
+    \return cubes [empty for false / one empty cube for true]
+  */
+{
+  std::vector<CUBE> Cubes;
+  ISOP(N,N,Cubes);
+  for(CUBE& CItem : Cubes)
+    std::sort(CItem.begin(),CItem.end(),
+	      [](const int A,const int B)
+	      { return std::abs(A)<std::abs(B); });
+  return Cubes;
+}
+
+bool
+BDD::isTrue(const size_t N,const std::map<int,int>& Base) const
+  /*!
+    Evaluate a function
+    \param N :: Node of the function
+    \param Base :: Literal : state
+    \return function value
+  */
+{
+  size_t index(N);
+  while(index>trueNode)
+    {
+      const bddNode& BN(Nodes[index]);
+      std::map<int,int>::const_iterator mc=
+	Base.find(keyNumbers[BN.level]);
+      if (mc==Base.end())
+	throw ColErr::InContainerError<int>
+	  (keyNumbers[BN.level],"BDD::isTrue Base unit not found");
+      index=(mc->second) ? BN.high : BN.low;
+    }
+  return (index==trueNode);
+}
+
+}  // NAMESPACE MonteCarlo
@@ -1465,6 +1465,50 @@ HeadRule::substituteSurf(const int SurfN,const int newSurfN,
   return cnt;
 }
 
+void
+HeadRule::substituteTemplate(const std::vector<int>& newKeys)
+  /*!
+    Set the surfaces of a template rule. Each surface key
+    in the template is an index [1-N] into newKeys and 
+    is replaced by the signed surface number [the sign of the 
+    template key multiplies]. Surface pointers are cleared.
+    \param newKeys :: Signed surface numbers
+  */
+{
+  ELog::RegMethod RegA("HeadRule","substituteTemplate");
+
+  if (!HeadNode) return;
+  
+  std::stack<Rule*> TreeLine;   
+  TreeLine.push(HeadNode);
+  while (!TreeLine.empty())
+    {
+      Rule* headPtr=TreeLine.top();
+      TreeLine.pop();
+      SurfPoint* SP=dynamic_cast<SurfPoint*>(headPtr);
+      if (SP)
+	{
+	  const size_t index(static_cast<size_t>(SP->getKeyN()));
+	  if (!index || index>newKeys.size())
+	    throw ColErr::IndexError<size_t>
+	      (index,newKeys.size(),"template key");
+	  SP->setKeyN(SP->getSign()*newKeys[index-1]);
+	  SP->setKey(0);
+	}
+      else
+	{
+	  // single leaf rules [CompGrp/ContGrp] return A for both
+	  Rule* APtr=headPtr->leaf(0);
+	  Rule* BPtr=headPtr->leaf(1);
+	  if (APtr)
+	    TreeLine.push(APtr);
+	  if (BPtr && BPtr!=APtr)
+	    TreeLine.push(BPtr);
+	}
+    }
+  return;
+}
+
 void
 HeadRule::makeComplement()
   /*!
@@ -1720,6 +1764,62 @@ HeadRule::addUnion(const Rule* RPtr)
   return *this;
 }
 
+HeadRule&
+HeadRule::addTopIntersection(const HeadRule& AHead) 
+  /*!
+    Add a rule as an intersection with the whole of this rule.
+    The tree is not searched [unlike addIntersection] so the cost
+    only depends on the size of AHead and the rule is 
+    written in the same order as "this AHead".
+    \param AHead :: Other head rule
+    \return Joined HeadRule
+  */
+{
+  if (AHead.HeadNode)
+    {
+      if (!HeadNode)
+	HeadNode=AHead.HeadNode->clone();
+      else
+	HeadNode=new Intersection(0,HeadNode,AHead.HeadNode->clone());
+    }
+  return *this;
+}
+
+HeadRule&
+HeadRule::addTopIntersection(const std::vector<HeadRule>& AVec) 
+  /*!
+    Add a set of rules as an intersection with the whole of this rule.
+    The added rules are joined pairwise first so that the new
+    part of the tree has log(N) depth.
+    \param AVec :: Rules to add [in order]
+    \return Joined HeadRule
+  */
+{
+  ELog::RegMethod RegA("HeadRule","addTopIntersection(vec)");
+
+  std::vector<Rule*> RVec;
+  for(const HeadRule& AHead : AVec)
+    if (AHead.HeadNode)
+      RVec.push_back(AHead.HeadNode->clone());
+
+  while(RVec.size()>1)
+    {
+      size_t index(0);
+      for(size_t i=0;i+1<RVec.size();i+=2)
+	RVec[index++]=new Intersection(0,RVec[i],RVec[i+1]);
+      if (RVec.size() % 2)
+	RVec[index++]=RVec.back();
+      RVec.resize(index);
+    }
+
+  if (!RVec.empty())
+    {
+      HeadNode=(HeadNode) ?
+	new Intersection(0,HeadNode,RVec.front()) : RVec.front();
+    }
+  return *this;
+}
+
 void
 HeadRule::createAddition(const int InterFlag,const Rule* NRptr)
   /*!
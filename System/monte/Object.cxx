@@ -58,6 +58,8 @@
 #include "surfImplicates.h"
 #include "Rules.h"
 #include "HeadRule.h"
+#include "RuleProgram.h"
+#include "RuleBox.h"
 #include "Token.h"
 #include "particle.h"
 #include "objectRegister.h"
@@ -92,7 +94,8 @@ Object::Object() :
   ObjName(0),listNum(-1),Tmp(300.0),
   matPtr(ModelSupport::DBMaterial::Instance().getVoidPtr()),
   trcl(0),imp(1),populated(0),
-  activeMag(0),objSurfValid(0)
+  activeMag(0),progPtr(0),boxValid(0),vertexValid(0),objSurfValid(0),
+  surfListValid(0)
    /*!
      Defaut constuctor, set temperature to 300C and material to vacuum
    */
@@ -102,7 +105,9 @@ Object::Object(const int N,const int M,
 	       const double T,const std::string& Line) :
   ObjName(N),listNum(-1),Tmp(T),
   matPtr(ModelSupport::DBMaterial::Instance().getMaterialPtr(M)),
-  trcl(0),imp(1),populated(0),activeMag(0),objSurfValid(0)
+  trcl(0),imp(1),populated(0),activeMag(0),
+  progPtr(0),boxValid(0),vertexValid(0),objSurfValid(0),
+  surfListValid(0)
  /*!
    Constuctor, set temperature to 300C 
    \param N :: number
@@ -118,7 +123,9 @@ Object::Object(const std::string& FCName,const int N,const int M,
 	       const double T,const std::string& Line) :
   FCUnit(FCName),ObjName(N),listNum(-1),Tmp(T),
   matPtr(ModelSupport::DBMaterial::Instance().getMaterialPtr(M)),
-  trcl(0),imp(1),populated(0),activeMag(0),objSurfValid(0)
+  trcl(0),imp(1),populated(0),activeMag(0),
+  progPtr(0),boxValid(0),vertexValid(0),objSurfValid(0),
+  surfListValid(0)
  /*!
    Constuctor, set temperature to 300C 
    \param N :: number
@@ -135,7 +142,11 @@ Object::Object(const Object& A) :
   listNum(A.listNum),Tmp(A.Tmp),matPtr(A.matPtr),
   trcl(A.trcl),imp(A.imp),populated(A.populated),
   activeMag(A.activeMag),magVec(A.magVec),
-  HRule(A.HRule),objSurfValid(0),SurList(A.SurList),SurSet(A.SurSet)
+  HRule(A.HRule),
+  progPtr((A.progPtr) ? new RuleProgram(*A.progPtr) : 0),
+  boxValid(A.boxValid),boxLow(A.boxLow),boxHigh(A.boxHigh),
+  vertexValid(A.vertexValid),vertexPts(A.vertexPts),
+  objSurfValid(0),surfListValid(0),SurList(A.SurList),SurSet(A.SurSet)
   /*!
     Copy constructor
     \param A :: Object to copy
@@ -163,7 +174,16 @@ Object::operator=(const Object& A)
       activeMag=A.activeMag;
       magVec=A.magVec;
       HRule=A.HRule;
+      clearProgram();
+      if (A.progPtr)
+	progPtr=new RuleProgram(*A.progPtr);
+      boxValid=A.boxValid;
+      boxLow=A.boxLow;
+      boxHigh=A.boxHigh;
+      vertexValid=A.vertexValid;
+      vertexPts=A.vertexPts;
       objSurfValid=0;
+      surfListValid=0;
       SurList=A.SurList;
       SurSet=A.SurSet;
     }
@@ -174,7 +194,9 @@ Object::~Object()
   /*!
     Delete operator : removes Object tree
   */
-{}
+{
+  delete progPtr;
+}
 
 Object*
 Object::clone() const 
@@ -262,6 +284,7 @@ Object::complementaryObject(const int Cnum,std::string& Ln)
   std::string Part=Ln.substr(posA,posB-(posA+1));
 
   ObjName=Cnum;
+  clearCache();
   if (!HRule.procString(Part))
     throw ColErr::InvalidLine(0,Part);
 
@@ -350,6 +373,7 @@ Object::setObject(std::string Ln)
                    [](char c) { return std::isalpha(c); }) != Ln.end())
     ColErr::InvalidLine("Junk letters in line ",Ln);
 
+  clearCache();
   if (!HRule.procString(Ln))   // fails on empty
     throw ColErr::InvalidLine("procString failure :: ",Ln);
 
@@ -373,6 +397,7 @@ Object::procString(const std::string& cellStr)
 {
   populated=0;
   objSurfValid=0;
+  clearCache();
   return HRule.procString(cellStr);
 }
 
@@ -385,6 +410,7 @@ Object::procHeadRule(const HeadRule& cellRule)
    */
 {
   populated=0;
+  clearCache();
   HRule=cellRule;
   return 1;
 }
@@ -410,6 +436,7 @@ Object::setObject(const int N,const int matNum,
   for(const Token& tItem : TVec)
     tItem.write(cx);
 
+  clearCache();
   if (!HRule.procString(cx.str()))
     throw ColErr::InvalidLine("Token string",cx.str());
 
@@ -431,9 +458,12 @@ Object::populate()
 
   if (!populated) 
     {
+      clearCache();
       HRule.populateSurf();
       populated=1;
     }
+  if (!progPtr)
+    buildProgram();
   return;
 }
 
@@ -448,11 +478,154 @@ Object::rePopulate()
   */
 {
   ELog::RegMethod RegA("Object","rePopulate");
+  clearCache();
   HRule.populateSurf();
   populated=1;
+  buildProgram();
+  return;
+}
+
+void
+Object::buildProgram()
+  /*!
+    Compile the populated HRule into a flat program
+    for the point tests. Left null if the rule cannot
+    be compiled [HRule is then used directly]
+  */
+{
+  ELog::RegMethod RegA("Object","buildProgram");
+
+  clearProgram();
+  RuleProgram* RP=new RuleProgram;
+  if (RP->compile(HRule.getTopRule()))
+    progPtr=RP;
+  else
+    delete RP;
+  return;
+}
+
+void
+Object::clearProgram()
+  /*!
+    Remove the compiled program
+  */
+{
+  delete progPtr;
+  progPtr=0;
+  return;
+}
+
+void
+Object::clearGeomCache()
+  /*!
+    Remove the compiled program, the bounding box and
+    the vertex points. Used when the surfaces of the
+    object have been moved in place.
+  */
+{
+  clearProgram();
+  boxValid=0;
+  vertexValid=0;
+  vertexPts.clear();
+  return;
+}
+
+void
+Object::clearCache()
+  /*!
+    Remove the compiled program, the bounding box,
+    the vertex points and the surface list [HRule or
+    surface pointers changed]
+  */
+{
+  clearGeomCache();
+  surfListValid=0;
+  return;
+}
+
+void
+Object::displace(const Geometry::Vec3D&)
+  /*!
+    The surfaces of the object have been displaced
+    [the surfaces are moved directly]
+  */
+{
+  clearGeomCache();
+  return;
+}
+
+void
+Object::rotate(const Geometry::Matrix<double>&)
+  /*!
+    The surfaces of the object have been rotated
+    [the surfaces are moved directly]
+  */
+{
+  clearGeomCache();
+  return;
+}
+
+void
+Object::mirror(const Geometry::Plane&)
+  /*!
+    The surfaces of the object have been mirrored
+    [the surfaces are moved directly]
+  */
+{
+  clearGeomCache();
+  return;
+}
+
+void
+Object::getBoundBox(Geometry::Vec3D& LPt,Geometry::Vec3D& HPt) const
+  /*!
+    Get a conservative axis-aligned box of the object
+    [RuleBox]. Unbounded directions are +/- RuleBox::maxExtent.
+    It is calculated on the first call after the rule
+    changes: that call must not be made by several threads
+    at once [ObjSurfMap::buildIndex calculates all the boxes].
+    \param LPt :: Low point
+    \param HPt :: High point
+  */
+{
+  if (!boxValid)
+    {
+      RuleBox::calcBoundBox(HRule,boxLow,boxHigh);
+      boxValid=1;
+    }
+  LPt=boxLow;
+  HPt=boxHigh;
+  return;
+}
+
+void
+Object::setVertexPoints(const std::vector<Geometry::Vec3D>& VPts) const
+  /*!
+    Keep the vertex points until the rule changes
+    \param VPts :: Vertex points
+  */
+{
+  vertexPts=VPts;
+  vertexValid=1;
   return;
 }
 
+bool
+Object::outsideBox(const Geometry::Vec3D& Pt) const
+  /*!
+    Determine if a point is outside the bounding box
+    [only if the box has already been calculated]
+    \param Pt :: Point to test
+    \return true if outside the box
+  */
+{
+  if (!boxValid) return 0;
+  for(size_t i=0;i<3;i++)
+    if (Pt[i]<boxLow[i] || Pt[i]>boxHigh[i])
+      return 1;
+  return 0;
+}
+
 int
 Object::addSurfString(const std::string& XE)
   /*!
@@ -477,6 +650,50 @@ Object::addSurfString(const std::string& XE)
   return flag;
 }
 
+int
+Object::addIntersection(const HeadRule& XHead)
+  /*!
+    Adds a rule as an intersection with the cell [at the top level].
+    This is the structured form of addSurfString and the
+    cost only depends on the size of XHead.
+    \param XHead :: Rule to add
+    \retval 1 on success
+  */
+{
+  ELog::RegMethod RegA("Object","addIntersection");
+
+  if (XHead.hasRule())
+    {
+      clearCache();
+      HRule.addTopIntersection(XHead);
+      SurList.clear();
+      SurSet.erase(SurSet.begin(),SurSet.end());
+      populated=0;
+      objSurfValid=0;
+    }
+  return 1;
+}
+
+int
+Object::addIntersection(const std::vector<HeadRule>& XVec)
+  /*!
+    Adds all the pending rules as intersections with the cell in
+    one step. 
+    \param XVec :: Rules to add [in order]
+    \retval 1 on success
+  */
+{
+  ELog::RegMethod RegA("Object","addIntersection(vec)");
+
+  clearCache();
+  HRule.addTopIntersection(XVec);
+  SurList.clear();
+  SurSet.erase(SurSet.begin(),SurSet.end());
+  populated=0;
+  objSurfValid=0;
+  return 1;
+}
+
 void
 Object::setMagField(const Geometry::Vec3D& M)
   /*!
@@ -599,7 +816,26 @@ Object::isValid(const Geometry::Vec3D& Pt) const
   \returns 1 if true and 0 if false
 */
 {
-  return HRule.isValid(Pt);
+  return (progPtr) ? progPtr->isValid(Pt) : HRule.isValid(Pt);
+}
+
+void
+Object::isValidBlock(const Geometry::Vec3D* Pts,const size_t N,
+		     char* Out) const
+/*! 
+  Determines if each point is within the object 
+  or on the surface
+  \param Pts :: Points to be tested
+  \param N :: Number of points
+  \param Out :: 1 if true and 0 if false (size N)
+*/
+{
+  if (progPtr)
+    progPtr->isValidBlock(Pts,N,Out);
+  else
+    for(size_t i=0;i<N;i++)
+      Out[i]=static_cast<char>(HRule.isValid(Pts[i]));
+  return;
 }
 
 int
@@ -613,7 +849,8 @@ Object::isValid(const Geometry::Vec3D& Pt,
     \returns 1 if true and 0 if false
   */
 {
-  return HRule.isValid(Pt,ExSN);
+  return (progPtr) ?
+    progPtr->isValid(Pt,ExSN) : HRule.isValid(Pt,ExSN);
 }
 
 int
@@ -627,7 +864,8 @@ Object::isDirectionValid(const Geometry::Vec3D& Pt,
   \returns 1 if true and 0 if false
 */
 {
-  return HRule.isDirectionValid(Pt,ExSN);
+  return (progPtr) ?
+    progPtr->isDirectionValid(Pt,ExSN) : HRule.isDirectionValid(Pt,ExSN);
 }
 
 
@@ -827,9 +1065,23 @@ Object::createSurfaceList()
     }
 
   createLogicOpp();
+  surfListValid=1;
   return 1;
 }
 
+void
+Object::updateSurfaceList()
+  /*!
+    Populate and create the surface list only if the
+    rule has changed since the last createSurfaceList
+  */
+{
+  populate();
+  if (!surfListValid)
+    createSurfaceList();
+  return;
+}
+
 bool
 Object::isVoid() const
   /*!
@@ -908,6 +1160,7 @@ Object::removeSurface(const int SurfN)
   const int cnt=HRule.removeItems(SurfN);
   if (cnt>0)
     {
+      clearCache();
       createSurfaceList();
       objSurfValid=0;
     }
@@ -935,6 +1188,7 @@ Object::substituteSurf(const int SurfN,const int NsurfN,
   if ( out )
     {
       populated=0;
+      clearCache();
       populate();
       createSurfaceList();
     }
@@ -1103,9 +1357,10 @@ Object::trackCell(const MonteCarlo::particle& N,double& D,
   for(size_t i=0;i<dPts.size();i++)
     {
       // Is point possible closer
+      // points outside the box are not on the cell boundary
       if ( ( surfIndex[i]->getName()!=startSurf || 
 	     dPts[i]>10.0*Geometry::zeroTol) &&
-	   (dPts[i]>0.0 && dPts[i]<D) )
+	   (dPts[i]>0.0 && dPts[i]<D) && !outsideBox(IPts[i]) )
 	{
 	  const int NS=surfIndex[i]->getName();	    // NOT SIGNED
 	  const int pAB=isDirectionValid(IPts[i],NS);
@@ -1208,6 +1463,8 @@ Object::makeComplement()
     Takes the complement of a group
    */
 {
+  populated=0;
+  clearCache();
   HRule.makeComplement();
   return;
 }
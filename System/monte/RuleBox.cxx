@@ -0,0 +1,311 @@
+/*********************************************************************
+  CombLayer : MCNP(X) Input builder
+
+ * File:   monte/RuleBox.cxx
+ *
+ * Copyright (c) 2004-2019 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ****************************************************************************/
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <cmath>
+#include <complex>
+#include <vector>
+#include <set>
+#include <map>
+#include <string>
+#include <algorithm>
+#include <memory>
+
+#include "Exception.h"
+#include "FileReport.h"
+#include "NameStack.h"
+#include "RegMethod.h"
+#include "GTKreport.h"
+#include "OutputLog.h"
+#include "BaseVisit.h"
+#include "BaseModVisit.h"
+#include "MatrixBase.h"
+#include "Matrix.h"
+#include "Vec3D.h"
+#include "Surface.h"
+#include "Quadratic.h"
+#include "Plane.h"
+#include "Cylinder.h"
+#include "Sphere.h"
+#include "Rules.h"
+#include "HeadRule.h"
+#include "RuleBox.h"
+
+namespace RuleBox
+{
+
+/// Half-space (Normal.x >= D)
+typedef std::pair<Geometry::Vec3D,double> HTYPE;
+
+static void ruleBox(const Rule*,Geometry::Vec3D&,Geometry::Vec3D&);
+
+static void
+addSurfHalf(const Rule* RPtr,std::vector<HTYPE>& HVec)
+  /*!
+    Add the half-spaces that bound a signed surface.
+    Only planes, cylinders and spheres are used: all other
+    surfaces are unbounded [which is always conservative].
+    Cylinders/spheres are replaced by their enclosing prism/cube.
+    \param RPtr :: SurfPoint rule
+    \param HVec :: Half-spaces to add to
+  */
+{
+  const SurfPoint* SPtr=dynamic_cast<const SurfPoint*>(RPtr);
+  if (!SPtr || !SPtr->getKey()) return;
+
+  const Geometry::Surface* SurfPtr=SPtr->getKey();
+  const int sign=SPtr->getSign();
+
+  const Geometry::Plane* PPtr=
+    dynamic_cast<const Geometry::Plane*>(SurfPtr);
+  if (PPtr)
+    {
+      if (sign>0)
+	HVec.push_back(HTYPE(PPtr->getNormal(),PPtr->getDistance()));
+      else
+	HVec.push_back(HTYPE(-PPtr->getNormal(),-PPtr->getDistance()));
+      return;
+    }
+  // Only the inside of closed surfaces bounds anything
+  if (sign>0) return;
+
+  const Geometry::Cylinder* CPtr=
+    dynamic_cast<const Geometry::Cylinder*>(SurfPtr);
+  if (CPtr)
+    {
+      const Geometry::Vec3D& Axis=CPtr->getNormal();
+      const Geometry::Vec3D& C=CPtr->getCentre();
+      const double R=CPtr->getRadius();
+      // perpendicular from the smallest component of the axis
+      const size_t index=
+	(std::abs(Axis[0])<std::abs(Axis[1])) ?
+	((std::abs(Axis[0])<std::abs(Axis[2])) ? 0 : 2) :
+	((std::abs(Axis[1])<std::abs(Axis[2])) ? 1 : 2);
+      Geometry::Vec3D AX;
+      AX[index]=1.0;
+      const Geometry::Vec3D U=(Axis*AX).unit();
+      const Geometry::Vec3D V=(Axis*U).unit();
+      HVec.push_back(HTYPE(U,U.dotProd(C)-R));
+      HVec.push_back(HTYPE(-U,-U.dotProd(C)-R));
+      HVec.push_back(HTYPE(V,V.dotProd(C)-R));
+      HVec.push_back(HTYPE(-V,-V.dotProd(C)-R));
+      return;
+    }
+
+  const Geometry::Sphere* SphPtr=
+    dynamic_cast<const Geometry::Sphere*>(SurfPtr);
+  if (SphPtr)
+    {
+      const Geometry::Vec3D& C=SphPtr->getCentre();
+      const double R=SphPtr->getRadius();
+      for(size_t i=0;i<3;i++)
+	{
+	  Geometry::Vec3D AX;
+	  AX[i]=1.0;
+	  HVec.push_back(HTYPE(AX,C[i]-R));
+	  HVec.push_back(HTYPE(-AX,-C[i]-R));
+	}
+    }
+  return;
+}
+
+static void
+collectHalf(const Rule* RPtr,std::vector<HTYPE>& HVec)
+  /*!
+    Collect all the half-spaces of an intersection chain.
+    Union sub-rules are replaced by the six planes of their box.
+    Complements/objects add nothing.
+    \param RPtr :: Rule to process
+    \param HVec :: Half-spaces
+  */
+{
+  if (!RPtr) return;
+
+  const int type=RPtr->type();
+  if (type==1)
+    {
+      collectHalf(RPtr->leaf(0),HVec);
+      collectHalf(RPtr->leaf(1),HVec);
+    }
+  else if (type==-1)
+    {
+      Geometry::Vec3D LPt,HPt;
+      ruleBox(RPtr,LPt,HPt);
+      for(size_t i=0;i<3;i++)
+	{
+	  Geometry::Vec3D AX;
+	  AX[i]=1.0;
+	  if (LPt[i]> -maxExtent)
+	    HVec.push_back(HTYPE(AX,LPt[i]));
+	  if (HPt[i]< maxExtent)
+	    HVec.push_back(HTYPE(-AX,-HPt[i]));
+	}
+    }
+  else if (!RPtr->isComplementary())
+    addSurfHalf(RPtr,HVec);
+  return;
+}
+
+static void
+polyBox(std::vector<HTYPE>& HVec,
+	Geometry::Vec3D& LPt,Geometry::Vec3D& HPt)
+  /*!
+    Calculate the box of the convex region of half-spaces
+    by enumeration of the vertices. The world box is added
+    so that unbounded directions reach maxExtent.
+    Only the first few half-spaces are used for very
+    large sets : this is conservative.
+    \param HVec :: Half-spaces [modified]
+    \param LPt :: Low point
+    \param HPt :: High point
+  */
+{
+  const size_t maxPlanes(24);
+  if (HVec.size()>maxPlanes)
+    HVec.resize(maxPlanes);
+
+  for(size_t i=0;i<3;i++)
+    {
+      Geometry::Vec3D AX;
+      AX[i]=1.0;
+      HVec.push_back(HTYPE(AX,-maxExtent));
+      HVec.push_back(HTYPE(-AX,-maxExtent));
+    }
+
+  bool found(0);
+  Geometry::Vec3D LowV(maxExtent,maxExtent,maxExtent);
+  Geometry::Vec3D HighV(-maxExtent,-maxExtent,-maxExtent);
+
+  const size_t NH(HVec.size());
+  for(size_t i=0;i<NH;i++)
+    for(size_t j=i+1;j<NH;j++)
+      {
+	const Geometry::Vec3D IJ=HVec[i].first*HVec[j].first;
+	if (IJ.abs()<Geometry::zeroTol) continue;
+	for(size_t k=j+1;k<NH;k++)
+	  {
+	    const Geometry::Vec3D& NA(HVec[i].first);
+	    const Geometry::Vec3D& NB(HVec[j].first);
+	    const Geometry::Vec3D& NC(HVec[k].first);
+	    const double det=NC.dotProd(IJ);
+	    if (std::abs(det)<Geometry::zeroTol) continue;
+
+	    const Geometry::Vec3D Pt=
+	      ((NB*NC)*HVec[i].second+(NC*NA)*HVec[j].second+
+	       IJ*HVec[k].second)/det;
+	    bool valid(1);
+	    for(const HTYPE& HS : HVec)
+	      if (HS.first.dotProd(Pt) <
+		  HS.second-1e-7*(1.0+std::abs(HS.second)))
+		{
+		  valid=0;
+		  break;
+		}
+	    if (valid)
+	      {
+		found=1;
+		for(size_t index=0;index<3;index++)
+		  {
+		    LowV[index]=std::min(LowV[index],Pt[index]);
+		    HighV[index]=std::max(HighV[index],Pt[index]);
+		  }
+	      }
+	  }
+      }
+  if (!found)
+    {
+      LPt=Geometry::Vec3D(-maxExtent,-maxExtent,-maxExtent);
+      HPt=Geometry::Vec3D(maxExtent,maxExtent,maxExtent);
+      return;
+    }
+  for(size_t index=0;index<3;index++)
+    {
+      const double pad=Geometry::shiftTol+1e-9*
+	std::max(std::abs(LowV[index]),std::abs(HighV[index]));
+      LPt[index]=(LowV[index]<=-0.5*maxExtent) ?
+	-maxExtent : LowV[index]-pad;
+      HPt[index]=(HighV[index]>=0.5*maxExtent) ?
+	maxExtent : HighV[index]+pad;
+    }
+  return;
+}
+
+static void
+ruleBox(const Rule* RPtr,
+	Geometry::Vec3D& LPt,Geometry::Vec3D& HPt)
+  /*!
+    Calculate a conservative box for a rule
+    \param RPtr :: Rule
+    \param LPt :: Low point
+    \param HPt :: High point
+  */
+{
+  if (RPtr && RPtr->type()==-1)
+    {
+      Geometry::Vec3D LB,HB;
+      ruleBox(RPtr->leaf(0),LPt,HPt);
+      ruleBox(RPtr->leaf(1),LB,HB);
+      for(size_t i=0;i<3;i++)
+	{
+	  LPt[i]=std::min(LPt[i],LB[i]);
+	  HPt[i]=std::max(HPt[i],HB[i]);
+	}
+      return;
+    }
+  std::vector<HTYPE> HVec;
+  collectHalf(RPtr,HVec);
+  polyBox(HVec,LPt,HPt);
+  return;
+}
+
+void
+calcBoundBox(const HeadRule& HR,
+	     Geometry::Vec3D& LPt,Geometry::Vec3D& HPt)
+  /*!
+    Calculate a conservative axis-aligned box of the rule.
+    Unbounded directions are set to +/- maxExtent
+    \param HR :: Populated head rule
+    \param LPt :: Low point
+    \param HPt :: High point
+  */
+{
+  ruleBox(HR.getTopRule(),LPt,HPt);
+  return;
+}
+
+bool
+isBounded(const Geometry::Vec3D& LPt,const Geometry::Vec3D& HPt)
+  /*!
+    Determine if a box is finite in all directions
+    \param LPt :: Low point
+    \param HPt :: High point
+    \return true if box is finite
+  */
+{
+  for(size_t i=0;i<3;i++)
+    if (LPt[i]<= -maxExtent || HPt[i]>=maxExtent)
+      return 0;
+  return 1;
+}
+
+} // NAMESPACE RuleBox
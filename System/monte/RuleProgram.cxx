@@ -0,0 +1,432 @@
+/*********************************************************************
+  CombLayer : MCNP(X) Input builder
+
+ * File:   monte/RuleProgram.cxx
+ *
+ * Copyright (c) 2004-2019 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ****************************************************************************/
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <cmath>
+#include <complex>
+#include <vector>
+#include <set>
+#include <map>
+#include <string>
+#include <algorithm>
+#include <limits>
+#include <typeinfo>
+#include <cstring>
+
+#include "Exception.h"
+#include "FileReport.h"
+#include "NameStack.h"
+#include "RegMethod.h"
+#include "GTKreport.h"
+#include "OutputLog.h"
+#include "BaseVisit.h"
+#include "BaseModVisit.h"
+#include "MatrixBase.h"
+#include "Matrix.h"
+#include "Vec3D.h"
+#include "Surface.h"
+#include "Quadratic.h"
+#include "Plane.h"
+#include "Cylinder.h"
+#include "Sphere.h"
+#include "Rules.h"
+#include "HeadRule.h"
+#include "Object.h"
+#include "RuleProgram.h"
+
+const size_t RuleProgram::acceptIndex(std::numeric_limits<size_t>::max());
+const size_t RuleProgram::rejectIndex(std::numeric_limits<size_t>::max()-1);
+
+RuleProgram::RuleProgram() :
+  active(0),startIndex(rejectIndex)
+  /*!
+    Constructor
+  */
+{}
+
+RuleProgram::RuleProgram(const RuleProgram& A) :
+  active(A.active),startIndex(A.startIndex),Prog(A.Prog)
+  /*!
+    Copy constructor
+    \param A :: RuleProgram to copy
+  */
+{}
+
+RuleProgram&
+RuleProgram::operator=(const RuleProgram& A)
+  /*!
+    Assignment operator
+    \param A :: RuleProgram to copy
+    \return *this
+  */
+{
+  if (this!=&A)
+    {
+      active=A.active;
+      startIndex=A.startIndex;
+      Prog=A.Prog;
+    }
+  return *this;
+}
+
+void
+RuleProgram::clear()
+  /*!
+    Remove the program
+  */
+{
+  active=0;
+  startIndex=rejectIndex;
+  Prog.clear();
+  return;
+}
+
+size_t
+RuleProgram::addSurfItem(const Rule* RPtr,
+			 const size_t trueIndex,const size_t falseIndex,
+			 std::map<const Geometry::Surface*,size_t>& cacheMap)
+  /*!
+    Add a surface/object leaf
+    \param RPtr :: Leaf rule
+    \param trueIndex :: Jump if true
+    \param falseIndex :: Jump if false
+    \param cacheMap :: Surface to cache index
+    \return index of the item / acceptIndex+1 on failure
+  */
+{
+  progItem PI;
+  PI.keyN=0;
+  PI.sign=1;
+  PI.surf=0;
+  PI.obj=0;
+  PI.cacheIndex=maxCache;
+  PI.onTrue=trueIndex;
+  PI.onFalse=falseIndex;
+
+  const SurfPoint* SPtr=dynamic_cast<const SurfPoint*>(RPtr);
+  if (SPtr)
+    {
+      const Geometry::Surface* surfPtr=SPtr->getKey();
+      // unpopulated surface is always false
+      if (!surfPtr) return falseIndex;
+
+      PI.keyN=SPtr->getKeyN();
+      PI.sign=SPtr->getSign();
+      PI.surf=surfPtr;
+      if (typeid(*surfPtr)==typeid(Geometry::Plane))
+	PI.type=progType::Plane;
+      else if (typeid(*surfPtr)==typeid(Geometry::Cylinder))
+	PI.type=progType::Cylinder;
+      else if (typeid(*surfPtr)==typeid(Geometry::Sphere))
+	PI.type=progType::Sphere;
+      else
+	PI.type=progType::Surf;
+
+      std::map<const Geometry::Surface*,size_t>::const_iterator mc=
+	cacheMap.find(surfPtr);
+      if (mc!=cacheMap.end())
+	PI.cacheIndex=mc->second;
+      else if (cacheMap.size()<maxCache)
+	{
+	  PI.cacheIndex=cacheMap.size();
+	  cacheMap.emplace(surfPtr,PI.cacheIndex);
+	}
+      Prog.push_back(PI);
+      return Prog.size()-1;
+    }
+
+  const CompObj* CPtr=dynamic_cast<const CompObj*>(RPtr);
+  if (CPtr)
+    {
+      if (!CPtr->getObj()) return trueIndex;
+      PI.type=progType::Obj;
+      PI.obj=CPtr->getObj();
+      PI.onTrue=falseIndex;
+      PI.onFalse=trueIndex;
+      Prog.push_back(PI);
+      return Prog.size()-1;
+    }
+
+  const ContObj* COPtr=dynamic_cast<const ContObj*>(RPtr);
+  if (COPtr)
+    {
+      if (!COPtr->getObj()) return falseIndex;
+      PI.type=progType::Obj;
+      PI.obj=COPtr->getObj();
+      Prog.push_back(PI);
+      return Prog.size()-1;
+    }
+
+  const BoolValue* BPtr=dynamic_cast<const BoolValue*>(RPtr);
+  if (BPtr)
+    return (BPtr->isValid(Geometry::Vec3D())) ? trueIndex : falseIndex;
+
+  active=0;
+  return falseIndex;
+}
+
+size_t
+RuleProgram::compileRule(const Rule* RPtr,
+			 const size_t trueIndex,const size_t falseIndex,
+			 std::map<const Geometry::Surface*,size_t>& cacheMap)
+  /*!
+    Compile a rule into the program. The second leaf is compiled
+    first so that its entry point is known for the first leaf
+    \param RPtr :: Rule to compile
+    \param trueIndex :: Jump if true
+    \param falseIndex :: Jump if false
+    \param cacheMap :: Surface to cache index
+    \return entry point of the rule
+  */
+{
+  // null rules are always false
+  if (!RPtr) return falseIndex;
+
+  if (dynamic_cast<const Intersection*>(RPtr))
+    {
+      const size_t BIndex=
+	compileRule(RPtr->leaf(1),trueIndex,falseIndex,cacheMap);
+      return compileRule(RPtr->leaf(0),BIndex,falseIndex,cacheMap);
+    }
+  if (dynamic_cast<const Union*>(RPtr))
+    {
+      const size_t BIndex=
+	compileRule(RPtr->leaf(1),trueIndex,falseIndex,cacheMap);
+      return compileRule(RPtr->leaf(0),trueIndex,BIndex,cacheMap);
+    }
+  if (dynamic_cast<const CompGrp*>(RPtr))
+    return compileRule(RPtr->leaf(0),falseIndex,trueIndex,cacheMap);
+  if (dynamic_cast<const ContGrp*>(RPtr))
+    return compileRule(RPtr->leaf(0),trueIndex,falseIndex,cacheMap);
+
+  return addSurfItem(RPtr,trueIndex,falseIndex,cacheMap);
+}
+
+bool
+RuleProgram::compile(const Rule* TopRule)
+  /*!
+    Build the program from the rule [must be populated]
+    \param TopRule :: Rule to compile
+    \return true if the program can be used
+  */
+{
+  ELog::RegMethod RegA("RuleProgram","compile");
+
+  clear();
+  if (!TopRule) return 0;
+
+  active=1;
+  std::map<const Geometry::Surface*,size_t> cacheMap;
+  startIndex=compileRule(TopRule,acceptIndex,rejectIndex,cacheMap);
+  if (!active)
+    clear();
+  return active;
+}
+
+int
+RuleProgram::surfSide(const progItem& PI,const Geometry::Vec3D& Pt) const
+  /*!
+    Side of the surface without the virtual call for
+    the common surfaces
+    \param PI :: Program item
+    \param Pt :: Point to test
+    \return side of the surface [-1/0/1]
+  */
+{
+  switch (PI.type)
+    {
+    case progType::Plane:
+      return static_cast<const Geometry::Plane*>(PI.surf)->
+	Geometry::Plane::side(Pt);
+    case progType::Cylinder:
+      return static_cast<const Geometry::Cylinder*>(PI.surf)->
+	Geometry::Cylinder::side(Pt);
+    case progType::Sphere:
+      return static_cast<const Geometry::Sphere*>(PI.surf)->
+	Geometry::Sphere::side(Pt);
+    default:
+      break;
+    }
+  return PI.surf->side(Pt);
+}
+
+bool
+RuleProgram::evaluate(const Geometry::Vec3D& Pt,
+		      const int ExSN,const int mode) const
+  /*!
+    Run the program
+    \param Pt :: Point to test
+    \param ExSN :: Surface number to exclude
+    \param mode :: 0 : no exclude / 1 : ExSN true / 2 : ExSN signed
+    \return true if valid
+  */
+{
+  // side+2 for each cached surface [0 is unknown]
+  signed char sideCache[maxCache];
+  std::memset(sideCache,0,sizeof(sideCache));
+
+  const int absExSN((ExSN>0) ? ExSN : -ExSN);
+  const size_t NProg(Prog.size());
+  size_t index(startIndex);
+  while(index<NProg)
+    {
+      const progItem& PI(Prog[index]);
+      bool flag;
+      if (PI.type==progType::Obj)
+	{
+	  if (mode==1)
+	    flag=PI.obj->isValid(Pt,ExSN);
+	  else if (mode==2)
+	    flag=PI.obj->isDirectionValid(Pt,ExSN);
+	  else
+	    flag=PI.obj->isValid(Pt);
+	}
+      else if (mode && PI.keyN==absExSN)
+	flag=(mode==1 || PI.sign*ExSN>0);
+      else if (PI.cacheIndex<maxCache)
+	{
+	  signed char& SC(sideCache[PI.cacheIndex]);
+	  if (!SC)
+	    SC=static_cast<signed char>(surfSide(PI,Pt)+2);
+	  flag=((SC-2)*PI.sign>=0);
+	}
+      else
+	flag=(surfSide(PI,Pt)*PI.sign>=0);
+
+      index=(flag) ? PI.onTrue : PI.onFalse;
+    }
+  return (index==acceptIndex);
+}
+
+bool
+RuleProgram::isValid(const Geometry::Vec3D& Pt) const
+  /*!
+    Determines if Pt is within the rule or on the surface
+    \param Pt :: Point to be tested
+    \return true if valid
+  */
+{
+  return evaluate(Pt,0,0);
+}
+
+bool
+RuleProgram::isValid(const Geometry::Vec3D& Pt,const int ExSN) const
+  /*!
+    Determines if Pt is within the rule or on the surface
+    \param Pt :: Point to be tested
+    \param ExSN :: Excluded surf Number [unsigned]
+    \return true if valid
+  */
+{
+  return evaluate(Pt,ExSN,1);
+}
+
+bool
+RuleProgram::isDirectionValid(const Geometry::Vec3D& Pt,
+			      const int ExSN) const
+  /*!
+    Determines if Pt is within the rule or on the surface
+    \param Pt :: Point to be tested
+    \param ExSN :: Excluded surf Number [signed]
+    \return true if valid
+  */
+{
+  return evaluate(Pt,ExSN,2);
+}
+
+void
+RuleProgram::isValidBlock(const Geometry::Vec3D* Pts,const size_t N,
+			  char* Out) const
+  /*!
+    Determines if each point is within the rule or on the surface.
+    The points are run in blocks: the first time a cached surface
+    is needed in a block its side is found for the rest of the
+    block in one call [Surface::sideBlock]. 
+    \param Pts :: Points to be tested
+    \param N :: Number of points
+    \param Out :: valid flag of each point (size N)
+  */
+{
+  // side of each cached surface for the points in the block
+  signed char sideCache[maxCache][blockSize];
+  bool filled[maxCache];
+
+  const size_t NProg(Prog.size());
+  for(size_t iStart=0;iStart<N;iStart+=blockSize)
+    {
+      const size_t NB=std::min(blockSize,N-iStart);
+      const Geometry::Vec3D* PB(Pts+iStart);
+      std::memset(filled,0,sizeof(filled));
+      for(size_t i=0;i<NB;i++)
+	{
+	  size_t index(startIndex);
+	  while(index<NProg)
+	    {
+	      const progItem& PI(Prog[index]);
+	      bool flag;
+	      if (PI.type==progType::Obj)
+		flag=PI.obj->isValid(PB[i]);
+	      else if (PI.cacheIndex<maxCache)
+		{
+		  signed char* SC(sideCache[PI.cacheIndex]);
+		  if (!filled[PI.cacheIndex])
+		    {
+		      PI.surf->sideBlock(PB+i,NB-i,SC+i);
+		      filled[PI.cacheIndex]=1;
+		    }
+		  flag=(SC[i]*PI.sign>=0);
+		}
+	      else
+		flag=(surfSide(PI,PB[i])*PI.sign>=0);
+	      
+	      index=(flag) ? PI.onTrue : PI.onFalse;
+	    }
+	  Out[iStart+i]=(index==acceptIndex);
+	}
+    }
+  return;
+}
+
+void
+RuleProgram::write(std::ostream& OX) const
+  /*!
+    Write out the program [debug]
+    \param OX :: Output stream
+  */
+{
+  OX<<"Start "<<startIndex<<" Active "<<active<<std::endl;
+  for(size_t i=0;i<Prog.size();i++)
+    {
+      const progItem& PI(Prog[i]);
+      OX<<i<<" : "<<PI.sign*PI.keyN<<" ["<<PI.cacheIndex<<"] ";
+      if (PI.onTrue==acceptIndex) OX<<"T:Accept ";
+      else if (PI.onTrue==rejectIndex) OX<<"T:Reject ";
+      else OX<<"T:"<<PI.onTrue<<" ";
+      if (PI.onFalse==acceptIndex) OX<<"F:Accept";
+      else if (PI.onFalse==rejectIndex) OX<<"F:Reject";
+      else OX<<"F:"<<PI.onFalse;
+      OX<<std::endl;
+    }
+  return;
+}
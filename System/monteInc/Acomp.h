@@ -30,7 +30,7 @@ namespace Geometry
 
 namespace MonteCarlo 
 {
-
+  class BDD;
 
 
 
@@ -81,20 +81,9 @@ class Acomp
   int copySimilar(const Acomp&);        
 
   bool hasUnitInUnit(const int) const;
-  /// Adds a Binary state to the Component
-  void addUnit(const std::vector<int>&,const BnId&);   
-  void assignDNF(const std::vector<int>&,const std::vector<BnId>&);  
-  int getDNFobject(std::vector<int>&,std::vector<BnId>&) const;  
+  void assignCover(const std::vector<std::vector<int>>&,const bool);
   int getDNFpart(std::vector<Acomp>&) const;                   
 
-  int getCNFobject(std::vector<int>&,std::vector<BnId>&) const;  
-  void assignCNF(const std::vector<int>&,const std::vector<BnId>&);   ///< Assigns the Comp with the DNF
-  //  int getCNFpart(std::vector<Acomp>&) const;                   ///< get the CNF parts (as Acomp)
-
-  /// Calculate Principle Components
-  int makePI(std::vector<BnId>&) const;                        
-  int makeEPI(std::vector<BnId>&,std::vector<BnId>&) const;    
-
   int makeReadOnce();                   ///< Factorize into a read once function
 
   static void removeOuterBracket(std::string&);
@@ -178,6 +167,7 @@ class Acomp
   /// Deterimine if inter/union
   int isInter() const { return Intersect; }  
   int isTrue(const std::map<int,int>&) const;   
+  size_t makeBDD(BDD&) const;
   
   void Sort();
 
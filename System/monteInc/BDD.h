@@ -0,0 +1,108 @@
+/*********************************************************************
+  CombLayer : MCNP(X) Input builder
+
+ * File:   monteInc/BDD.h
+ *
+ * Copyright (c) 2004-2019 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ****************************************************************************/
+#ifndef MonteCarlo_BDD_h
+#define MonteCarlo_BDD_h
+
+namespace MonteCarlo
+{
+
+/*!
+  \class BDD
+  \brief Reduced ordered binary decision diagram
+  \version 1.0
+  \author S. Ansell
+  \date May 2019
+
+  Holds a set of boolean functions of the literal numbers
+  [Acomp units] with a fixed order (increasing literal number).
+  Nodes are shared through a unique table so two functions
+  are equal only if they have the same node. The results of
+  the and/or/not operations are cached.
+  A node is referenced by its index : 0 is false and 1 is true.
+*/
+
+class BDD
+{
+ public:
+
+  static const size_t falseNode;     ///< Constant false
+  static const size_t trueNode;      ///< Constant true
+
+  /// Cube : signed literals [intersection]
+  typedef std::vector<int> CUBE;
+
+ private:
+
+  /// Node operations in the cache
+  enum class bddOp : size_t { andOp=0,orOp=1,notOp=2 };
+
+  /*!
+    \struct bddNode
+    \brief Decision on one literal
+  */
+  struct bddNode
+  {
+    size_t level;          ///< Index of the literal
+    size_t low;            ///< Node if false
+    size_t high;           ///< Node if true
+  };
+
+  std::vector<int> keyNumbers;             ///< Literal of each level
+  std::map<int,size_t> keyLevel;           ///< Literal : level
+
+  std::vector<bddNode> Nodes;              ///< All the nodes
+  /// (level,low,high) : node
+  std::map<std::array<size_t,3>,size_t> uniqueTable;
+  /// (op,A,B) : result node
+  std::map<std::array<size_t,3>,size_t> opCache;
+  /// (lower,upper) : cover node / cubes
+  std::map<std::pair<size_t,size_t>,
+	   std::pair<size_t,std::vector<CUBE>>> coverCache;
+
+  size_t makeNode(const size_t,const size_t,const size_t);
+  size_t apply(const bddOp,const size_t,const size_t);
+  size_t topLevel(const size_t,const size_t) const;
+  void cofactor(const size_t,const size_t,size_t&,size_t&) const;
+  size_t ISOP(const size_t,const size_t,std::vector<CUBE>&);
+
+ public:
+
+  explicit BDD(const std::set<int>&);
+  BDD(const BDD&);
+  BDD& operator=(const BDD&);
+  ~BDD() {}         ///< Destructor
+
+  size_t literal(const int);
+  size_t andNode(const size_t,const size_t);
+  size_t orNode(const size_t,const size_t);
+  size_t notNode(const size_t);
+
+  std::vector<CUBE> cover(const size_t);
+  bool isTrue(const size_t,const std::map<int,int>&) const;
+
+  /// Number of nodes [including the constants]
+  size_t nodeCount() const { return Nodes.size(); }
+};
+
+}  // NAMESPACE MonteCarlo
+
+#endif
@@ -126,6 +126,7 @@ class HeadRule
   void isolateSurfNum(const std::set<int>&);
   int removeTopItem(const int);
   int substituteSurf(const int,const int,const Geometry::Surface*);
+  void substituteTemplate(const std::vector<int>&);
   void removeCommon();
   
   void makeComplement();
@@ -144,6 +145,8 @@ class HeadRule
   HeadRule& addUnion(const HeadRule&);
   HeadRule& addIntersection(const Rule*);
   HeadRule& addUnion(const Rule*);
+  HeadRule& addTopIntersection(const HeadRule&);
+  HeadRule& addTopIntersection(const std::vector<HeadRule>&);
 
   int level(const int) const;
   HeadRule getLevel(const size_t) const;
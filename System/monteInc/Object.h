@@ -23,6 +23,7 @@
 #define MonteCarlo_Object_h
 
 class Token;
+class RuleProgram;
 
 namespace MonteCarlo
 {
@@ -58,6 +59,15 @@ class Object
   Geometry::Vec3D magVec; ///< Magnetic field  [for fluka/phits]
   
   HeadRule HRule;    ///< Top rule
+  RuleProgram* progPtr;  ///< Compiled HRule [if populated]
+
+  mutable bool boxValid;            ///< Bounding box calculated
+  mutable Geometry::Vec3D boxLow;   ///< Low corner of bounding box
+  mutable Geometry::Vec3D boxHigh;  ///< High corner of bounding box
+
+  mutable bool vertexValid;          ///< Vertex points calculated
+  /// Vertex points [vertexCalc::calcVertexPoints]
+  mutable std::vector<Geometry::Vec3D> vertexPts;
 
   Geometry::Vec3D COM;       ///< Centre of mass 
   
@@ -69,9 +79,15 @@ class Object
   /// Calc in/out 
   int calcInOut(const int,const int) const;
 
+  void buildProgram();
+  void clearProgram();
+  void clearCache();
+  bool outsideBox(const Geometry::Vec3D&) const;
+
  protected:
   
   int objSurfValid;                 ///< Object surface valid
+  bool surfListValid;               ///< SurList/logicOpp match HRule
 
   /// Full surfaces (make a map including complementary object ?)
   std::vector<const Geometry::Surface*> SurList;  
@@ -141,10 +157,15 @@ class Object
   void populate();
   void rePopulate();
   int createSurfaceList();
+  void updateSurfaceList();
+  /// Surface list built for the current rule
+  bool isSurfListValid() const { return surfListValid; }
   void createLogicOpp();
   int isObjSurfValid() const { return objSurfValid; }  ///< Check validity needed
   void setObjSurfValid()  { objSurfValid=1; }          ///< set as valid
   int addSurfString(const std::string&);   
+  int addIntersection(const HeadRule&);
+  int addIntersection(const std::vector<HeadRule>&);
   int removeSurface(const int);        
   int substituteSurf(const int,const int,Geometry::Surface*);  
   void makeComplement();
@@ -157,6 +178,14 @@ class Object
   int isValid(const Geometry::Vec3D&,const std::set<int>&) const;            
   int pairValid(const int,const Geometry::Vec3D&) const;   
   int isValid(const std::map<int,int>&) const; 
+  void isValidBlock(const Geometry::Vec3D*,const size_t,char*) const;
+  void getBoundBox(Geometry::Vec3D&,Geometry::Vec3D&) const;
+  /// Have the vertex points been calculated
+  bool hasVertexPoints() const { return vertexValid; }
+  /// Access the vertex points [if calculated]
+  const std::vector<Geometry::Vec3D>& getVertexPoints() const
+    { return vertexPts; }
+  void setVertexPoints(const std::vector<Geometry::Vec3D>&) const;
   std::map<int,int> mapValid(const Geometry::Vec3D&) const;
 
   int isOnSide(const Geometry::Vec3D&) const;
@@ -173,11 +202,10 @@ class Object
   std::vector<std::pair<int,int>> getImplicatePairs(const int) const;
   std::vector<std::pair<int,int>> getImplicatePairs() const;
   
-  ///\cond ABSTRACT
-  virtual void displace(const Geometry::Vec3D&) {}
-  virtual void rotate(const Geometry::Matrix<double>&) {}
-  virtual void mirror(const Geometry::Plane&) {}
-  ///\endcond ABSTRACT
+  void clearGeomCache();
+  virtual void displace(const Geometry::Vec3D&);
+  virtual void rotate(const Geometry::Matrix<double>&);
+  virtual void mirror(const Geometry::Plane&);
 
   // INTERSECTION
   int hasIntercept(const Geometry::Vec3D&,const Geometry::Vec3D&) const;
@@ -0,0 +1,48 @@
+/********************************************************************* 
+  CombLayer : MNCPX Input builder
+ 
+ * File:   monteInc/RuleBox.h
+*
+ * Copyright (c) 2004-2013 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+ *
+ ****************************************************************************/
+#ifndef RuleBox_h
+#define RuleBox_h
+
+class HeadRule;
+
+/*!
+  \namespace RuleBox
+  \version 1.0
+  \author S. Ansell
+  \date May 2019
+  \brief Conservative axis-aligned box of a rule
+
+  Intersections are the convex region of the half-spaces of
+  the planes [cylinders/spheres by their enclosing prism/cube]
+  and unions are the box of the boxes of the parts. 
+  Complements and other surfaces are unbounded.
+*/
+
+namespace RuleBox
+{
+  const double maxExtent(1e8);     ///< Size of the world
+
+  void calcBoundBox(const HeadRule&,Geometry::Vec3D&,Geometry::Vec3D&);
+  bool isBounded(const Geometry::Vec3D&,const Geometry::Vec3D&);
+}
+
+#endif
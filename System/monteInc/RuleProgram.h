@@ -0,0 +1,116 @@
+/*********************************************************************
+  CombLayer : MCNP(X) Input builder
+
+ * File:   monteInc/RuleProgram.h
+ *
+ * Copyright (c) 2004-2019 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ****************************************************************************/
+#ifndef RuleProgram_h
+#define RuleProgram_h
+
+class Rule;
+
+namespace Geometry
+{
+  class Surface;
+}
+
+namespace MonteCarlo
+{
+  class Object;
+}
+
+/*!
+  \class RuleProgram
+  \brief Flat branching program of a rule tree
+  \author S.Ansell
+  \version 1.0
+  \date May 2019
+
+  Each leaf of the rule is a test with a jump for a true
+  result and a jump for a false result. Intersection/union
+  short-circuits and complements are resolved into the jumps
+  at compile time so evaluation is a single loop.
+  The common surfaces (plane/cylinder/sphere) are called
+  without virtual dispatch and each surface side is
+  only evaluated once per point.
+*/
+
+class RuleProgram
+{
+ private:
+
+  /// leaf types
+  enum class progType { Surf, Plane, Cylinder, Sphere, Obj };
+
+  /*!
+    \struct progItem
+    \brief Single test in the program
+  */
+  struct progItem
+  {
+    progType type;                  ///< Type of the test
+    int keyN;                       ///< Surface number [unsigned]
+    int sign;                       ///< Surface sign / object complement
+    const Geometry::Surface* surf;  ///< Surface
+    const MonteCarlo::Object* obj;  ///< Object [CompObj/ContObj]
+    size_t cacheIndex;              ///< Index in the side cache
+    size_t onTrue;                  ///< Next item if true
+    size_t onFalse;                 ///< Next item if false
+  };
+
+  static const size_t acceptIndex;  ///< Program end : valid
+  static const size_t rejectIndex;  ///< Program end : not valid
+  static const size_t maxCache=64;  ///< Max cached surfaces
+  static const size_t blockSize=64; ///< Points per block [isValidBlock]
+
+  bool active;                      ///< Program compiled
+  size_t startIndex;                ///< Initial item
+  std::vector<progItem> Prog;       ///< Program items
+
+  size_t addSurfItem(const Rule*,const size_t,const size_t,
+		     std::map<const Geometry::Surface*,size_t>&);
+  size_t compileRule(const Rule*,const size_t,const size_t,
+		     std::map<const Geometry::Surface*,size_t>&);
+
+  int surfSide(const progItem&,const Geometry::Vec3D&) const;
+  bool evaluate(const Geometry::Vec3D&,const int,const int) const;
+
+ public:
+
+  RuleProgram();
+  RuleProgram(const RuleProgram&);
+  RuleProgram& operator=(const RuleProgram&);
+  ~RuleProgram() {}    ///< Destructor
+
+  bool compile(const Rule*);
+  void clear();
+
+  /// Is the program usable
+  bool isActive() const { return active; }
+  /// Number of tests
+  size_t size() const { return Prog.size(); }
+
+  bool isValid(const Geometry::Vec3D&) const;
+  bool isValid(const Geometry::Vec3D&,const int) const;
+  bool isDirectionValid(const Geometry::Vec3D&,const int) const;
+  void isValidBlock(const Geometry::Vec3D*,const size_t,char*) const;
+
+  void write(std::ostream&) const;
+};
+
+#endif
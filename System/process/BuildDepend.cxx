@@ -0,0 +1,232 @@
+/*********************************************************************
+  CombLayer : MCNP(X) Input builder
+
+ * File:   process/BuildDepend.cxx
+ *
+ * Copyright (c) 2004-2019 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ****************************************************************************/
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <cmath>
+#include <complex>
+#include <list>
+#include <vector>
+#include <set>
+#include <map>
+#include <string>
+#include <algorithm>
+#include <memory>
+
+#include "Exception.h"
+#include "FileReport.h"
+#include "NameStack.h"
+#include "RegMethod.h"
+#include "GTKreport.h"
+#include "OutputLog.h"
+#include "BaseVisit.h"
+#include "BaseModVisit.h"
+#include "support.h"
+#include "MatrixBase.h"
+#include "Matrix.h"
+#include "Vec3D.h"
+#include "Rules.h"
+#include "varList.h"
+#include "Code.h"
+#include "FItem.h"
+#include "FuncDataBase.h"
+#include "BuildDepend.h"
+
+namespace ModelSupport
+{
+
+static std::string
+variableString(const FItem& FI)
+  /*!
+    Value of a variable as a string [full precision]
+    \param FI :: Variable
+    \return value string
+  */
+{
+  std::ostringstream cx;
+  cx<<std::setprecision(17);
+  FI.write(cx);
+  return cx.str();
+}
+
+BuildDepend::BuildDepend()
+  /*!
+    Constructor
+  */
+{}
+
+BuildDepend::BuildDepend(const BuildDepend& A) :
+  readVar(A.readVar),missVar(A.missVar)
+  /*!
+    Copy constructor
+    \param A :: BuildDepend to copy
+  */
+{}
+
+BuildDepend&
+BuildDepend::operator=(const BuildDepend& A)
+  /*!
+    Assignment operator
+    \param A :: BuildDepend to copy
+    \return *this
+  */
+{
+  if (this!=&A)
+    {
+      readVar=A.readVar;
+      missVar=A.missVar;
+    }
+  return *this;
+}
+
+void
+BuildDepend::clear()
+  /*!
+    Remove all the records
+  */
+{
+  readVar.clear();
+  missVar.clear();
+  return;
+}
+
+void
+BuildDepend::build(const FuncDataBase& Control)
+  /*!
+    Record the variables read [active] and the names 
+    looked up but not set [defaulted] in the build
+    \param Control :: Variables after the build
+  */
+{
+  ELog::RegMethod RegA("BuildDepend","build");
+
+  clear();
+  for(const std::string& VName : Control.getKeys())
+    {
+      const FItem* FPtr=Control.findItem(VName);
+      if (FPtr && FPtr->isActive())
+	readVar.emplace(VName,variableString(*FPtr));
+    }
+  // names still not set after the build
+  const varList& VList=Control.getVarList();
+  for(const std::string& VName : Control.getMissing())
+    if (!VList.findVar(VName))
+      missVar.insert(VName);
+  return;
+}
+
+std::set<std::string>
+BuildDepend::changedVariables(const FuncDataBase& Control) const
+  /*!
+    Find the recorded variables that have been changed/removed
+    and the defaulted names that are now set
+    \param Control :: Current variables
+    \return names of the changed variables
+  */
+{
+  ELog::RegMethod RegA("BuildDepend","changedVariables");
+
+  std::set<std::string> Out;
+  for(const auto& [VName,Value] : readVar)
+    {
+      const FItem* FPtr=Control.findItem(VName);
+      if (!FPtr || variableString(*FPtr)!=Value)
+	Out.insert(VName);
+    }
+
+  const varList& VList=Control.getVarList();
+  for(const std::string& VName : missVar)
+    if (VList.findVar(VName))
+      Out.insert(VName);
+  return Out;
+}
+
+void
+BuildDepend::setRead(const FuncDataBase& Control) const
+  /*!
+    Mark the recorded variables as read [active] so that
+    a restored build writes the same variable list as
+    the original build
+    \param Control :: Current variables
+  */
+{
+  ELog::RegMethod RegA("BuildDepend","setRead");
+
+  std::string Value;
+  for(const auto& [VName,VItem] : readVar)
+    {
+      const FItem* FPtr=Control.findItem(VName);
+      if (FPtr)
+	FPtr->getValue(Value);
+    }
+  return;
+}
+
+void
+BuildDepend::write(std::ostream& OX) const
+  /*!
+    Write the record as lines of :
+    - V variable value
+    - M variable [defaulted]
+    \param OX :: Output stream
+  */
+{
+  for(const auto& [VName,Value] : readVar)
+    OX<<"V "<<VName<<" "<<Value<<"\n";
+  for(const std::string& VName : missVar)
+    OX<<"M "<<VName<<"\n";
+  return;
+}
+
+void
+BuildDepend::read(std::istream& IX)
+  /*!
+    Read the record [from write]
+    \param IX :: Input stream
+  */
+{
+  ELog::RegMethod RegA("BuildDepend","read");
+
+  clear();
+  std::string Line;
+  while(std::getline(IX,Line))
+    {
+      std::istringstream cx(Line);
+      std::string key,name;
+      if (!(cx>>key>>name)) continue;
+      if (key=="M")
+	missVar.insert(name);
+      else if (key=="V")
+	{
+	  std::string Value;
+	  std::getline(cx,Value);
+	  if (!Value.empty()) Value.erase(0,1);
+	  readVar.emplace(name,Value);
+	}
+      else
+	throw ColErr::InvalidLine("BuildDepend record",Line);
+    }
+  return;
+}
+
+} // NAMESPACE ModelSupport
@@ -0,0 +1,349 @@
+/*********************************************************************
+  CombLayer : MCNP(X) Input builder
+
+ * File:   process/CellIndex.cxx
+ *
+ * Copyright (c) 2004-2019 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ****************************************************************************/
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <cmath>
+#include <complex>
+#include <vector>
+#include <set>
+#include <map>
+#include <string>
+#include <algorithm>
+#include <iterator>
+#include <memory>
+
+#include "Exception.h"
+#include "FileReport.h"
+#include "NameStack.h"
+#include "RegMethod.h"
+#include "GTKreport.h"
+#include "OutputLog.h"
+#include "BaseVisit.h"
+#include "BaseModVisit.h"
+#include "MatrixBase.h"
+#include "Matrix.h"
+#include "Vec3D.h"
+#include "Rules.h"
+#include "HeadRule.h"
+#include "Object.h"
+#include "RuleBox.h"
+#include "CellIndex.h"
+
+namespace ModelSupport
+{
+
+CellIndex::CellIndex() :
+  NX(0),NY(0),NZ(0)
+ /*!
+   Constructor
+ */
+{}
+
+CellIndex::CellIndex(const CellIndex& A) :
+  NX(A.NX),NY(A.NY),NZ(A.NZ),LowPt(A.LowPt),InvStep(A.InvStep),
+  ObjVec(A.ObjVec),wideCells(A.wideCells),
+  gridOffset(A.gridOffset),gridCells(A.gridCells)
+  /*!
+    Copy Constructor
+    \param A :: CellIndex to copy
+  */
+{}
+
+CellIndex&
+CellIndex::operator=(const CellIndex& A)
+  /*!
+    Assignment operator
+    \param A :: CellIndex to copy
+    \return *this
+  */
+{
+  if (this!=&A)
+    {
+      NX=A.NX;
+      NY=A.NY;
+      NZ=A.NZ;
+      LowPt=A.LowPt;
+      InvStep=A.InvStep;
+      ObjVec=A.ObjVec;
+      wideCells=A.wideCells;
+      gridOffset=A.gridOffset;
+      gridCells=A.gridCells;
+    }
+  return *this;
+}
+
+void
+CellIndex::clearAll()
+  /*!
+    Remove the index [it needs to be rebuilt]
+  */
+{
+  NX=0;
+  NY=0;
+  NZ=0;
+  ObjVec.clear();
+  wideCells.clear();
+  gridOffset.clear();
+  gridCells.clear();
+  return;
+}
+
+void
+CellIndex::build(const std::map<int,MonteCarlo::Object*>& OMap)
+  /*!
+    Build the grid from the objects
+    \param OMap :: Object map [ordered by cell number]
+  */
+{
+  ELog::RegMethod RegA("CellIndex","build");
+
+  clearAll();
+
+  std::vector<Geometry::Vec3D> LBox;
+  std::vector<Geometry::Vec3D> HBox;
+  std::vector<size_t> boundCells;
+
+  const double maxExtent(RuleBox::maxExtent);
+  Geometry::Vec3D GLow(maxExtent,maxExtent,maxExtent);
+  Geometry::Vec3D GHigh(-maxExtent,-maxExtent,-maxExtent);
+  for(const std::map<int,MonteCarlo::Object*>::value_type& mc : OMap)
+    {
+      MonteCarlo::Object* OPtr=mc.second;
+      OPtr->populate();
+
+      Geometry::Vec3D LPt,HPt;
+      OPtr->getBoundBox(LPt,HPt);
+      const size_t index(ObjVec.size());
+      ObjVec.push_back(OPtr);
+      LBox.push_back(LPt);
+      HBox.push_back(HPt);
+      if (RuleBox::isBounded(LPt,HPt))
+	{
+	  boundCells.push_back(index);
+	  for(size_t i=0;i<3;i++)
+	    {
+	      GLow[i]=std::min(GLow[i],LPt[i]);
+	      GHigh[i]=std::max(GHigh[i],HPt[i]);
+	    }
+	}
+      else
+	wideCells.push_back(index);
+    }
+
+  if (boundCells.empty())
+    return;
+
+  // Grid size : about 8 voxels per bounded cell
+  const size_t maxDim(256);
+  const double nTarget=std::min(8.0*static_cast<double>(boundCells.size()),
+				4.0e6);
+  const Geometry::Vec3D Extent(GHigh-GLow);
+  double vol(1.0);
+  size_t nDim(0);
+  for(size_t i=0;i<3;i++)
+    if (Extent[i]>Geometry::zeroTol)
+      {
+	vol*=Extent[i];
+	nDim++;
+      }
+  const double step=(nDim) ?
+    std::pow(vol/nTarget,1.0/static_cast<double>(nDim)) : 1.0;
+
+  size_t NVox[3];
+  for(size_t i=0;i<3;i++)
+    {
+      const double nV=(step>0.0) ? std::ceil(Extent[i]/step) : 1.0;
+      NVox[i]=std::max<size_t>
+	(1,std::min<size_t>(maxDim,static_cast<size_t>(nV)));
+      InvStep[i]=(Extent[i]>Geometry::zeroTol) ?
+	static_cast<double>(NVox[i])/Extent[i] : 0.0;
+    }
+  NX=NVox[0];
+  NY=NVox[1];
+  NZ=NVox[2];
+  LowPt=GLow;
+
+  // Cells covering a large part of the grid are better as wide cells
+  const size_t NTotal(NX*NY*NZ);
+  const size_t maxCover=std::max<size_t>(64,NTotal/16);
+
+  std::vector<std::vector<size_t>> Voxel(NTotal);
+  for(const size_t index : boundCells)
+    {
+      size_t lowI[3],highI[3];
+      for(size_t i=0;i<3;i++)
+	{
+	  const double LV=(LBox[index][i]-LowPt[i])*InvStep[i];
+	  const double HV=(HBox[index][i]-LowPt[i])*InvStep[i];
+	  lowI[i]=static_cast<size_t>(std::max(0.0,LV));
+	  highI[i]=std::min(NVox[i]-1,static_cast<size_t>(std::max(0.0,HV)));
+	  lowI[i]=std::min(lowI[i],highI[i]);
+	}
+      const size_t cover=(highI[0]-lowI[0]+1)*
+	(highI[1]-lowI[1]+1)*(highI[2]-lowI[2]+1);
+      if (cover>maxCover)
+	{
+	  wideCells.push_back(index);
+	  continue;
+	}
+      for(size_t i=lowI[0];i<=highI[0];i++)
+	for(size_t j=lowI[1];j<=highI[1];j++)
+	  for(size_t k=lowI[2];k<=highI[2];k++)
+	    Voxel[(i*NY+j)*NZ+k].push_back(index);
+    }
+  std::sort(wideCells.begin(),wideCells.end());
+
+  // flatten [index already sorted by construction]
+  gridOffset.resize(NTotal+1);
+  size_t sum(0);
+  for(size_t i=0;i<NTotal;i++)
+    {
+      gridOffset[i]=sum;
+      sum+=Voxel[i].size();
+    }
+  gridOffset[NTotal]=sum;
+  gridCells.reserve(sum);
+  for(const std::vector<size_t>& VC : Voxel)
+    gridCells.insert(gridCells.end(),VC.begin(),VC.end());
+  return;
+}
+
+bool
+CellIndex::voxelIndex(const Geometry::Vec3D& Pt,size_t& index) const
+  /*!
+    Get the voxel index of the point
+    \param Pt :: Point to test
+    \param index :: voxel index
+    \return true if point in grid
+  */
+{
+  if (!NX) return 0;
+
+  const size_t NVox[3]={NX,NY,NZ};
+  size_t I[3];
+  for(size_t i=0;i<3;i++)
+    {
+      const double V=(Pt[i]-LowPt[i])*InvStep[i];
+      if (V<0.0) return 0;
+      I[i]=static_cast<size_t>(V);
+      if (I[i]>=NVox[i])
+	{
+	  // allow for the upper edge of the grid
+	  if (V>static_cast<double>(NVox[i])+1e-6)
+	    return 0;
+	  I[i]=NVox[i]-1;
+	}
+    }
+  index=(I[0]*NY+I[1])*NZ+I[2];
+  return 1;
+}
+
+MonteCarlo::Object*
+CellIndex::findCell(const Geometry::Vec3D& Pt) const
+  /*!
+    Find the first cell [in cell order] containing the point.
+    Merges the voxel candidates with the wide cells.
+    \param Pt :: Point to find
+    \return Object ptr / 0 if none of the candidates are valid
+  */
+{
+  size_t vIndex;
+  std::vector<size_t>::const_iterator ac,aEnd;
+  if (voxelIndex(Pt,vIndex))
+    {
+      ac=gridCells.begin()+static_cast<long int>(gridOffset[vIndex]);
+      aEnd=gridCells.begin()+static_cast<long int>(gridOffset[vIndex+1]);
+    }
+  else
+    {
+      ac=gridCells.end();
+      aEnd=gridCells.end();
+    }
+
+  std::vector<size_t>::const_iterator bc=wideCells.begin();
+  while(ac!=aEnd || bc!=wideCells.end())
+    {
+      size_t index;
+      if (bc==wideCells.end() || (ac!=aEnd && *ac < *bc))
+	index=*ac++;
+      else
+	index=*bc++;
+      if (ObjVec[index]->isValid(Pt))
+	return ObjVec[index];
+    }
+  return 0;
+}
+
+size_t
+CellIndex::findAllCells(const Geometry::Vec3D& Pt,
+			std::vector<MonteCarlo::Object*>& Out) const
+  /*!
+    Find all the cells [in cell order] containing the point.
+    More than one is an overlap.
+    \param Pt :: Point to find
+    \param Out :: Valid cells [cleared]
+    \return number of cells found
+  */
+{
+  Out.clear();
+  size_t vIndex;
+  std::vector<size_t>::const_iterator ac,aEnd;
+  if (voxelIndex(Pt,vIndex))
+    {
+      ac=gridCells.begin()+static_cast<long int>(gridOffset[vIndex]);
+      aEnd=gridCells.begin()+static_cast<long int>(gridOffset[vIndex+1]);
+    }
+  else
+    {
+      ac=gridCells.end();
+      aEnd=gridCells.end();
+    }
+
+  std::vector<size_t>::const_iterator bc=wideCells.begin();
+  while(ac!=aEnd || bc!=wideCells.end())
+    {
+      size_t index;
+      if (bc==wideCells.end() || (ac!=aEnd && *ac < *bc))
+	index=*ac++;
+      else
+	index=*bc++;
+      if (ObjVec[index]->isValid(Pt))
+	Out.push_back(ObjVec[index]);
+    }
+  return Out.size();
+}
+
+void
+CellIndex::write(std::ostream& OX) const
+  /*!
+    Write out the grid information
+    \param OX :: Output stream
+  */
+{
+  OX<<"Grid "<<NX<<" "<<NY<<" "<<NZ<<" Low "<<LowPt<<std::endl;
+  OX<<"Cells "<<ObjVec.size()<<" wide "<<wideCells.size()
+    <<" entries "<<gridCells.size()<<std::endl;
+  return;
+}
+
+} // NAMESPACE ModelSupport
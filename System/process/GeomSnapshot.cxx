@@ -0,0 +1,614 @@
+/********************************************************************* 
+  CombLayer : MCNP(X) Input builder
+ 
+ * File:   process/GeomSnapshot.cxx
+ *
+ * Copyright (c) 2004-2019 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+ *
+ ****************************************************************************/
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <cmath>
+#include <complex>
+#include <list>
+#include <vector>
+#include <set>
+#include <map>
+#include <string>
+#include <algorithm>
+#include <iterator>
+#include <memory>
+#include <array>
+#include <tuple>
+#include <boost/format.hpp>
+
+#include "Exception.h"
+#include "FileReport.h"
+#include "NameStack.h"
+#include "RegMethod.h"
+#include "GTKreport.h"
+#include "OutputLog.h"
+#include "BaseVisit.h"
+#include "BaseModVisit.h"
+#include "support.h"
+#include "MatrixBase.h"
+#include "Matrix.h"
+#include "Vec3D.h"
+#include "Surface.h"
+#include "surfIndex.h"
+#include "surfRegister.h"
+#include "masterWrite.h"
+#include "Rules.h"
+#include "varList.h"
+#include "Code.h"
+#include "FuncDataBase.h"
+#include "HeadRule.h"
+#include "Object.h"
+#include "Zaid.h"
+#include "MXcards.h"
+#include "Material.h"
+#include "DBMaterial.h"
+#include "groupRange.h"
+#include "objectGroups.h"
+#include "Simulation.h"
+#include "LinkUnit.h"
+#include "FixedComp.h"
+#include "ContainedComp.h"
+#include "BaseMap.h"
+#include "CellMap.h"
+#include "SurfMap.h"
+#include "RestoredComp.h"
+#include "BuildDepend.h"
+#include "GeomSnapshot.h"
+
+namespace ModelSupport
+{
+
+const std::string GeomSnapshot::magicKey("CombLayerSnapshot");
+const int GeomSnapshot::version(4);
+
+/*!
+  \class snapBuffer
+  \brief Read position in a loaded snapshot file 
+*/
+class snapBuffer
+{
+ private:
+
+  const std::string& FName;    ///< File name [for errors]
+  const std::string& Buffer;   ///< File contents
+  size_t pos;                  ///< Current position
+
+  /// Check that N bytes are left
+  void check(const size_t N) const
+    {
+      if (pos+N>Buffer.size())
+	throw ColErr::FileError(0,FName,"Snapshot truncated");
+    }
+
+ public:
+
+  /// Constructor
+  snapBuffer(const std::string& F,const std::string& B) :
+    FName(F),Buffer(B),pos(0) {}
+
+  /// Get a fixed size value
+  template<typename T>
+  T get()
+    {
+      T Out;
+      check(sizeof(T));
+      std::copy(Buffer.data()+pos,Buffer.data()+pos+sizeof(T),
+		reinterpret_cast<char*>(&Out));
+      pos+=sizeof(T);
+      return Out;
+    }
+
+  /// Get a length + string
+  std::string getString()
+    {
+      const size_t N=get<size_t>();
+      check(N);
+      const std::string Out(Buffer,pos,N);
+      pos+=N;
+      return Out;
+    }
+
+  /// Get a vector
+  Geometry::Vec3D getVec3D()
+    {
+      const double x=get<double>();
+      const double y=get<double>();
+      const double z=get<double>();
+      return Geometry::Vec3D(x,y,z);
+    }
+
+  /// Get a length + int vector
+  std::vector<int> getIntVec()
+    {
+      const size_t N=get<size_t>();
+      std::vector<int> Out(N);
+      for(int& I : Out)
+	I=get<int>();
+      return Out;
+    }
+};
+
+template<typename T>
+static void
+putValue(std::ostream& OX,const T& Value)
+  /*!
+    Write a fixed size value
+    \param OX :: Output stream
+    \param Value :: Value to write
+  */
+{
+  OX.write(reinterpret_cast<const char*>(&Value),sizeof(T));
+  return;
+}
+
+static void
+putString(std::ostream& OX,const std::string& Value)
+  /*!
+    Write a length + string
+    \param OX :: Output stream
+    \param Value :: String to write
+  */
+{
+  putValue<size_t>(OX,Value.size());
+  OX.write(Value.data(),static_cast<std::streamsize>(Value.size()));
+  return;
+}
+
+static void
+putRule(std::ostream& OX,const HeadRule& HR)
+  /*!
+    Write a rule. Parsing a displayed rule reverses its
+    order, so the string written is the display of the 
+    re-parsed rule: it reads back as the same rule.
+    \param OX :: Output stream
+    \param HR :: Rule to write
+  */
+{
+  const HeadRule RevHR(HR.display());
+  putString(OX,RevHR.display());
+  return;
+}
+
+static void
+putVec3D(std::ostream& OX,const Geometry::Vec3D& Value)
+  /*!
+    Write a vector
+    \param OX :: Output stream
+    \param Value :: Vector to write
+  */
+{
+  putValue<double>(OX,Value.X());
+  putValue<double>(OX,Value.Y());
+  putValue<double>(OX,Value.Z());
+  return;
+}
+
+static void
+putIntVec(std::ostream& OX,const std::vector<int>& Value)
+  /*!
+    Write a length + int vector
+    \param OX :: Output stream
+    \param Value :: Vector to write
+  */
+{
+  putValue<size_t>(OX,Value.size());
+  for(const int I : Value)
+    putValue<int>(OX,I);
+  return;
+}
+
+static void
+putBaseMap(std::ostream& OX,const attachSystem::BaseMap* BPtr)
+  /*!
+    Write the named items of a cell/surf map
+    \param OX :: Output stream
+    \param BPtr :: Map to write [null : no items]
+  */
+{
+  if (!BPtr)
+    {
+      putValue<size_t>(OX,0);
+      return;
+    }
+  const std::vector<std::string> Names=BPtr->getNames();
+  putValue<size_t>(OX,Names.size());
+  for(const std::string& N : Names)
+    {
+      putString(OX,N);
+      putIntVec(OX,BPtr->getItems(N));
+    }
+  return;
+}
+
+GeomSnapshot::GeomSnapshot(const std::string& F,
+			   const std::string& K) :
+  FName(F),buildKey(K)
+  /*!
+    Constructor
+    \param F :: Snapshot file name
+    \param K :: Key of the build [variables/options]
+  */
+{}
+
+GeomSnapshot::GeomSnapshot(const GeomSnapshot& A) :
+  FName(A.FName),buildKey(A.buildKey)
+  /*!
+    Copy constructor
+    \param A :: GeomSnapshot to copy
+  */
+{}
+
+bool
+GeomSnapshot::read(Simulation& System) const
+  /*!
+    Restore the geometry from the snapshot file. The 
+    Simulation must not have any cells yet. Zones/components
+    that already exist (e.g. World) are kept.
+    \param System :: Simulation to restore into
+    \return true if the snapshot exists, has the same build 
+    options and the variables read in its build are unchanged
+  */
+{
+  ELog::RegMethod RegA("GeomSnapshot","read");
+
+  std::ifstream IX(FName.c_str(),std::ios::in | std::ios::binary);
+  if (!IX.good()) return 0;
+
+  const std::string Buffer((std::istreambuf_iterator<char>(IX)),
+			   std::istreambuf_iterator<char>());
+  IX.close();
+  
+  snapBuffer SB(FName,Buffer);
+  if (Buffer.size()<magicKey.size() ||
+      SB.getString()!=magicKey || SB.get<int>()!=version)
+    {
+      ELog::EM<<"Snapshot "<<FName<<" not a valid snapshot"<<ELog::endWarn;
+      return 0;
+    }
+  if (SB.getString()!=buildKey)
+    {
+      ELog::EM<<"Snapshot "<<FName<<" build options changed"
+	      <<ELog::endDiag;
+      return 0;
+    }
+  BuildDepend BD;
+  std::istringstream DX(SB.getString());
+  BD.read(DX);
+  const std::set<std::string> changeVar=
+    BD.changedVariables(System.getDataBase());
+  if (!changeVar.empty())
+    {
+      ELog::EM<<"Snapshot "<<FName<<" : "<<changeVar.size()
+	      <<" variables changed/set ["<<*changeVar.begin()<<" ...]"
+	      <<ELog::endDiag;
+      return 0;
+    }
+  if (!System.getCells().empty())
+    throw ColErr::FileError(0,FName,"Snapshot into built Simulation");
+
+  // MATERIALS
+  ModelSupport::DBMaterial& DB=ModelSupport::DBMaterial::Instance();
+  std::map<int,int> matMap({{0,0}});
+  const size_t NMat=SB.get<size_t>();
+  for(size_t i=0;i<NMat;i++)
+    {
+      const int matID=SB.get<int>();
+      const std::string matName=SB.getString();
+      matMap.emplace(matID,DB.processMaterial(matName));
+    }
+
+  // SURFACES
+  ModelSupport::surfIndex& SurI=ModelSupport::surfIndex::Instance();
+  const size_t NSurf=SB.get<size_t>();
+  for(size_t i=0;i<NSurf;i++)
+    {
+      const int surfN=SB.get<int>();
+      const int transN=SB.get<int>();
+      SurI.createSurface(surfN,transN,SB.getString());
+    }
+
+  // CELL ZONES [runs of the same name are re-registered in order]
+  typedef std::shared_ptr<attachSystem::RestoredComp> RCTYPE;
+  std::map<std::string,RCTYPE> restored;
+
+  const int cellZone(System.getCellZone());
+  const objectGroups::RTYPE& RMap=System.getRangeMap();
+  std::vector<std::tuple<int,int,std::string>> zoneVec;
+  const size_t NZone=SB.get<size_t>();
+  for(size_t i=0;i<NZone;i++)
+    {
+      const int zone=SB.get<int>();
+      const int compFlag=SB.get<int>();
+      zoneVec.emplace_back(zone,compFlag,SB.getString());
+    }
+  for(size_t i=0;i<zoneVec.size();)
+    {
+      const auto& [zone,compFlag,zoneName]=zoneVec[i];
+      size_t nZone(1);
+      while(i+nZone<zoneVec.size() &&
+	    std::get<2>(zoneVec[i+nZone])==zoneName)
+	nZone++;
+      
+      const size_t resSize(nZone*static_cast<size_t>(cellZone));
+      objectGroups::RTYPE::const_iterator rc=RMap.find(zone);
+      int startCell;
+      if (rc!=RMap.end() && rc->second==zoneName)
+	startCell=zone*cellZone;
+      else if (compFlag)
+	{
+	  RCTYPE RPtr=std::make_shared<attachSystem::RestoredComp>
+	    (zoneName,0,resSize);
+	  startCell=RPtr->getNextCell()-1;
+	  restored.emplace(zoneName,RPtr);
+	}
+      else
+	startCell=System.cell(zoneName,resSize);
+
+      if (startCell!=zone*cellZone)
+	throw ColErr::MisMatch<int>(startCell,zone*cellZone,
+				    "Snapshot zone of "+zoneName);
+      i+=nZone;
+    }
+
+  // COMPONENTS
+  std::vector<std::pair<std::string,RCTYPE>> compVec;
+  const size_t NComp=SB.get<size_t>();
+  for(size_t i=0;i<NComp;i++)
+    {
+      const std::string name=SB.getString();
+      const std::string keyName=SB.getString();
+
+      const Geometry::Vec3D Org=SB.getVec3D();
+      const Geometry::Vec3D XV=SB.getVec3D();
+      const Geometry::Vec3D YV=SB.getVec3D();
+      const Geometry::Vec3D ZV=SB.getVec3D();
+
+      std::vector<std::pair<std::string,size_t>> keyVec;
+      const size_t NKey=SB.get<size_t>();
+      for(size_t j=0;j<NKey;j++)
+	{
+	  const std::string sideName=SB.getString();
+	  keyVec.emplace_back(sideName,SB.get<size_t>());
+	}
+      
+      const size_t NLink=SB.get<size_t>();
+      std::vector<attachSystem::LinkUnit> LUVec(NLink);
+      for(attachSystem::LinkUnit& LU : LUVec)
+	{
+	  const int flag=SB.get<int>();
+	  const Geometry::Vec3D Axis=SB.getVec3D();
+	  const Geometry::Vec3D Pt=SB.getVec3D();
+	  if (flag & 1) LU.setAxis(Axis);
+	  if (flag & 2) LU.setConnectPt(Pt);
+	  const int linkSurf=SB.get<int>();
+	  LU.setLinkSurf(HeadRule(SB.getString()),linkSurf);
+	  const std::string bridgeStr=SB.getString();
+	  if (!bridgeStr.empty())
+	    LU.setBridgeSurf(HeadRule(bridgeStr));
+	}
+
+      const std::string outerStr=SB.getString();
+      std::vector<std::pair<std::string,std::vector<int>>> itemVec[2];
+      for(size_t mapIndex=0;mapIndex<2;mapIndex++)
+	{
+	  const size_t NItem=SB.get<size_t>();
+	  for(size_t j=0;j<NItem;j++)
+	    {
+	      const std::string itemName=SB.getString();
+	      itemVec[mapIndex].emplace_back(itemName,SB.getIntVec());
+	    }
+	}
+
+      // components made before the restore are not replaced
+      if (System.hasObject(name)) continue;
+      
+      RCTYPE RPtr;
+      std::map<std::string,RCTYPE>::const_iterator mc=restored.find(keyName);
+      if (mc==restored.end())
+	{
+	  RPtr=std::make_shared<attachSystem::RestoredComp>(keyName,0,1);
+	  restored.emplace(keyName,RPtr);
+	}
+      else
+	RPtr=mc->second;
+      compVec.emplace_back(name,RPtr);
+
+      RPtr->createUnitVector(Org,XV,YV,ZV);
+      RPtr->setNConnect(NLink);
+      for(size_t j=0;j<NLink;j++)
+	RPtr->setLinkUnit(j,LUVec[j]);
+      for(const std::pair<std::string,size_t>& KV : keyVec)
+	if (KV.second<NLink)
+	  RPtr->nameSideIndex(KV.second,KV.first);
+
+      if (!outerStr.empty())
+	RPtr->addOuterSurf(outerStr);
+      for(const auto& [itemName,items] : itemVec[0])
+	RPtr->CellMap::setItems(itemName,items);
+      for(const auto& [itemName,items] : itemVec[1])
+	RPtr->SurfMap::setItems(itemName,items);
+    }
+  // CELLS
+  const size_t NCell=SB.get<size_t>();
+  for(size_t i=0;i<NCell;i++)
+    {
+      const int cellN=SB.get<int>();
+      const int matID=SB.get<int>();
+      const double matTemp=SB.get<double>();
+      const int imp=SB.get<int>();
+      const std::string FCUnit=SB.getString();
+      const std::string ruleStr=SB.getString();
+
+      std::map<int,int>::const_iterator mc=matMap.find(matID);
+      if (mc==matMap.end())
+	throw ColErr::InContainerError<int>(matID,"Snapshot material");
+	
+      MonteCarlo::Object TX(cellN,mc->second,matTemp,ruleStr);
+      TX.setImp(imp);
+      TX.setFCUnit(FCUnit);
+      System.addCell(cellN,TX);
+    }
+
+  for(const std::pair<std::string,RCTYPE>& CV : compVec)
+    System.addObject(CV.first,CV.second);
+  BD.setRead(System.getDataBase());
+
+  ELog::EM<<"Geometry restored from "<<FName<<ELog::endDiag;
+  return 1;
+}
+
+void
+GeomSnapshot::write(const Simulation& System) const
+  /*!
+    Write the current geometry to the snapshot file
+    \param System :: Simulation after the components are built
+  */
+{
+  ELog::RegMethod RegA("GeomSnapshot","write");
+
+  std::ofstream OX(FName.c_str(),std::ios::out | std::ios::binary);
+  if (!OX.good())
+    throw ColErr::FileError(0,FName,"Snapshot not opened");
+
+  putString(OX,magicKey);
+  putValue<int>(OX,version);
+  putString(OX,buildKey);
+
+  BuildDepend BD;
+  BD.build(System.getDataBase());
+  std::ostringstream DX;
+  BD.write(DX);
+  putString(OX,DX.str());
+
+  // MATERIALS [by name so mixtures can be recreated]
+  const ModelSupport::DBMaterial& DB=
+    ModelSupport::DBMaterial::Instance();
+  std::set<int> matActive=System.getActiveMaterial();
+  matActive.erase(0);
+  putValue<size_t>(OX,matActive.size());
+  for(const int matID : matActive)
+    {
+      putValue<int>(OX,matID);
+      putString(OX,DB.getKey(matID));
+    }
+  
+  // SURFACES [written at full precision]
+  masterWrite& MW=masterWrite::Instance();
+  const size_t sigFig=MW.getSigFig();
+  MW.setSigFig(17);
+  
+  const ModelSupport::surfIndex::STYPE& SurMap=
+    ModelSupport::surfIndex::Instance().surMap();
+  putValue<size_t>(OX,SurMap.size());
+  for(const auto& [surfN,SPtr] : SurMap)
+    {
+      std::ostringstream cx;
+      cx.precision(17);
+      SPtr->write(cx);
+      std::string Line=StrFunc::fullBlock(cx.str());
+      int nx;
+      StrFunc::section(Line,nx);
+      if (SPtr->getTrans()>0)
+	StrFunc::section(Line,nx);
+      putValue<int>(OX,surfN);
+      putValue<int>(OX,SPtr->getTrans());
+      putString(OX,Line);
+    }
+  MW.setSigFig(sigFig);
+
+  // CELL ZONES [flagged if owned by a component]
+  const objectGroups::cMapTYPE& CMap=System.getComponents();
+  std::set<std::string> compKeys;
+  for(const auto& [name,FCPtr] : CMap)
+    compKeys.insert(FCPtr->getKeyName());
+  
+  const objectGroups::RTYPE& RMap=System.getRangeMap();
+  putValue<size_t>(OX,RMap.size());
+  for(const auto& [zone,name] : RMap)
+    {
+      putValue<int>(OX,zone);
+      putValue<int>(OX,(compKeys.find(name)!=compKeys.end()) ? 1 : 0);
+      putString(OX,name);
+    }
+
+  // COMPONENTS
+  putValue<size_t>(OX,CMap.size());
+  for(const auto& [name,FCPtr] : CMap)
+    {
+      putString(OX,name);
+      putString(OX,FCPtr->getKeyName());
+      putVec3D(OX,FCPtr->getCentre());
+      putVec3D(OX,FCPtr->getX());
+      putVec3D(OX,FCPtr->getY());
+      putVec3D(OX,FCPtr->getZ());
+
+      const std::map<std::string,size_t>& KMap=FCPtr->getKeyMap();
+      putValue<size_t>(OX,KMap.size());
+      for(const auto& [keyName,index] : KMap)
+	{
+	  putString(OX,keyName);
+	  putValue<size_t>(OX,index);
+	}
+      
+      putValue<size_t>(OX,FCPtr->NConnect());
+      for(size_t i=0;i<FCPtr->NConnect();i++)
+	{
+	  const attachSystem::LinkUnit& LU=FCPtr->getLU(i);
+	  const int flag((LU.hasAxis() ? 1 : 0) + (LU.hasConnectPt() ? 2 : 0));
+	  putValue<int>(OX,flag);
+	  putVec3D(OX,(LU.hasAxis()) ? LU.getAxis() : Geometry::Vec3D());
+	  putVec3D(OX,(LU.hasConnectPt()) ?
+		   LU.getConnectPt() : Geometry::Vec3D());
+	  putValue<int>(OX,LU.getLinkSurfNumber());
+	  putRule(OX,LU.getMainRule());
+	  putRule(OX,LU.getCommonRule());
+	}
+
+      const attachSystem::ContainedComp* CCPtr=
+	dynamic_cast<const attachSystem::ContainedComp*>(FCPtr.get());
+      putRule(OX,(CCPtr) ? CCPtr->getOuterSurf() : HeadRule());
+      putBaseMap(OX,dynamic_cast<const attachSystem::CellMap*>(FCPtr.get()));
+      putBaseMap(OX,dynamic_cast<const attachSystem::SurfMap*>(FCPtr.get()));
+    }
+  
+  // CELLS
+  const Simulation::OTYPE& OList=System.getCells();
+  putValue<size_t>(OX,OList.size());
+  for(const auto& [cellN,OPtr] : OList)
+    {
+      putValue<int>(OX,cellN);
+      putValue<int>(OX,OPtr->getMatID());
+      putValue<double>(OX,OPtr->getTemp());
+      putValue<int>(OX,OPtr->getImp());
+      putString(OX,OPtr->getFCUnit());
+      putRule(OX,OPtr->getHeadRule());
+    }
+  
+  OX.close();
+  if (!OX)
+    throw ColErr::FileError(0,FName,"Snapshot not written");
+  return;
+}
+
+}  // NAMESPACE ModelSupport
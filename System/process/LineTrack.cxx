@@ -173,9 +173,8 @@ LineTrack::calculate(const Simulation& ASim)
   MonteCarlo::Object* OPtr=ASim.findCell(InitPt+
 					 (EndPt-InitPt).unit()*1e-5,0);
 
-  if (!OPtr)
-    ColErr::InContainerError<Geometry::Vec3D>
-      (InitPt,"Initial point not in model");
+  // Initial point not in model : no track
+  if (!OPtr) return;
 
   int SN=OPtr->isOnSide(InitPt);
   while(OPtr)
@@ -94,6 +94,7 @@ createInputs(inputParam& IParam)
   IParam.regFlag("cinder","cinder");
   IParam.regItem("cellDNF","cellDNF");
   IParam.regItem("cellCNF","cellCNF");
+  IParam.regFlag("cellIndex","cellIndex");
   IParam.regItem("d","debug");
   IParam.regItem("dbcn","dbcn");
   IParam.regItem("defaultConfig","defaultConfig");
@@ -135,8 +136,11 @@ createInputs(inputParam& IParam)
   IParam.regDefItem<std::string>("print","printTable",1,
 				 "10 20 40 50 110 120");  
   IParam.regItem("PTRAC","ptrac");
+  IParam.regItem("profile","profile");
 
   IParam.regItem("r","renum");
+  IParam.regItem("snapshot","snapshot");
+  IParam.regItem("sweep","sweep",1,2);
   IParam.regMulti("report","report",1000,0);
   IParam.regDefItem<std::string>("physModel","physicsModel",1,"CEM03"); 
 
@@ -159,6 +163,7 @@ createInputs(inputParam& IParam)
   IParam.regFlag("TW","tallyWeight");
   IParam.regItem("TX","Txml",1);
   IParam.regItem("targetType","targetType",1);
+  IParam.regItem("threads","threads");
   IParam.regDefItem<int>("u","units",1,0);
   IParam.regItem("validCheck","validCheck",1);
   IParam.regItem("validAll","validAll",0);
@@ -263,6 +268,8 @@ createInputs(inputParam& IParam)
   IParam.setDesc("ObjAdd","Add a component (cell)");
   IParam.setDesc("photon","Photon Cut energy");
   IParam.setDesc("photonModel","Photon Model Energy [min]");
+  IParam.setDesc("profile","Time the registered methods and write "
+		 "folded stacks [file] and a summary [file.sum] at exit");
   IParam.setDesc("r","Renubmer cells");
   IParam.setDesc("report","Report a position/axis (show info on points etc)");
   IParam.setDesc("s","RND Seed");
@@ -282,6 +289,10 @@ createInputs(inputParam& IParam)
   IParam.setDesc("TGrid","Set a grid on a point tally [tallyN NXpts NZPts]");
   IParam.setDesc("TW","Activate tally pd weight system");
   IParam.setDesc("Txml","Tally xml file");
+  IParam.setDesc("snapshot","Geometry snapshot file [reused if the "
+		 "variables and build options are unchanged]");
+  IParam.setDesc("sweep","Build a deck for each row of a variable "
+		 "table [file.csv nProcess]");
   IParam.setDesc("targetType","Name of target type");
   IParam.setDesc("u","Units in cm");
   IParam.setDesc("um","Unset spherical void area (from imp=0)");
@@ -292,10 +303,13 @@ createInputs(inputParam& IParam)
   IParam.setDesc("volCard","set/delete the vol card");
   IParam.setDesc("vtk","Write out VTK plot mesh");
   IParam.setDesc("vtkMesh","Define mesh for MD5/VTK");
+  IParam.setDesc("vtkType","VTK value [cell / overlap : cells at point]");
   IParam.setDesc("vmat","Material sections to be written by vtk output");
   IParam.setDesc("VN","Number of points in the volume integration");
   IParam.setDesc("validCheck","Run simulation to check for validity");
   IParam.setDesc("validPoint","Point to start valid check from");
+  IParam.setDesc("validAll","Check from all components/cells "
+		 "[reportFile seed]");
 
   IParam.setDesc("w","weightBias");
   IParam.setDesc("wExt","Extraction biasisng [see: -wExt help]");
@@ -32,6 +32,7 @@
 #include <string>
 #include <iterator>
 #include <memory>
+#include <functional>
 
 #include <boost/format.hpp>
 
@@ -47,6 +48,7 @@
 #include "varList.h"
 #include "Code.h"
 #include "FuncDataBase.h"
+#include "MD5hash.h"
 #include "InputControl.h"
 #include "inputParam.h"
 #include "support.h"
@@ -83,8 +85,10 @@
 #include "ObjectAddition.h"
 #include "MaterialUpdate.h"
 #include "World.h"
+#include "GeomSnapshot.h"
 
 #include "MainProcess.h"
+#include "ParallelRun.h"
 
 #include "surfRegister.h"
 #include "HeadRule.h"
@@ -427,6 +431,14 @@ createSimulation(inputParam& IParam,
   SimPtr->setCellDNF(IParam.getDefValue<size_t>(0,"cellDNF"));
   // CNF split the cells
   SimPtr->setCellCNF(IParam.getDefValue<size_t>(0,"cellCNF"));
+  // Spatial index for findCell
+  SimPtr->setCellIndex(IParam.flag("cellIndex"));
+  // Call profile [before any threads are started]
+  if (IParam.flag("profile"))
+    ELog::NameStack::setProfile(IParam.getValue<std::string>("profile"));
+  // Threads for the point/track queries [0 : all cores]
+  ModelSupport::ParallelRun::Instance().setThreads
+    (IParam.getDefValue<size_t>(1,"threads"));
 
   SimPtr->setCmdLine(cmdLine.str());        // set full command line
   
@@ -534,7 +546,6 @@ buildFullSimFLUKA(SimFLUKA* SimFLUKAPtr,
   ELog::RegMethod RegA("MainProcess[F]","buildFullSimFLUKA");
 
   // Definitions section 
-  int MCIndex(0);
   const int multi=IParam.getValue<int>("multi");
   if (IParam.flag("noVariables"))
     SimFLUKAPtr->setNoVariables();
@@ -553,12 +564,7 @@ buildFullSimFLUKA(SimFLUKA* SimFLUKAPtr,
   //  SimFLUKAPtr->masterSourceRotation();
   // Ensure we done loop
 
-  do
-    {
-      SimProcess::writeIndexSimFLUKA(*SimFLUKAPtr,OName,MCIndex);
-      MCIndex++;
-    }
-  while(MCIndex<multi);
+  SimProcess::writeMultiSimFLUKA(*SimFLUKAPtr,OName,multi);
 
   return;
 }
@@ -578,7 +584,6 @@ buildFullSimPHITS(SimPHITS* SimPHITSPtr,
   ELog::RegMethod RegA("MainProcess[F]","buildFullSimPHITS");
 
   // Definitions section
-  int MCIndex(0);
   const int multi=IParam.getValue<int>("multi");
 
   ModelSupport::setDefaultPhysics(*SimPHITSPtr,IParam);
@@ -595,12 +600,7 @@ buildFullSimPHITS(SimPHITS* SimPHITSPtr,
   //  SimPHITSPtr->masterSourceRotation();
   // Ensure we done loop
   
-  do
-    {
-      SimProcess::writeIndexSimPHITS(*SimPHITSPtr,OName,MCIndex);
-      MCIndex++;
-    }
-  while(MCIndex<multi);
+  SimProcess::writeMultiSimPHITS(*SimPHITSPtr,OName,multi);
 
   return;
 }
@@ -618,7 +618,6 @@ buildFullSimMCNP(SimMCNP* SimMCPtr,
    */
 {
   // Definitions section 
-  int MCIndex(0);
   const int multi=IParam.getValue<int>("multi");
 
   
@@ -637,12 +636,7 @@ buildFullSimMCNP(SimMCNP* SimMCPtr,
   SDef::sourceSelection(*SimMCPtr,IParam);
   //  SimMCPtr->masterSourceRotation();
   // Ensure we done loop
-  do
-    {
-      SimProcess::writeIndexSim(*SimMCPtr,OName,MCIndex);
-      MCIndex++;
-    }
-  while(MCIndex<multi);
+  SimProcess::writeMultiSim(*SimMCPtr,OName,multi);
 
   return;
 }
@@ -671,6 +665,80 @@ buildFullSimPOVRay(SimPOVRay* SimPOVRayPtr,
   return;
 }
 
+std::string
+snapshotKey(const mainSystem::inputParam& IParam,
+	    const std::vector<std::string>& buildOpt)
+  /*!
+    Key of a geometry build for the snapshot. It is a hash of
+    the options read by the model build. The variables are
+    checked against the BuildDepend record of the snapshot.
+    \param IParam :: input parameter
+    \param buildOpt :: Options read by the model build
+    \return key string
+  */
+{
+  ELog::RegMethod RegA("MainProcess[F]","snapshotKey");
+
+  if (!IParam.flag("snapshot"))
+    return "";
+
+  std::ostringstream cx;
+  for(const std::string& KName : buildOpt)
+    {
+      cx<<"-"<<KName;
+      if (IParam.hasKey(KName) && IParam.flag(KName))
+	for(size_t i=0;i<IParam.setCnt(KName);i++)
+	  cx<<" ["<<IParam.getFull(KName,i)<<"]";
+      cx<<"\n";
+    }
+  MD5hash sum;
+  return sum.processMessage(cx.str());
+}
+
+bool
+restoreSnapshot(Simulation& System,
+		const mainSystem::inputParam& IParam,
+		const std::string& buildKey)
+  /*!
+    Restore the geometry from a snapshot if the snapshot
+    was built with the same key
+    \param System :: Simulation [no components]
+    \param IParam :: input parameter
+    \param buildKey :: Key of this build [snapshotKey]
+    \return true if the geometry was restored
+  */
+{
+  ELog::RegMethod RegA("MainProcess[F]","restoreSnapshot");
+
+  if (!IParam.flag("snapshot"))
+    return 0;
+  const ModelSupport::GeomSnapshot
+    SnapObj(IParam.getValue<std::string>("snapshot"),buildKey);
+  return SnapObj.read(System);
+}
+
+void
+saveSnapshot(const Simulation& System,
+	     const mainSystem::inputParam& IParam,
+	     const std::string& buildKey)
+  /*!
+    Write the built geometry to the snapshot file
+    \param System :: Simulation after the build
+    \param IParam :: input parameter
+    \param buildKey :: Key of this build [snapshotKey]
+  */
+{
+  ELog::RegMethod RegA("MainProcess[F]","saveSnapshot");
+
+  if (IParam.flag("snapshot"))
+    {
+      const ModelSupport::GeomSnapshot
+	SnapObj(IParam.getValue<std::string>("snapshot"),buildKey);
+      SnapObj.write(System);
+    }
+  return;
+}
+
 void
 buildFullSimulation(Simulation* SimPtr,
                     const mainSystem::inputParam& IParam,
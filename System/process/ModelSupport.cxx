@@ -33,7 +33,20 @@
 #include <algorithm>
 #include <utility>
 
+#include "Exception.h"
+#include "FileReport.h"
+#include "NameStack.h"
+#include "RegMethod.h"
+#include "GTKreport.h"
+#include "OutputLog.h"
+#include "BaseVisit.h"
+#include "BaseModVisit.h"
 #include "support.h"
+#include "MatrixBase.h"
+#include "Matrix.h"
+#include "Vec3D.h"
+#include "Rules.h"
+#include "HeadRule.h"
 #include "surfRegister.h"
 #include "ModelSupport.h"
 
@@ -508,6 +521,163 @@ getComposite(const surfRegister& SMap,
     getComposite(SMap,Offset,surfNC);
 }
 
+/*!
+  \struct ruleTemplate
+  \brief Parsed getComposite string 
+
+  Each number in the string is replaced by its index [1-N]
+  in the rule, so the offset surfaces can be substituted without
+  writing/parsing a string.
+*/
+struct ruleTemplate
+{
+  HeadRule rule;               ///< Rule with index keys
+  std::vector<int> baseNum;    ///< Signed number in the string
+  std::vector<char> offsetType;  ///< Offset type [' '/T/M/N] 
+};
+
+static const ruleTemplate&
+getRuleTemplate(const std::string& baseString)
+  /*!
+    Get the template of a composite string [cached]
+    \param baseString :: composite string
+    \return template 
+  */
+{
+  ELog::RegMethod RegA("ModelSupport[F]","getRuleTemplate");
+  
+  // Max number of templates held 
+  const size_t maxTemplate(16384);
+  static thread_local std::map<std::string,ruleTemplate> templateMap;
+
+  std::map<std::string,ruleTemplate>::const_iterator mc=
+    templateMap.find(baseString);
+  if (mc!=templateMap.end())
+    return mc->second;
+
+  if (templateMap.size()>=maxTemplate)
+    templateMap.clear();
+  
+  ruleTemplate RT;
+  std::ostringstream cx;
+  std::string segment=spcDelimString(baseString);
+  std::string OutUnit;
+  int cellN;
+  while(StrFunc::section(segment,OutUnit))
+    {
+      const size_t oL=OutUnit.length();
+      if (oL)
+	{
+	  char oType(' ');
+	  if (OutUnit[oL-1]=='T' || OutUnit[oL-1]=='M' ||
+	      OutUnit[oL-1]=='N')
+	    {
+	      oType=OutUnit[oL-1];
+	      OutUnit[oL-1]=' ';
+	    }
+	  if (StrFunc::convert(OutUnit,cellN))
+	    {
+	      RT.baseNum.push_back(cellN);
+	      RT.offsetType.push_back(oType);
+	      cx<<RT.baseNum.size()<<" ";
+	    }
+	  else
+	    cx<<OutUnit<<" ";
+	}
+    }
+  if (!StrFunc::isEmpty(cx.str()) && !RT.rule.procString(cx.str()))
+    throw ColErr::InvalidLine(baseString,"Composite string",0);
+
+  return templateMap.emplace(baseString,RT).first->second;
+}
+
+HeadRule
+getHeadRule(const surfRegister& SMap,const int SOffset,
+	    const int SminorOffset,const int SsecondOffset,
+	    const std::string& baseString)
+  /*!
+    Given a base string add an offset to the numbers and
+    return the rule. This is the same as the getComposite string
+    [M/N/T suffix] but the string is only parsed on
+    the first call.
+    \param SMap :: Surf register 
+    \param SOffset :: Offset nubmer to add
+    \param SminorOffset :: minor Offset nubmer to add [M]
+    \param SsecondOffset :: second Offset nubmer to add [N]
+    \param baseString :: BaseString number
+    \return HeadRule with offset components
+   */
+{
+  const ruleTemplate& RT=getRuleTemplate(baseString);
+  
+  const int Offset((SOffset<0) ? -SOffset : SOffset);
+  const int signV((SOffset<0) ? -1 : 1); 
+  const int minorOffset((SminorOffset<0) ? -SminorOffset : SminorOffset);
+  const int minorSignV((SminorOffset<0) ? -1 : 1); 
+  const int secondOffset((SsecondOffset<0) ? -SsecondOffset : SsecondOffset);
+  const int secondSignV((SsecondOffset<0) ? -1 : 1); 
+
+  std::vector<int> surfN(RT.baseNum.size());
+  for(size_t i=0;i<RT.baseNum.size();i++)
+    {
+      const int cellN(RT.baseNum[i]);
+      switch (RT.offsetType[i])
+	{
+	case 'T':
+	  surfN[i]=SMap.realSurf(cellN);
+	  break;
+	case 'M':
+	  surfN[i]=(cellN>0) ?
+	    minorSignV*SMap.realSurf(cellN+minorOffset) :
+	    minorSignV*SMap.realSurf(cellN-minorOffset);
+	  break;
+	case 'N':
+	  surfN[i]=(cellN>0) ?
+	    secondSignV*SMap.realSurf(cellN+secondOffset) :
+	    secondSignV*SMap.realSurf(cellN-secondOffset);
+	  break;
+	default:
+	  surfN[i]=(cellN>0) ?
+	    signV*SMap.realSurf(cellN+Offset) :
+	    signV*SMap.realSurf(cellN-Offset);
+	}
+    }
+  
+  HeadRule Out(RT.rule);
+  Out.substituteTemplate(surfN);
+  return Out;
+}
+
+HeadRule
+getHeadRule(const surfRegister& SMap,const int SOffset,
+	    const int SminorOffset,const std::string& baseString)
+  /*!
+    Given a base string add an offset to the numbers
+    \param SMap :: Surf register 
+    \param SOffset :: Offset nubmer to add
+    \param SminorOffset :: minor Offset nubmer to add [M]
+    \param baseString :: BaseString number
+    \return HeadRule with offset components
+   */
+{
+  return getHeadRule(SMap,SOffset,SminorOffset,0,baseString);
+}
+
+HeadRule
+getHeadRule(const surfRegister& SMap,const int Offset,
+	    const std::string& baseString)
+  /*!
+    Given a base string add an offset to the numbers.
+    If a number is trailed by T then it is a true number.
+    \param SMap :: Surf register 
+    \param Offset :: Offset nubmer to add
+    \param baseString :: BaseString number
+    \return HeadRule with offset components
+   */
+{
+  return getHeadRule(SMap,Offset,Offset,0,baseString);
+}
+
 std::string
 getSeqIntersection(int A,int B,int step)
   /*!
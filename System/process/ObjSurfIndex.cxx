@@ -0,0 +1,99 @@
+/*********************************************************************
+  CombLayer : MCNP(X) Input builder
+
+ * File:   process/ObjSurfIndex.cxx
+ *
+ * Copyright (c) 2004-2019 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ****************************************************************************/
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <cmath>
+#include <complex>
+#include <vector>
+#include <set>
+#include <map>
+#include <string>
+#include <algorithm>
+#include <memory>
+
+#include "Exception.h"
+#include "FileReport.h"
+#include "NameStack.h"
+#include "RegMethod.h"
+#include "GTKreport.h"
+#include "OutputLog.h"
+#include "BaseVisit.h"
+#include "BaseModVisit.h"
+#include "MatrixBase.h"
+#include "Matrix.h"
+#include "Vec3D.h"
+#include "Rules.h"
+#include "HeadRule.h"
+#include "Object.h"
+#include "ObjSurfIndex.h"
+
+namespace ModelSupport
+{
+
+ObjSurfIndex::ObjSurfIndex
+  (const std::map<int,std::vector<MonteCarlo::Object*>>& SMap)
+  /*!
+    Constructor : calculates the box of each object 
+    \param SMap :: Signed surface : objects [ObjSurfMap]
+  */
+{
+  ELog::RegMethod RegA("ObjSurfIndex","constructor");
+
+  for(const auto& [SN,OVec] : SMap)
+    {
+      std::vector<candItem>& CVec=candMap[SN];
+      CVec.resize(OVec.size());
+      for(size_t i=0;i<OVec.size();i++)
+	{
+	  CVec[i].OPtr=OVec[i];
+	  OVec[i]->getBoundBox(CVec[i].LowPt,CVec[i].HighPt);
+	}
+    }
+}
+
+MonteCarlo::Object*
+ObjSurfIndex::findNextObject(const int SN,const Geometry::Vec3D& Pos,
+			     const int objExclude) const
+  /*!
+    Find the object on the other side of the surface.
+    The objects are tested in map order [the first valid 
+    object is returned]. Objects whose box does not contain
+    the point are not tested.
+    \param SN :: Signed surface number
+    \param Pos :: Position [on the surface]
+    \param objExclude :: Excluded object
+    \return Next Object Ptr / 0 on point not valid
+  */
+{
+  std::map<int,std::vector<candItem>>::const_iterator mc=
+    candMap.find(SN);
+  if (mc==candMap.end()) return 0;
+
+  for(const candItem& CI : mc->second)
+    if (CI.OPtr->getName()!=objExclude && CI.inBox(Pos) &&
+	CI.OPtr->isDirectionValid(Pos,SN))
+      return CI.OPtr;
+  return 0;
+}
+
+} // NAMESPACE ModelSupport
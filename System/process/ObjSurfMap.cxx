@@ -54,6 +54,7 @@
 #include "surfEqual.h"
 #include "localRotate.h"
 #include "masterRotate.h"
+#include "ObjSurfIndex.h"
 #include "ObjSurfMap.h"
 
 #include "debugMethod.h"
@@ -84,16 +85,17 @@ ObjSurfMap::removeEqualSurf(const std::map<int,Geometry::Surface*>& EQMap,
   return;
 }
 
-ObjSurfMap::ObjSurfMap() 
+ObjSurfMap::ObjSurfMap() :
+  IPtr(0)
  /*! 
    Constructor 
  */
 {}
 
 ObjSurfMap::ObjSurfMap(const ObjSurfMap& A) :
-  SMap(A.SMap),OSurfMap(A.OSurfMap)
+  SMap(A.SMap),OSurfMap(A.OSurfMap),IPtr(0)
   /*! 
-    Copy Constructor 
+    Copy Constructor [index is not copied]
     \param A :: ObjSurfMap to copy
   */
 {}
@@ -108,23 +110,59 @@ ObjSurfMap::operator=(const ObjSurfMap& A)
 {
   if (this!=&A)
     {
+      clearIndex();
       SMap=A.SMap;
       OSurfMap=A.OSurfMap;
     }
   return *this;
 }
 
+ObjSurfMap::~ObjSurfMap()
+  /*!
+    Destructor
+  */
+{
+  delete IPtr;
+}
+
 void
 ObjSurfMap::clearAll()
   /*!
     Clears all the data
   */
 {
+  clearIndex();
   SMap.clear();
   OSurfMap.clear();
   return;
 }
 
+void
+ObjSurfMap::clearIndex()
+  /*!
+    Remove the index after a change of the map
+  */
+{
+  delete IPtr;
+  IPtr=0;
+  return;
+}
+
+void
+ObjSurfMap::buildIndex()
+  /*!
+    Build the boxed candidates of each surface used
+    by findNextObject. Must be called after the map 
+    is complete [it is removed by any change]
+  */
+{
+  ELog::RegMethod RegA("ObjSurfMap","buildIndex");
+
+  clearIndex();
+  IPtr=new ObjSurfIndex(SMap);
+  return;
+}
+
 MonteCarlo::Object* 
 ObjSurfMap::getObj(const int SNum,const size_t Index) const
   /*!
@@ -166,6 +204,7 @@ ObjSurfMap::addSurfaces(MonteCarlo::Object* OPtr)
 {
   ELog::RegMethod RegA("ObjSurfMap","addSurfaces");
   
+  clearIndex();
   // signed set
   const std::set<int>& sSet=OPtr->getSurfSet();
 
@@ -262,11 +301,19 @@ ObjSurfMap::findNextObject(const int SN,
 
   const STYPE& MVec=getObjects(SN);
 
-  for(MonteCarlo::Object* MPtr : MVec)
+  if (IPtr)
+    {
+      MonteCarlo::Object* MPtr=IPtr->findNextObject(SN,Pos,objExclude);
+      if (MPtr) return MPtr;
+    }
+  else
     {
-      if (MPtr->getName()!=objExclude && 
-	  MPtr->isDirectionValid(Pos,SN))
-	return MPtr;
+      for(MonteCarlo::Object* MPtr : MVec)
+	{
+	  if (MPtr->getName()!=objExclude && 
+	      MPtr->isDirectionValid(Pos,SN))
+	    return MPtr;
+	}
     }
   
   // DEBUG CODE FOR FAILURE:
@@ -307,6 +354,7 @@ ObjSurfMap::removeReverseSurf(const int primSurf,const int revSurf)
 {
   ELog::RegMethod RegA("ObjSurfMap","removeReverseSurf");
   
+  clearIndex();
   // Remove reverse surface from maps: [+ve]
   
   for(int sign_index=-1;sign_index<2;sign_index+=2)
@@ -339,6 +387,7 @@ ObjSurfMap::removeObject(const MonteCarlo::Object* OPtr)
 {
   ELog::RegMethod Rega("ObjSurfMap","removeObject");
 
+  clearIndex();
   const int cellNumber(OPtr->getName());
   
   OSTYPE::iterator mc=OSurfMap.find(cellNumber);
@@ -0,0 +1,200 @@
+/*********************************************************************
+  CombLayer : MCNP(X) Input builder
+
+ * File:   process/ParallelRun.cxx
+ *
+ * Copyright (c) 2004-2019 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ****************************************************************************/
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <cmath>
+#include <vector>
+#include <map>
+#include <string>
+#include <algorithm>
+#include <functional>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <exception>
+
+#include "Exception.h"
+#include "FileReport.h"
+#include "NameStack.h"
+#include "RegMethod.h"
+#include "GTKreport.h"
+#include "OutputLog.h"
+#include "MersenneTwister.h"
+#include "ParallelRun.h"
+
+namespace ModelSupport
+{
+
+const size_t ParallelRun::blockSize(4096);
+
+ParallelRun::ParallelRun() :
+  nThread(1)
+  /*!
+    Constructor
+  */
+{}
+
+ParallelRun&
+ParallelRun::Instance()
+  /*!
+    Singleton this
+    \return ParallelRun object
+   */
+{
+  static ParallelRun PR;
+  return PR;
+}
+
+void
+ParallelRun::setThreads(const size_t N)
+  /*!
+    Set the number of threads
+    \param N :: Number of threads [0 for all the cores]
+  */
+{
+  ELog::RegMethod RegA("ParallelRun","setThreads");
+  
+  nThread=N;
+  if (!nThread)
+    {
+      nThread=std::thread::hardware_concurrency();
+      if (!nThread) nThread=1;
+    }
+  if (nThread>1)
+    ELog::EM<<"Parallel queries on "<<nThread<<" threads"<<ELog::endDiag;
+  return;
+}
+
+size_t
+ParallelRun::nBlocks(const size_t N)
+  /*!
+    Number of random blocks needed for N samples
+    \param N :: Number of samples
+    \return number of blocks
+  */
+{
+  return (N+blockSize-1)/blockSize;
+}
+
+size_t
+ParallelRun::blockStart(const size_t index,const size_t N)
+  /*!
+    First sample in a block
+    \param index :: block index
+    \param N :: Number of samples
+    \return first sample
+  */
+{
+  return std::min(index*blockSize,N);
+}
+
+size_t
+ParallelRun::blockEnd(const size_t index,const size_t N)
+  /*!
+    One past the last sample in a block
+    \param index :: block index
+    \param N :: Number of samples
+    \return end sample
+  */
+{
+  return std::min((index+1)*blockSize,N);
+}
+
+std::vector<unsigned int>
+ParallelRun::blockSeeds(MTRand& RX,const size_t NBlock)
+  /*!
+    Get a seed for each block from the main generator
+    \param RX :: Main random number generator
+    \param NBlock :: Number of blocks
+    \return seeds
+  */
+{
+  std::vector<unsigned int> Out(NBlock);
+  for(unsigned int& seedValue : Out)
+    seedValue=RX.randInt();
+  return Out;
+}
+
+void
+ParallelRun::run(const size_t NItem,
+		 const std::function<void(const size_t)>& workUnit) const
+  /*!
+    Run the work items over the threads. If an item 
+    throws no further items are started and the exception
+    of the lowest item is re-thrown.
+    \param NItem :: Number of items
+    \param workUnit :: Function to process an item
+  */
+{
+  ELog::RegMethod RegA("ParallelRun","run");
+
+  const size_t NT=std::min(nThread,NItem);
+  if (NT<2)
+    {
+      for(size_t i=0;i<NItem;i++)
+	workUnit(i);
+      return;
+    }
+
+  std::atomic<size_t> nextItem(0);
+  std::atomic<bool> failFlag(0);
+  std::mutex errorLock;
+  size_t errorItem(NItem);
+  std::exception_ptr errorPtr;
+
+  std::function<void()> worker=[&]()
+    {
+      ELog::quietThread=1;
+      size_t index;
+      while(!failFlag && (index=nextItem++)<NItem)
+	{
+	  try
+	    {
+	      workUnit(index);
+	    }
+	  catch(...)
+	    {
+	      std::lock_guard<std::mutex> lockA(errorLock);
+	      if (index<errorItem)
+		{
+		  errorItem=index;
+		  errorPtr=std::current_exception();
+		}
+	      failFlag=1;
+	    }
+	}
+    };
+
+  std::vector<std::thread> threadVec;
+  for(size_t i=0;i<NT;i++)
+    threadVec.push_back(std::thread(worker));
+  for(std::thread& TX : threadVec)
+    TX.join();
+
+  if (errorPtr)
+    std::rethrow_exception(errorPtr);
+  return;
+}
+
+} // NAMESPACE ModelSupport
@@ -0,0 +1,141 @@
+/*********************************************************************
+  CombLayer : MCNP(X) Input builder
+
+ * File:   process/QueryContext.cxx
+ *
+ * Copyright (c) 2004-2019 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ****************************************************************************/
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <cmath>
+#include <complex>
+#include <list>
+#include <vector>
+#include <set>
+#include <map>
+#include <string>
+#include <algorithm>
+#include <memory>
+
+#include "Exception.h"
+#include "FileReport.h"
+#include "NameStack.h"
+#include "RegMethod.h"
+#include "GTKreport.h"
+#include "OutputLog.h"
+#include "MersenneTwister.h"
+#include "BaseVisit.h"
+#include "BaseModVisit.h"
+#include "MatrixBase.h"
+#include "Matrix.h"
+#include "Vec3D.h"
+#include "varList.h"
+#include "Code.h"
+#include "FuncDataBase.h"
+#include "HeadRule.h"
+#include "Object.h"
+#include "groupRange.h"
+#include "objectGroups.h"
+#include "Simulation.h"
+#include "QueryContext.h"
+
+namespace ModelSupport
+{
+
+const size_t QueryContext::blockSize(64);
+
+QueryContext::QueryContext(const Simulation& System,
+			   const unsigned int seedValue) :
+  System(System),RNG(seedValue),lastCell(0)
+  /*!
+    Constructor
+    \param System :: Simulation to query
+    \param seedValue :: Seed for the random number generator
+  */
+{}
+
+QueryContext::QueryContext(const QueryContext& A) :
+  System(A.System),RNG(A.RNG),lastCell(A.lastCell)
+  /*!
+    Copy constructor
+    \param A :: QueryContext to copy
+  */
+{}
+
+void
+QueryContext::seed(const unsigned int seedValue)
+  /*!
+    Reseed the generator [and clear the cell]
+    \param seedValue :: Seed for the random number generator
+  */
+{
+  RNG.seed(seedValue);
+  lastCell=0;
+  return;
+}
+
+MonteCarlo::Object*
+QueryContext::findCell(const Geometry::Vec3D& Pt)
+  /*!
+    Find the cell of a point starting from the last cell found
+    \param Pt :: Point to find
+    \return Object / 0 if not found
+  */
+{
+  lastCell=System.findCell(Pt,lastCell);
+  return lastCell;
+}
+
+void
+QueryContext::findCellBlock(const Geometry::Vec3D* Pts,const size_t N,
+			    MonteCarlo::Object** Out)
+  /*!
+    Find the cells of a line of close points [mesh row].
+    The following points are tested in blocks of at most
+    blockSize against the last cell and only the first point 
+    not in it is found by findCell. The result is the same 
+    as calling findCell for each point in turn.
+    \param Pts :: Points to find
+    \param N :: Number of points
+    \param Out :: Object of each point / 0 if not found (size N)
+  */
+{
+  std::vector<char> valid(blockSize);
+  size_t i(0);
+  while(i<N)
+    {
+      // extend the run of the last cell a block at a time
+      while(lastCell && i<N)
+	{
+	  const size_t NB(std::min(blockSize,N-i));
+	  lastCell->isValidBlock(Pts+i,NB,valid.data());
+	  size_t j(0);
+	  for(;j<NB && valid[j];j++)
+	    Out[i+j]=lastCell;
+	  i+=j;
+	  if (j!=NB) break;
+	}
+      if (i==N) break;
+      lastCell=System.findCell(Pts[i],lastCell);
+      Out[i++]=lastCell;
+    }
+  return;
+}
+
+} // NAMESPACE ModelSupport
@@ -153,16 +153,25 @@ processExitChecks(Simulation& System,
 	}
       else if (IParam.flag("validAll"))
 	{
-	  // This should work BUT never does
+	  // -validAll [reportFile] [seed]
 	  const size_t NPts=IParam.getValue<size_t>("validCheck");
-	  typedef objectGroups::cMapTYPE CM;
-	  const CM& mapFC=System.getComponents();
-	  for(const CM::value_type& mc : mapFC)
+	  const std::string reportFile=
+	    IParam.getDefValue<std::string>("","validAll",0);
+	  const unsigned int seed=
+	    IParam.getDefValue<unsigned int>(12345,"validAll",1);
+	  if (SValidCheck.runAll(System,NPts,seed))
 	    {
-	      const attachSystem::FixedComp& FC = *(mc.second);
-	      const Geometry::Vec3D& CP=FC.getCentre();
-	      if (SValidCheck.runPoint(System,CP,NPts))
-		  errFlag += -1;
+	      errFlag += -1;
+	      if (reportFile.empty())
+		{
+		  SValidCheck.writeFails(ELog::EM.Estream());
+		  ELog::EM<<ELog::endCrit;
+		}
+	    }
+	  if (!reportFile.empty())
+	    {
+	      std::ofstream OX(reportFile.c_str());
+	      SValidCheck.writeFails(OX);
 	    }
 	}
       else 
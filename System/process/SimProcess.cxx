@@ -33,6 +33,8 @@
 #include <iterator>
 #include <memory>
 #include <array>
+#include <functional>
+#include <sstream>
 
 #include "Exception.h"
 #include "FileReport.h"
@@ -68,6 +70,7 @@
 #include "SimMCNP.h"
 #include "SimPHITS.h"
 #include "SimFLUKA.h"
+#include "ParallelRun.h"
 #include "SimProcess.h"
 
 namespace SimProcess
@@ -161,6 +164,127 @@ writeIndexSimPHITS(SimPHITS& System,const std::string& FName,
 }
 
 
+void
+writeDecks(const std::string& OName,const std::string& extension,
+	   const std::string& modelStr,
+	   const std::vector<std::string>& runStr)
+  /*!
+    Write each deck of a multi-run as the common model 
+    part followed by the run specific part. The files are
+    written in parallel.
+    \param OName :: basic filename
+    \param extension :: file extension
+    \param modelStr :: common part of each deck
+    \param runStr :: Run specific part [one per deck]
+  */
+{
+  ELog::RegMethod RegA("SimProcess[F]","writeDecks");
+
+  const ModelSupport::ParallelRun& PR=
+    ModelSupport::ParallelRun::Instance();
+
+  PR.run(runStr.size(),[&](const size_t index)
+    {
+      const std::string FName=OName+std::to_string(index+1)+extension;
+      std::ofstream OX(FName.c_str());
+      OX<<modelStr<<runStr[index];
+      OX.close();
+      if (!OX)
+	throw ColErr::FileError(0,FName,"Deck not written");
+    });
+  return;
+}
+
+void
+writeMultiSim(SimMCNP& System,const std::string& OName,const int multi)
+  /*!
+    Writes out the same decks as calling writeIndexSim for 
+    0 to multi-1. The geometry/material/tally part is written
+    once and only the physics cards (with the RND seed) are 
+    regenerated for each deck.
+    \param System :: Simuation object 
+    \param OName :: basic filename
+    \param multi :: number of decks [min 1]
+  */
+{
+  ELog::RegMethod RegA("SimProcess[F]","writeMultiSim");
+
+  const size_t NDeck((multi>1) ? static_cast<size_t>(multi) : 1);
+  physicsSystem::PhysicsCards& PC=System.getPC();
+
+  System.prepareWrite();
+  System.makeObjectsDNForCNF();
+
+  std::ostringstream cx;
+  System.writeModel(cx);
+  
+  std::vector<std::string> runStr(NDeck);
+  for(size_t i=0;i<NDeck;i++)
+    {
+      // increase the RND seed by N*10 [as writeIndexSim]
+      PC.setRND(PC.getRNDseed()+static_cast<long int>(i)*10);
+      std::ostringstream px;
+      System.writePhysics(px);
+      runStr[i]=px.str();
+    }
+  writeDecks(OName,".x",cx.str(),runStr);
+  return;
+}
+
+void
+writeMultiSimFLUKA(SimFLUKA& System,const std::string& OName,
+		   const int multi)
+  /*!
+    Writes out the same decks as calling writeIndexSimFLUKA for 
+    0 to multi-1. Only the physics/random cards are 
+    regenerated for each deck.
+    \param System :: Simuation object 
+    \param OName :: basic filename
+    \param multi :: number of decks [min 1]
+  */
+{
+  ELog::RegMethod RegA("SimProcess[F]","writeMultiSimFLUKA");
+
+  const size_t NDeck((multi>1) ? static_cast<size_t>(multi) : 1);
+
+  System.prepareWrite();
+  std::ostringstream cx;
+  System.writeModel(cx);
+
+  std::vector<std::string> runStr(NDeck);
+  for(size_t i=0;i<NDeck;i++)
+    {
+      System.setRND(System.getRNDseed()+static_cast<long int>(i)*11);
+      std::ostringstream px;
+      System.writePhysics(px);
+      px<<"STOP"<<std::endl;
+      runStr[i]=px.str();
+    }
+  writeDecks(OName,".inp",cx.str(),runStr);
+  return;
+}
+
+void
+writeMultiSimPHITS(SimPHITS& System,const std::string& OName,
+		   const int multi)
+  /*!
+    Writes out the same decks as calling writeIndexSimPHITS for 
+    0 to multi-1. The decks are identical so the deck is only 
+    written once.
+    \param System :: Simuation object 
+    \param OName :: basic filename
+    \param multi :: number of decks [min 1]
+  */
+{
+  ELog::RegMethod RegA("SimProcess[F]","writeMultiSimPHITS");
+
+  const size_t NDeck((multi>1) ? static_cast<size_t>(multi) : 1);
+  std::ostringstream cx;
+  System.writeModel(cx);
+  writeDecks(OName,".x",cx.str(),std::vector<std::string>(NDeck));
+  return;
+}
+
 template<typename T,typename U>
 T
 getDefIndexVar(const FuncDataBase& Control,
@@ -0,0 +1,307 @@
+/*********************************************************************
+  CombLayer : MCNP(X) Input builder
+
+ * File:   process/SweepRun.cxx
+ *
+ * Copyright (c) 2004-2019 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ****************************************************************************/
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <cmath>
+#include <complex>
+#include <list>
+#include <vector>
+#include <set>
+#include <map>
+#include <string>
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <cerrno>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+
+#include "Exception.h"
+#include "FileReport.h"
+#include "NameStack.h"
+#include "RegMethod.h"
+#include "GTKreport.h"
+#include "OutputLog.h"
+#include "BaseVisit.h"
+#include "BaseModVisit.h"
+#include "support.h"
+#include "MatrixBase.h"
+#include "Matrix.h"
+#include "Vec3D.h"
+#include "inputParam.h"
+#include "Rules.h"
+#include "varList.h"
+#include "Code.h"
+#include "FuncDataBase.h"
+#include "HeadRule.h"
+#include "Object.h"
+#include "groupRange.h"
+#include "objectGroups.h"
+#include "Simulation.h"
+#include "SimInput.h"
+#include "MainProcess.h"
+#include "SweepRun.h"
+
+namespace mainSystem
+{
+
+SweepRun::SweepRun(const std::string& FName,const size_t NP) :
+  nProcess(NP)
+  /*!
+    Constructor
+    \param FName :: Table file
+    \param NP :: Max number of models built at the same
+    time [0 : all the cores]
+  */
+{
+  if (!nProcess)
+    {
+      const long int NCore=sysconf(_SC_NPROCESSORS_ONLN);
+      nProcess=(NCore>0) ? static_cast<size_t>(NCore) : 1;
+    }
+  readTable(FName);
+}
+
+SweepRun::SweepRun(const SweepRun& A) :
+  nProcess(A.nProcess),varNames(A.varNames),Rows(A.Rows)
+  /*!
+    Copy constructor
+    \param A :: SweepRun to copy
+  */
+{}
+
+SweepRun&
+SweepRun::operator=(const SweepRun& A)
+  /*!
+    Assignment operator
+    \param A :: SweepRun to copy
+    \return *this
+  */
+{
+  if (this!=&A)
+    {
+      nProcess=A.nProcess;
+      varNames=A.varNames;
+      Rows=A.Rows;
+    }
+  return *this;
+}
+
+std::vector<std::string>
+SweepRun::splitLine(const std::string& Line)
+  /*!
+    Split a CSV line keeping the empty entries. Commas
+    within double quotes are not separators.
+    \param Line :: Line to split
+    \return entries [trimmed]
+  */
+{
+  std::vector<std::string> Out;
+  std::string Unit;
+  bool quote(0);
+  for(const char c : Line)
+    {
+      if (c=='\"')
+	quote=!quote;
+      else if (c==',' && !quote)
+	{
+	  Out.push_back(StrFunc::fullBlock(Unit));
+	  Unit.clear();
+	}
+      else
+	Unit+=c;
+    }
+  Out.push_back(StrFunc::fullBlock(Unit));
+  return Out;
+}
+
+void
+SweepRun::readTable(const std::string& FName)
+  /*!
+    Read the table of variables
+    \param FName :: CSV file [# for comments]
+  */
+{
+  ELog::RegMethod RegA("SweepRun","readTable");
+
+  std::ifstream IX(FName.c_str());
+  if (!IX.good())
+    throw ColErr::FileError(0,FName,"Sweep table");
+
+  varNames.clear();
+  Rows.clear();
+  std::string Line;
+  while(std::getline(IX,Line))
+    {
+      const std::string::size_type pos=Line.find('#');
+      if (pos!=std::string::npos)
+	Line.erase(pos);
+      if (StrFunc::isEmpty(Line)) continue;
+
+      const std::vector<std::string> Items=splitLine(Line);
+      if (varNames.empty())
+	{
+	  varNames=Items;
+	  continue;
+	}
+      if (Items.size()>varNames.size())
+	throw ColErr::InvalidLine("Sweep row longer than header",Line);
+
+      sweepRow RItem;
+      for(size_t i=0;i<Items.size();i++)
+	{
+	  if (Items[i].empty()) continue;
+	  if (varNames[i]=="name")
+	    RItem.name=Items[i];
+	  else if (varNames[i]=="xml")
+	    RItem.xmlFile=Items[i];
+	  else
+	    RItem.Values.emplace(varNames[i],Items[i]);
+	}
+      if (RItem.name.empty())
+	RItem.name="row"+std::to_string(Rows.size()+1);
+      Rows.push_back(RItem);
+    }
+  return;
+}
+
+int
+SweepRun::runRow(Simulation& System,const inputParam& IParam,
+		 const std::string& OName,const sweepRow& RItem,
+		 const buildTYPE& buildFunc) const
+  /*!
+    Set the variables of a row, build the model and write
+    the deck [called in the forked process]
+    \param System :: Simulation [variables set / no components]
+    \param IParam :: input parameter
+    \param OName :: Output name
+    \param RItem :: Row to build
+    \param buildFunc :: Geometry build
+    \return 0 on success
+  */
+{
+  ELog::RegMethod RegA("SweepRun","runRow");
+
+  int flag(0);
+  try
+    {
+      FuncDataBase& Control=System.getDataBase();
+      if (!RItem.xmlFile.empty())
+	Control.processXML(RItem.xmlFile);
+      setRunTimeVariable(Control,RItem.Values,
+			 std::map<std::string,std::string>());
+
+      buildFunc(System);
+      buildFullSimulation(&System,IParam,OName+"_"+RItem.name);
+      flag=SimProcess::processExitChecks(System,IParam);
+    }
+  catch (ColErr::ExitAbort& EA)
+    {
+      if (!EA.pathFlag())
+	ELog::EM<<"Exiting from "<<EA.what()<<ELog::endCrit;
+      flag=-2;
+    }
+  catch (ColErr::ExBase& A)
+    {
+      ELog::EM<<"EXCEPTION FAILURE :: "<<A.what()<<ELog::endCrit;
+      flag=-1;
+    }
+  std::cout.flush();
+  std::cerr.flush();
+  return flag;
+}
+
+int
+SweepRun::run(Simulation& System,const inputParam& IParam,
+	      const std::string& OName,const buildTYPE& buildFunc) const
+  /*!
+    Build and write a deck for each row. Each row is
+    built in a child process that shares the variables
+    of this process until it changes them. The child exits
+    without deleting its model.
+    \param System :: Simulation [variables set / no components]
+    \param IParam :: input parameter
+    \param OName :: Output name [deck is OName_rowName]
+    \param buildFunc :: Geometry build
+    \return 0 on success / -1 if any row failed
+  */
+{
+  ELog::RegMethod RegA("SweepRun","run");
+
+  const FuncDataBase& Control=System.getDataBase();
+  for(const std::string& VName : varNames)
+    if (VName!="name" && VName!="xml" && !Control.hasVariable(VName))
+      throw ColErr::InContainerError<std::string>(VName,"Sweep variable");
+
+  ELog::EM<<"Sweep of "<<Rows.size()<<" models on "
+	  <<nProcess<<" processes"<<ELog::endDiag;
+
+  std::map<pid_t,size_t> Active;      // running child : row
+  size_t nFail(0);
+  size_t index(0);
+  while(index<Rows.size() || !Active.empty())
+    {
+      if (index<Rows.size() && Active.size()<nProcess)
+	{
+	  std::cout.flush();
+	  std::cerr.flush();
+	  const pid_t pid=fork();
+	  if (pid<0)
+	    throw ColErr::ExitAbort("Sweep fork failed");
+	  if (!pid)
+	    {
+	      const int flag=
+		runRow(System,IParam,OName,Rows[index],buildFunc);
+	      _exit((flag) ? 1 : 0);
+	    }
+	  Active.emplace(pid,index);
+	  index++;
+	  continue;
+	}
+
+      int status(0);
+      const pid_t pid=waitpid(-1,&status,0);
+      if (pid<0)
+	{
+	  if (errno==EINTR) continue;
+	  throw ColErr::ExitAbort("Sweep wait failed");
+	}
+      std::map<pid_t,size_t>::iterator mc=Active.find(pid);
+      if (mc==Active.end()) continue;
+
+      const sweepRow& RItem(Rows[mc->second]);
+      if (!WIFEXITED(status) || WEXITSTATUS(status))
+	{
+	  ELog::EM<<"Sweep model "<<RItem.name<<" failed"<<ELog::endErr;
+	  nFail++;
+	}
+      else
+	ELog::EM<<"Sweep model "<<RItem.name<<" written"<<ELog::endDiag;
+      Active.erase(mc);
+    }
+  return (nFail) ? -1 : 0;
+}
+
+} // NAMESPACE mainSystem
@@ -31,6 +31,7 @@
 #include <set>
 #include <vector>
 #include <memory>
+#include <functional>
 #include <boost/format.hpp>
 
 #include "Exception.h"
@@ -67,6 +68,8 @@
 #include "SimMCNP.h"
 #include "LineTrack.h"
 #include "volUnit.h"
+#include "ParallelRun.h"
+#include "QueryContext.h"
 #include "VolSum.h"
 
 extern MTRand RNG;
@@ -310,6 +313,38 @@ VolSum::pointRun(const Simulation& System,const size_t N)
   // Note for sphere that you can use X,Y,Z in any orthogonal 
   // directiron
 
+  const ParallelRun& PR=ParallelRun::Instance();
+  if (PR.isParallel())
+    {
+      // cells found in each block : added in block order
+      const size_t NBlock=ParallelRun::nBlocks(N);
+      const std::vector<unsigned int> seeds=
+	ParallelRun::blockSeeds(RNG,NBlock);
+      std::vector<std::vector<int>> blockCells(NBlock);
+      
+      PR.run(NBlock,[&](const size_t index)
+        {
+	  QueryContext QC(System,seeds[index]);
+	  const size_t iEnd=ParallelRun::blockEnd(index,N);
+	  for(size_t i=ParallelRun::blockStart(index,N);i<iEnd;i++)
+	    {
+	      const double xR=QC.rand()-0.5;
+	      const double yR=QC.rand()-0.5;
+	      const double zR=QC.rand()-0.5;
+	      const MonteCarlo::Object* cellPtr=
+		QC.findCell(Origin+X*xR+Y*yR+Z*zR);
+	      if (cellPtr)
+		blockCells[index].push_back(cellPtr->getName());
+	    }
+	});
+      
+      for(const std::vector<int>& cellVec : blockCells)
+	for(const int CN : cellVec)
+	  addDistance(CN,1.0);
+      nTracks+=N;
+      return;
+    }
+
   for(size_t i=0;i<N;i++)
     { 
       Geometry::Vec3D Pt(Origin+
@@ -324,13 +359,14 @@ VolSum::pointRun(const Simulation& System,const size_t N)
 }
 
 Geometry::Vec3D
-VolSum::getCubePoint() const
+VolSum::getCubePoint(MTRand& RX) const
   /*!
     Get a random point on the cuboic
+    \param RX :: Random number generator
     \return surface point
   */
 {
-  double R=RNG.rand();
+  double R=RX.rand();
   double pm(0.5);
   if (R>0.5)   
     {
@@ -340,17 +376,17 @@ VolSum::getCubePoint() const
   Geometry::Vec3D Pt(Origin);
   if (R<fracX) // XY surface
     {
-      Pt+=X*(RNG.rand()-0.5)+Y*(RNG.rand()-0.5);
+      Pt+=X*(RX.rand()-0.5)+Y*(RX.rand()-0.5);
       Pt+=Z*pm;
     }
   else if (R<fracY)
     {
-      Pt+=X*(RNG.rand()-0.5)+Z*(RNG.rand()-0.5);
+      Pt+=X*(RX.rand()-0.5)+Z*(RX.rand()-0.5);
       Pt+=Y*pm;
     }
   else 
     {
-      Pt+=Y*(RNG.rand()-0.5)+Z*(RNG.rand()-0.5);
+      Pt+=Y*(RX.rand()-0.5)+Z*(RX.rand()-0.5);
       Pt+=X*pm;
     }
   return Pt;
@@ -383,10 +419,53 @@ VolSum::trackRun(const Simulation& System,const size_t N)
   // Note for sphere that you can use X,Y,Z in any orthogonal 
   // directiron
 
+  const ParallelRun& PR=ParallelRun::Instance();
+  if (PR.isParallel())
+    {
+      // track segments of each block : added in block order
+      typedef std::vector<std::pair<int,double>> SEGTYPE;
+      const size_t NBlock=ParallelRun::nBlocks(N);
+      const std::vector<unsigned int> seeds=
+	ParallelRun::blockSeeds(RNG,NBlock);
+      std::vector<SEGTYPE> blockSegs(NBlock);
+      std::vector<double> blockDist(NBlock,0.0);
+
+      PR.run(NBlock,[&](const size_t index)
+        {
+	  QueryContext QC(System,seeds[index]);
+	  const size_t iEnd=ParallelRun::blockEnd(index,N);
+	  for(size_t i=ParallelRun::blockStart(index,N);i<iEnd;i++)
+	    {
+	      const Geometry::Vec3D Pt=getCubePoint(QC.getRNG());
+	      const Geometry::Vec3D XPt=getCubePoint(QC.getRNG());
+
+	      LineTrack A(Pt,XPt);
+	      A.calculate(System);
+	      const std::vector<MonteCarlo::Object*>& OVec=A.getObjVec();
+	      const std::vector<double>& TVec=A.getSegmentLen();
+	      for(size_t j=0;j<OVec.size();j++)
+		if (OVec[j])
+		  blockSegs[index].push_back
+		    (std::pair<int,double>(OVec[j]->getName(),TVec[j]));
+	      blockDist[index]+=Pt.Distance(XPt);
+	    }
+	});
+
+      for(size_t index=0;index<NBlock;index++)
+	{
+	  for(const std::pair<int,double>& SItem : blockSegs[index])
+	    addDistance(SItem.first,SItem.second);
+	  totalDist+=blockDist[index];
+	}
+      ELog::EM<<"Total Dist == "<<totalDist<<ELog::endTrace;  
+      nTracks+=N;
+      return;
+    }
+
   for(size_t i=0;i<N;i++)
     {
-      const Geometry::Vec3D Pt=getCubePoint();
-      const Geometry::Vec3D XPt=getCubePoint();
+      const Geometry::Vec3D Pt=getCubePoint(RNG);
+      const Geometry::Vec3D XPt=getCubePoint(RNG);
 
       LineTrack A(Pt,XPt);
       A.calculate(System);
@@ -28,6 +28,7 @@
 #include <vector>
 #include <map>
 #include <set>
+#include <unordered_map>
 #include <list>
 #include <stack>
 #include <string>
@@ -61,6 +62,7 @@
 #include "Quaternion.h"
 #include "Surface.h"
 #include "surfIndex.h"
+#include "surfHash.h"
 #include "Quadratic.h"
 #include "ArbPoly.h"
 #include "Cylinder.h"
@@ -213,6 +215,25 @@ EqualSurf(SurfType surf,const SMAP& SurMap)
 		       //+SurfType::classType()+">");  // remove ptr (*)
   const int index=surf->getName();
   SMAP::const_iterator mc;
+
+  // Hashed types only need to check the bucket candidates
+  const surfIndex& SurI=surfIndex::Instance();
+  if (&SurMap==&SurI.surMap() && surfHash::isHashed(surf))
+    {
+      const std::vector<int> candidates=SurI.hashCandidates(surf,0);
+      for(const int SN : candidates)
+	{
+	  mc=SurMap.find(SN);
+	  if (SN!=index && mc!=SurMap.end())
+	    {
+	      SurfType sndObj=dynamic_cast<SurfType>(mc->second);
+	      if (sndObj && sndObj->operator==(*surf))
+		return static_cast<RetType>(sndObj); 
+	    }
+	}
+      return static_cast<RetType>(surf);
+    }
+
   for(mc=SurMap.begin();mc!=SurMap.end();mc++)
     {
       if (mc->first!=index) 
@@ -47,6 +47,10 @@
 #include "Quaternion.h"
 #include "OutputLog.h"
 #include "Surface.h"
+#include "Quadratic.h"
+#include "Plane.h"
+#include "Sphere.h"
+#include "surfImplicates.h"
 #include "Rules.h"
 #include "HeadRule.h"
 #include "Object.h"
@@ -58,6 +62,41 @@
 namespace ModelSupport
 {
 
+static bool
+surfacesMeet(const Geometry::Surface* APtr,
+	     const Geometry::Surface* BPtr)
+  /*!
+    Quick test if two surfaces can intersect. 
+    Implicate pairs [parallel planes, planes outside
+    a cylinder] and spheres clear of a plane/sphere 
+    cannot intersect.
+    \param APtr :: First surface
+    \param BPtr :: Second surface
+    \return false if the surfaces cannot intersect
+  */
+{
+  const Geometry::surfImplicates& SImp=
+    Geometry::surfImplicates::Instance();
+  if (SImp.isImplicate(APtr,BPtr).first)
+    return 0;
+
+  const Geometry::Sphere* SA=dynamic_cast<const Geometry::Sphere*>(APtr);
+  const Geometry::Sphere* SB=dynamic_cast<const Geometry::Sphere*>(BPtr);
+  if (!SA && !SB) return 1;
+  if (SA && SB)
+    {
+      const double D=SA->getCentre().Distance(SB->getCentre());
+      return (D<=SA->getRadius()+SB->getRadius()+Geometry::zeroTol &&
+	      D>=std::abs(SA->getRadius()-SB->getRadius())-Geometry::zeroTol);
+    }
+  const Geometry::Sphere* SPtr=(SA) ? SA : SB;
+  const Geometry::Plane* PPtr=
+    dynamic_cast<const Geometry::Plane*>((SA) ? BPtr : APtr);
+  if (PPtr)
+    return (std::abs(PPtr->distance(SPtr->getCentre()))<=
+	    SPtr->getRadius()+Geometry::zeroTol);
+  return 1;
+}
 
 int
 getIntersect(const MonteCarlo::Object& obj,
@@ -88,10 +127,22 @@ getIntersect(const MonteCarlo::Object& obj,
 
   int Ncnt(0);
   std::set<int> ExSN={AS,BS,CS};
+
+  // points outside the box cannot be valid
+  Geometry::Vec3D LPt,HPt;
+  obj.getBoundBox(LPt,HPt);
+  const auto inBox=[&LPt,&HPt](const Geometry::Vec3D& Pt)
+    {
+      for(size_t i=0;i<3;i++)
+	if (Pt[i]<LPt[i] || Pt[i]>HPt[i])
+	  return 0;
+      return 1;
+    };
 	
   for(const Geometry::Vec3D& VC : PntOut)
     {
-      if (obj.isValid(VC,ExSN) &&         // Is point in/on the object
+      if (inBox(VC) &&
+	  obj.isValid(VC,ExSN) &&         // Is point in/on the object
 	  VC.abs()<1e8)          // Tracked onto the very large points
 	{
 	  MonteCarlo::SurfVertex tmp;
@@ -109,7 +160,8 @@ getIntersect(const MonteCarlo::Object& obj,
 std::vector<MonteCarlo::SurfVertex>
 calcVertex(const MonteCarlo::Object& obj)
   /*!
-    Calculate the vertex of an object
+    Calculate the vertex of an object. Triples with a pair
+    of surfaces that cannot intersect are not processed.
     \param obj :: Object
     \return vector of vertex [surf + point]
    */
@@ -120,14 +172,24 @@ calcVertex(const MonteCarlo::Object& obj)
   const std::vector<const Geometry::Surface*>& surfList=
     obj.getSurList();
 
-  std::vector<const Geometry::Surface*>::const_iterator ic,jc,kc;
-  for(ic=surfList.begin();ic!=surfList.end();ic++)
-    for(jc=ic+1;jc!=surfList.end();jc++)
-      for(kc=jc+1;kc!=surfList.end();kc++)
-        {
-	  // This adds intersections to the VList
-	  getIntersect(obj,*ic,*jc,*kc,VList);
-	}
+  // pairs of surfaces that can intersect
+  const size_t NS(surfList.size());
+  std::vector<char> meet(NS*NS,0);
+  for(size_t i=0;i<NS;i++)
+    for(size_t j=i+1;j<NS;j++)
+      meet[i*NS+j]=surfacesMeet(surfList[i],surfList[j]);
+
+  for(size_t i=0;i<NS;i++)
+    for(size_t j=i+1;j<NS;j++)
+      {
+	if (!meet[i*NS+j]) continue;
+	for(size_t k=j+1;k<NS;k++)
+	  {
+	    // This adds intersections to the VList
+	    if (meet[i*NS+k] && meet[j*NS+k])
+	      getIntersect(obj,surfList[i],surfList[j],surfList[k],VList);
+	  }
+      }
   // return number of item found
   return VList;
 }
@@ -135,13 +197,17 @@ calcVertex(const MonteCarlo::Object& obj)
 std::vector<Geometry::Vec3D>
 calcVertexPoints(const MonteCarlo::Object& obj)
   /*!
-    Calculate the vertex of an object
+    Calculate the vertex of an object. The points are kept
+    by the object until its rule changes.
     \param obj :: Object
     \return vector of vertex points
    */
 {
   ELog::RegMethod RegA("vertexCalc[F]","calcVertexPoints");
 
+  if (obj.hasVertexPoints())
+    return obj.getVertexPoints();
+  
   std::vector<MonteCarlo::SurfVertex> VList=
     calcVertex(obj);
 
@@ -149,7 +215,7 @@ calcVertexPoints(const MonteCarlo::Object& obj)
   for(const MonteCarlo::SurfVertex& SV : VList)
     Out.emplace_back(SV.getPoint());
 
-  
+  obj.setVertexPoints(Out);
   return Out;
 } 
 
@@ -0,0 +1,71 @@
+/*********************************************************************
+  CombLayer : MCNP(X) Input builder
+
+ * File:   processInc/BuildDepend.h
+ *
+ * Copyright (c) 2004-2019 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ****************************************************************************/
+#ifndef ModelSupport_BuildDepend_h
+#define ModelSupport_BuildDepend_h
+
+class FuncDataBase;
+
+namespace ModelSupport
+{
+
+/*!
+  \class BuildDepend
+  \version 1.0
+  \author S. Ansell
+  \date May 2019
+  \brief Variables that a build depends on
+
+  Recorded after a build: the variables read [active] with
+  their values and the names looked up but not set [default
+  values], so that setting one of them is a change.
+*/
+
+class BuildDepend
+{
+ private:
+
+  /// Variable : value
+  typedef std::map<std::string,std::string> VTYPE;
+
+  VTYPE readVar;                   ///< Variables read
+  std::set<std::string> missVar;   ///< Looked up but not set
+
+ public:
+
+  BuildDepend();
+  BuildDepend(const BuildDepend&);
+  BuildDepend& operator=(const BuildDepend&);
+  ~BuildDepend() {}    ///< Destructor
+
+  void clear();
+  void build(const FuncDataBase&);
+
+  std::set<std::string> changedVariables(const FuncDataBase&) const;
+  void setRead(const FuncDataBase&) const;
+
+  void read(std::istream&);
+  void write(std::ostream&) const;
+};
+
+}
+
+#endif
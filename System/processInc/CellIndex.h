@@ -0,0 +1,88 @@
+/*********************************************************************
+  CombLayer : MCNP(X) Input builder
+
+ * File:   processInc/CellIndex.h
+ *
+ * Copyright (c) 2004-2019 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ****************************************************************************/
+#ifndef ModelSupport_CellIndex_h
+#define ModelSupport_CellIndex_h
+
+namespace MonteCarlo
+{
+  class Object;
+}
+
+namespace ModelSupport
+{
+
+/*!
+  \class CellIndex
+  \version 1.0
+  \author S. Ansell
+  \date May 2019
+  \brief Uniform grid of cell bounding boxes
+
+  Each cell is given a conservative axis-aligned box
+  [Object::getBoundBox] and is registered in
+  every grid voxel that box touches. Cells with no
+  finite box (or very large boxes) are kept in a wide list
+  that is tested for every point. Candidates are always returned
+  in cell-number order so the first valid cell matches a linear
+  search of the object list.
+*/
+
+class CellIndex
+{
+ private:
+
+  size_t NX;                       ///< Voxels in X
+  size_t NY;                       ///< Voxels in Y
+  size_t NZ;                       ///< Voxels in Z
+  Geometry::Vec3D LowPt;           ///< Low corner of the grid
+  Geometry::Vec3D InvStep;         ///< Inverse voxel size
+
+  std::vector<MonteCarlo::Object*> ObjVec;  ///< Objects [cell order]
+  std::vector<size_t> wideCells;   ///< Unbounded/large cells [index]
+  std::vector<size_t> gridOffset;  ///< Start of voxel in gridCells
+  std::vector<size_t> gridCells;   ///< Bounded cells [index] per voxel
+
+  bool voxelIndex(const Geometry::Vec3D&,size_t&) const;
+
+ public:
+
+  CellIndex();
+  CellIndex(const CellIndex&);
+  CellIndex& operator=(const CellIndex&);
+  ~CellIndex() {}          ///< Destructor
+
+  void clearAll();
+  /// Has the index been built
+  bool isBuilt() const { return !ObjVec.empty(); }
+
+  void build(const std::map<int,MonteCarlo::Object*>&);
+
+  MonteCarlo::Object* findCell(const Geometry::Vec3D&) const;
+  size_t findAllCells(const Geometry::Vec3D&,
+		      std::vector<MonteCarlo::Object*>&) const;
+
+  void write(std::ostream&) const;
+};
+
+}
+
+#endif
@@ -0,0 +1,70 @@
+/********************************************************************* 
+  CombLayer : MCNP(X) Input builder
+ 
+ * File:   processInc/GeomSnapshot.h
+ *
+ * Copyright (c) 2004-2019 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+ *
+ ****************************************************************************/
+#ifndef ModelSupport_GeomSnapshot_h
+#define ModelSupport_GeomSnapshot_h
+
+class Simulation;
+
+namespace ModelSupport
+{
+
+/*!
+  \class GeomSnapshot
+  \version 1.0
+  \author S. Ansell
+  \date May 2019
+  \brief Binary cache of a built geometry
+
+  Stores the surfaces, cells, cell zones, used materials
+  and the components (link points, named cells/surfaces
+  and outer surface) after the components have been built. 
+  The file is keyed by the build options and records the
+  variables read in the build [BuildDepend] so a later run
+  with the same options in which none of those variables 
+  have changed can restore the geometry rather than 
+  rebuilding it. Restored components are 
+  attachSystem::RestoredComp objects.
+*/
+
+class GeomSnapshot
+{
+ private:
+
+  static const std::string magicKey;   ///< File identifier
+  static const int version;            ///< File version
+  
+  const std::string FName;             ///< Snapshot file
+  const std::string buildKey;          ///< Key of the build
+
+ public:
+
+  GeomSnapshot(const std::string&,const std::string&);
+  GeomSnapshot(const GeomSnapshot&);
+  ~GeomSnapshot() {}    ///< Destructor
+
+  bool read(Simulation&) const;
+  void write(const Simulation&) const;
+};
+
+}
+
+#endif
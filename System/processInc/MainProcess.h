@@ -71,6 +71,12 @@ namespace mainSystem
   void InputModifications(Simulation*,inputParam&,
 			  std::vector<std::string>&);
 
+  std::string snapshotKey(const inputParam&,
+			  const std::vector<std::string>&);
+  bool restoreSnapshot(Simulation&,const inputParam&,const std::string&);
+  void saveSnapshot(const Simulation&,const inputParam&,
+		    const std::string&);
+
   void buildFullSimFLUKA(SimPHITS*,const inputParam&,const std::string&);
   void buildFullSimMCNP(SimMCNP*,const inputParam&,const std::string&);
   void buildFullSimPHITS(SimPHITS*,const inputParam&,const std::string&);
@@ -22,6 +22,8 @@
 #ifndef ModelSupport_h
 #define ModelSupport_h
 
+class HeadRule;
+
 /*!
   \namespace ModelSupport
   \author S. Ansell
@@ -49,6 +51,12 @@ namespace ModelSupport
 
 
 
+  HeadRule getHeadRule(const surfRegister&,const int,const std::string&);
+  HeadRule getHeadRule(const surfRegister&,const int,const int,
+		       const std::string&);
+  HeadRule getHeadRule(const surfRegister&,const int,const int,
+		       const int,const std::string&);
+
   std::string getSetComposite(const surfRegister&,const int,
 			      const std::string&);
   std::string getSetComposite(const surfRegister&,const int,
@@ -0,0 +1,90 @@
+/*********************************************************************
+  CombLayer : MCNP(X) Input builder
+
+ * File:   processInc/ObjSurfIndex.h
+ *
+ * Copyright (c) 2004-2019 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ****************************************************************************/
+#ifndef ModelSupport_ObjSurfIndex_h
+#define ModelSupport_ObjSurfIndex_h
+
+namespace MonteCarlo
+{
+  class Object;
+}
+
+namespace ModelSupport
+{
+
+/*!
+  \class ObjSurfIndex
+  \version 1.0
+  \author S. Ansell
+  \date May 2019
+  \brief Boxed candidates of each signed surface 
+
+  For each signed surface of an ObjSurfMap the objects 
+  are kept with their bounding box so the point in cell test
+  is only carried out on objects whose box contains the
+  point [Object::getBoundBox]. The objects are tested in
+  map order so the first valid object is found, as in
+  ObjSurfMap. The index is not changed by a search so it 
+  can be shared by the tracking threads.
+*/
+
+class ObjSurfIndex
+{
+ private:
+
+  /*!
+    \struct candItem
+    \brief Object and its box
+  */
+  struct candItem
+  {
+    MonteCarlo::Object* OPtr;       ///< Object
+    Geometry::Vec3D LowPt;          ///< Low corner
+    Geometry::Vec3D HighPt;         ///< High corner
+
+    /// Is the point in the box
+    bool inBox(const Geometry::Vec3D& Pt) const
+      { return (Pt.X()>=LowPt.X() && Pt.X()<=HighPt.X() &&
+		Pt.Y()>=LowPt.Y() && Pt.Y()<=HighPt.Y() &&
+		Pt.Z()>=LowPt.Z() && Pt.Z()<=HighPt.Z()); }
+  };
+
+  /// Signed surface : objects [map order]
+  std::map<int,std::vector<candItem>> candMap;
+
+  ///\cond NOWRITTEN
+  ObjSurfIndex(const ObjSurfIndex&);
+  ObjSurfIndex& operator=(const ObjSurfIndex&);
+  ///\endcond NOWRITTEN
+  
+ public:
+
+  explicit ObjSurfIndex
+    (const std::map<int,std::vector<MonteCarlo::Object*>>&);
+  ~ObjSurfIndex() {}          ///< Destructor
+
+  MonteCarlo::Object* findNextObject(const int,const Geometry::Vec3D&,
+				     const int) const;
+};
+
+}
+
+#endif
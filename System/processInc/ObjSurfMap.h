@@ -34,6 +34,7 @@ namespace MonteCarlo
 
 namespace ModelSupport
 {
+  class ObjSurfIndex;
 
 /*!
   \class ObjSurfMap
@@ -58,6 +59,7 @@ class ObjSurfMap
 
   OMTYPE SMap;                    ///< SurfNumber : Object map
   OSTYPE OSurfMap;                ///< ObjectName : SurfNumbers
+  ObjSurfIndex* IPtr;             ///< Boxed candidates [if built]
   
   void addSurface(const int,MonteCarlo::Object*);
   void addObjectSurf(const MonteCarlo::Object*,const int);
@@ -68,9 +70,11 @@ class ObjSurfMap
   ObjSurfMap();
   ObjSurfMap(const ObjSurfMap&);
   ObjSurfMap& operator=(const ObjSurfMap&);
-  ~ObjSurfMap() {}          ///< Destructor
+  ~ObjSurfMap();
 
   void clearAll();
+  void clearIndex();
+  void buildIndex();
   
   void addSurfaces(MonteCarlo::Object*);
   
@@ -0,0 +1,81 @@
+/*********************************************************************
+  CombLayer : MCNP(X) Input builder
+
+ * File:   processInc/ParallelRun.h
+ *
+ * Copyright (c) 2004-2019 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ****************************************************************************/
+#ifndef ModelSupport_ParallelRun_h
+#define ModelSupport_ParallelRun_h
+
+class MTRand;
+
+namespace ModelSupport
+{
+
+/*!
+  \class ParallelRun
+  \version 1.0
+  \author S. Ansell
+  \date May 2019
+  \brief Runs independent work items over a number of threads
+
+  Work items are numbered and are handed out to the 
+  threads in order. The caller stores the result of each
+  item separately and merges them in item order, so that the
+  result does not depend on the number of threads.
+  Random sampling is split into fixed blocks each with
+  its own seed [taken from the main generator].
+  Output from the worker threads is suppressed.
+*/
+
+class ParallelRun
+{
+ private:
+
+  size_t nThread;             ///< Number of threads [1 : serial]
+
+  ParallelRun();
+
+  ///\cond SINGLETON
+  ParallelRun(const ParallelRun&);
+  ParallelRun& operator=(const ParallelRun&);
+  ///\endcond SINGLETON
+
+ public:
+
+  static const size_t blockSize;    ///< Samples per random block
+
+  static ParallelRun& Instance();
+
+  void setThreads(const size_t);
+  /// Number of threads
+  size_t getThreads() const { return nThread; }
+  /// Use more than one thread
+  bool isParallel() const { return nThread>1; }
+
+  static size_t nBlocks(const size_t);
+  static size_t blockStart(const size_t,const size_t);
+  static size_t blockEnd(const size_t,const size_t);
+  static std::vector<unsigned int> blockSeeds(MTRand&,const size_t);
+
+  void run(const size_t,const std::function<void(const size_t)>&) const;
+};
+
+}
+
+#endif
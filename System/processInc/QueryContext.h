@@ -0,0 +1,86 @@
+/*********************************************************************
+  CombLayer : MCNP(X) Input builder
+
+ * File:   processInc/QueryContext.h
+ *
+ * Copyright (c) 2004-2019 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ****************************************************************************/
+#ifndef ModelSupport_QueryContext_h
+#define ModelSupport_QueryContext_h
+
+class Simulation;
+
+namespace MonteCarlo
+{
+  class Object;
+}
+
+namespace ModelSupport
+{
+
+/*!
+  \class QueryContext
+  \version 1.0
+  \author S. Ansell
+  \date May 2019
+  \brief Per-thread state for geometry queries
+
+  Holds the random number generator and the last
+  cell found for one thread [or one block of work]. 
+  The call stack and the Simulation last-cell cache 
+  are already held per thread.
+*/
+
+class QueryContext
+{
+ private:
+
+  static const size_t blockSize;    ///< Points tested against last cell
+
+  const Simulation& System;         ///< Simulation to query
+  MTRand RNG;                       ///< Random number generator
+  MonteCarlo::Object* lastCell;     ///< Last cell found
+
+  ///\cond NOWRITTEN
+  QueryContext& operator=(const QueryContext&);
+  ///\endcond NOWRITTEN
+
+ public:
+
+  QueryContext(const Simulation&,const unsigned int);
+  QueryContext(const QueryContext&);
+  ~QueryContext() {}        ///< Destructor
+
+  /// Random number [0-1]
+  double rand() { return RNG.rand(); }
+  /// Access the generator
+  MTRand& getRNG() { return RNG; }
+
+  void seed(const unsigned int);
+  /// Forget the last cell
+  void clearCell() { lastCell=0; }
+  /// Last cell found
+  MonteCarlo::Object* getCell() const { return lastCell; }
+
+  MonteCarlo::Object* findCell(const Geometry::Vec3D&);
+  void findCellBlock(const Geometry::Vec3D*,const size_t,
+		     MonteCarlo::Object**);
+};
+
+}
+
+#endif
@@ -44,6 +44,12 @@ namespace SimProcess
   void writeIndexSimPHITS(SimPHITS&,const std::string&,const int);
   void writeIndexSimFLUKA(SimFLUKA&,const std::string&,const int);
 
+  void writeDecks(const std::string&,const std::string&,
+		  const std::string&,const std::vector<std::string>&);
+  void writeMultiSim(SimMCNP&,const std::string&,const int);
+  void writeMultiSimPHITS(SimPHITS&,const std::string&,const int);
+  void writeMultiSimFLUKA(SimFLUKA&,const std::string&,const int);
+
   template<typename T>
   T getDefVar(const FuncDataBase&,const std::string&,const T&);
 
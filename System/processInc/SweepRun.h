@@ -0,0 +1,96 @@
+/*********************************************************************
+  CombLayer : MCNP(X) Input builder
+
+ * File:   processInc/SweepRun.h
+ *
+ * Copyright (c) 2004-2019 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ****************************************************************************/
+#ifndef mainSystem_SweepRun_h
+#define mainSystem_SweepRun_h
+
+class Simulation;
+
+namespace mainSystem
+{
+  class inputParam;
+
+/*!
+  \class SweepRun
+  \version 1.0
+  \author S. Ansell
+  \date May 2019
+  \brief Builds one model per row of a variable table
+
+  The table is a CSV file: the first line is the variable
+  names and each following line is one model. An empty entry
+  leaves the variable unchanged. The optional columns "name"
+  [deck suffix] and "xml" [file for processXML] are not
+  variables.
+
+  The variables are set once and each row is built in a
+  forked process from that state, so the variable table
+  is only constructed once. The number of rows built
+  at the same time is limited to bound the memory.
+*/
+
+class SweepRun
+{
+ public:
+
+  /// Function to build the geometry of a model
+  typedef std::function<void(Simulation&)> buildTYPE;
+
+ private:
+
+  /*!
+    \struct sweepRow
+    \brief Overrides of a single model
+  */
+  struct sweepRow
+  {
+    std::string name;                          ///< Deck suffix
+    std::string xmlFile;                       ///< XML file [optional]
+    std::map<std::string,std::string> Values;  ///< Variable : value
+  };
+
+  size_t nProcess;                   ///< Max rows built together
+  std::vector<std::string> varNames; ///< Variables in the table
+  std::vector<sweepRow> Rows;        ///< Models to build
+
+  static std::vector<std::string> splitLine(const std::string&);
+
+  int runRow(Simulation&,const inputParam&,const std::string&,
+	     const sweepRow&,const buildTYPE&) const;
+
+ public:
+
+  SweepRun(const std::string&,const size_t);
+  SweepRun(const SweepRun&);
+  SweepRun& operator=(const SweepRun&);
+  ~SweepRun() {}    ///< Destructor
+
+  void readTable(const std::string&);
+  /// Number of models
+  size_t size() const { return Rows.size(); }
+
+  int run(Simulation&,const inputParam&,const std::string&,
+	  const buildTYPE&) const;
+};
+
+}
+
+#endif
@@ -23,6 +23,7 @@
 #define ModelSupport_VolSum_h
 
 class Simulation;
+class MTRand;
 namespace MonteCarlo
 {
   class Object;
@@ -60,7 +61,7 @@ class VolSum
    
   tvTYPE tallyVols;                         ///< TallyNum:Volumes
 
-  Geometry::Vec3D getCubePoint() const;
+  Geometry::Vec3D getCubePoint(MTRand&) const;
   
  public:
   
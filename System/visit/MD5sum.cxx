@@ -60,6 +60,8 @@
 #include "groupRange.h"
 #include "objectGroups.h"
 #include "Simulation.h"
+#include "MersenneTwister.h"
+#include "QueryContext.h"
 #include "MatMD5.h"
 #include "MD5sum.h"
 
@@ -158,7 +160,7 @@ MD5sum::populate(const Simulation* SimPtr)
 {
   ELog::RegMethod RegA("MD5sum","populate");
   const size_t RSize(Results.size());
-  MonteCarlo::Object* ObjPtr(0);
+  ModelSupport::QueryContext QC(*SimPtr,0);
   Geometry::Vec3D aVec;
 
   size_t percent(0);
@@ -177,6 +179,9 @@ MD5sum::populate(const Simulation* SimPtr)
   const size_t a=index[2];  
   const size_t b=index[1];
   const size_t c=index[0];
+  // each c-row is found as a block
+  std::vector<Geometry::Vec3D> rowPts(nPts[c]);
+  std::vector<MonteCarlo::Object*> rowObj(nPts[c]);
   for(size_t i=0;i<nPts[a];i++)
     {
       aVec[a]=XYZ[a]*(static_cast<double>(i)+0.5)/
@@ -191,9 +196,15 @@ MD5sum::populate(const Simulation* SimPtr)
 	    {
 	      aVec[c]=XYZ[c]*(static_cast<double>(k)+0.5)/
 		static_cast<double>(nPts[c]);
-	      
-	      const Geometry::Vec3D Pt=Origin+aVec;
-	      ObjPtr=SimPtr->findCell(Pt,ObjPtr);
+	      rowPts[k]=Origin+aVec;
+	    }
+	  QC.findCellBlock(rowPts.data(),nPts[c],rowObj.data());
+
+	  for(size_t k=0;k<nPts[c];k++)
+	    {
+	      aVec[c]=XYZ[c]*(static_cast<double>(k)+0.5)/
+		static_cast<double>(nPts[c]);
+	      const MonteCarlo::Object* ObjPtr=rowObj[k];
 	      const size_t matN=static_cast<size_t>(ObjPtr->getMatID());
 	      if (matN>=RSize)
 		{
@@ -30,6 +30,8 @@
 #include <map>
 #include <set>
 #include <vector>
+#include <algorithm>
+#include <functional>
 #include <boost/format.hpp>
 #include <boost/multi_array.hpp>
 
@@ -38,6 +40,7 @@
 #include "NameStack.h"
 #include "RegMethod.h"
 #include "OutputLog.h"
+#include "MersenneTwister.h"
 #include "BaseVisit.h"
 #include "BaseModVisit.h"
 #include "support.h"
@@ -58,6 +61,9 @@
 #include "objectGroups.h"
 #include "Simulation.h"
 #include "LineTrack.h"
+#include "ParallelRun.h"
+#include "QueryContext.h"
+#include "CellIndex.h"
 #include "Visit.h"
 
 Visit::Visit() :
@@ -71,7 +77,7 @@ Visit::Visit() :
 Visit::Visit(const Visit& A) : 
   outType(A.outType),lineAverage(A.lineAverage),
   Origin(A.Origin),XYZ(A.XYZ),nPts(A.nPts),
-  mesh(A.mesh)
+  mesh(A.mesh),overlapPairs(A.overlapPairs)
   /*!
     Copy constructor
     \param A :: Visit to copy
@@ -94,6 +100,7 @@ Visit::operator=(const Visit& A)
       XYZ=A.XYZ;
       nPts=A.nPts;
       mesh=A.mesh;
+      overlapPairs=A.overlapPairs;
     }
   return *this;
 }
@@ -178,6 +185,7 @@ Visit::getResult(const MonteCarlo::Object* ObjPtr) const
     case VISITenum::density:
       return ObjPtr->getDensity();
     case VISITenum::weight:
+    case VISITenum::overlap:
       return 0.0;
     }
   return 0.0;
@@ -318,33 +326,45 @@ void
 Visit::populatePoint(const Simulation& System,
 		     const std::set<std::string>& Active)
   /*!
-    The big population call
+    The big population call. Each x-plane of the mesh
+    is an independent work item [run in parallel]
     \param System :: Simulation system
     \param Active :: Active set of cells to use (ranged)
    */
 {
   ELog::RegMethod RegA("Visit","populate(set)");
 
-  MonteCarlo::Object* ObjPtr(0);
-  Geometry::Vec3D aVec;
-  
   const bool aEmptyFlag=Active.empty();
 
   double stepXYZ[3];
   for(size_t i=0;i<3;i++)
     stepXYZ[i]=XYZ[i]/static_cast<double>(nPts[i]);
 
-  for(long int i=0;i<nPts[0];i++)
+  const ModelSupport::ParallelRun& PR=
+    ModelSupport::ParallelRun::Instance();
+  PR.run(static_cast<size_t>(nPts[0]),[&](const size_t index)
     {
+      ModelSupport::QueryContext QC(System,0);
+      const long int i=static_cast<long int>(index);
+      // each k-row is found as a block
+      std::vector<Geometry::Vec3D> rowPts(static_cast<size_t>(nPts[2]));
+      std::vector<MonteCarlo::Object*> rowObj(rowPts.size());
+      Geometry::Vec3D aVec;
       aVec[0]=stepXYZ[0]*(static_cast<double>(i)+0.5);
       for(long int j=0;j<nPts[1];j++)
         {
 	  aVec[1]=stepXYZ[1]*(0.5+static_cast<double>(j));
-	  for(long int k=0;k<nPts[2];k++)
+	  for(size_t k=0;k<rowPts.size();k++)
 	    {
 	      aVec[2]=stepXYZ[2]*(0.5+static_cast<double>(k));
-	      const Geometry::Vec3D Pt=Origin+aVec;
-	      ObjPtr=System.findCell(Pt,ObjPtr);
+	      rowPts[k]=Origin+aVec;
+	    }
+	  QC.findCellBlock(rowPts.data(),rowPts.size(),rowObj.data());
+
+	  for(long int k=0;k<nPts[2];k++)
+	    {
+	      const MonteCarlo::Object* ObjPtr=
+		rowObj[static_cast<size_t>(k)];
 
 	      // Active Set Code:
 	      if (!aEmptyFlag)
@@ -364,7 +384,97 @@ Visit::populatePoint(const Simulation& System,
 
 	    }
 	}
-    }
+    });
+  return;
+}
+
+void
+Visit::populateOverlap(const Simulation& System,
+		       const std::set<std::string>& Active)
+  /*!
+    Count the cells valid at each mesh point [0 is a gap
+    and more than 1 an overlap]. All the cells with a bounding 
+    box about the point are tested. A point on a surface 
+    of the cells found [valid on both sides] or only in
+    cells outside the active set is not sampled [-1].
+    Each x-plane of the mesh is an independent work item 
+    and the cell pairs are merged in plane order.
+    \param System :: Simulation system
+    \param Active :: Active set of cells to use (ranged)
+   */
+{
+  ELog::RegMethod RegA("Visit","populateOverlap");
+
+  const bool aEmptyFlag=Active.empty();
+
+  double stepXYZ[3];
+  for(size_t i=0;i<3;i++)
+    stepXYZ[i]=XYZ[i]/static_cast<double>(nPts[i]);
+
+  ModelSupport::CellIndex CI;
+  CI.build(System.getCells());
+
+  typedef std::map<std::pair<int,int>,size_t> PTYPE;
+  std::vector<PTYPE> planePairs(static_cast<size_t>(nPts[0]));
+
+  const ModelSupport::ParallelRun& PR=
+    ModelSupport::ParallelRun::Instance();
+  PR.run(planePairs.size(),[&](const size_t index)
+    {
+      PTYPE& PMap(planePairs[index]);
+      const long int i=static_cast<long int>(index);
+      std::vector<MonteCarlo::Object*> cellVec;
+      Geometry::Vec3D aVec;
+      aVec[0]=stepXYZ[0]*(static_cast<double>(i)+0.5);
+      for(long int j=0;j<nPts[1];j++)
+        {
+	  aVec[1]=stepXYZ[1]*(0.5+static_cast<double>(j));
+	  for(long int k=0;k<nPts[2];k++)
+	    {
+	      aVec[2]=stepXYZ[2]*(0.5+static_cast<double>(k));
+	      const Geometry::Vec3D Pt(Origin+aVec);
+	      CI.findAllCells(Pt,cellVec);
+	      if (!aEmptyFlag && !cellVec.empty())
+		{
+		  cellVec.erase
+		    (std::remove_if(cellVec.begin(),cellVec.end(),
+		      [&System,&Active](const MonteCarlo::Object* OPtr)
+		      {
+			return Active.find(System.inRange(OPtr->getName()))==
+			  Active.end();
+		      }),cellVec.end());
+		  if (cellVec.empty())
+		    {
+		      mesh[i][j][k]= -1.0;
+		      continue;
+		    }
+		}
+	      if (cellVec.size()>1 &&
+		  std::any_of(cellVec.begin(),cellVec.end(),
+			      [&Pt](const MonteCarlo::Object* OPtr)
+			      { return OPtr->isOnSide(Pt)!=0; }))
+		{
+		  mesh[i][j][k]= -1.0;
+		  continue;
+		}
+
+	      mesh[i][j][k]=static_cast<double>(cellVec.size());
+	      // cells are in cell order
+	      for(size_t a=0;a<cellVec.size();a++)
+		for(size_t b=a+1;b<cellVec.size();b++)
+		  PMap[std::pair<int,int>(cellVec[a]->getName(),
+					  cellVec[b]->getName())]++;
+	    }
+	}
+    });
+
+  overlapPairs.clear();
+  for(const PTYPE& PMap : planePairs)
+    for(const PTYPE::value_type& PItem : PMap)
+      overlapPairs[PItem.first]+=PItem.second;
+
+  if (!overlapPairs.empty())
+    ELog::EM<<"Overlap : "<<overlapPairs.size()<<" cell pairs"<<ELog::endWarn;
   return;
 }
 
@@ -379,7 +489,9 @@ Visit::populate(const Simulation& System,
 {
   ELog::RegMethod RegA("Visit","populate(sim)");
 
-  if (lineAverage)
+  if (outType==VISITenum::overlap)
+    populateOverlap(System,Active);
+  else if (lineAverage)
     populateLine(System,Active);
   else
     populatePoint(System,Active);
@@ -492,3 +604,28 @@ Visit::writeIntegerVTK(const std::string& FName) const
   OX.close();
   return;
 }
+
+void
+Visit::writeOverlapPairs(const std::string& FName) const
+  /*!
+    Write out the overlapping cell pairs ranked by the 
+    number of mesh points in both cells
+    \param FName :: filename 
+  */
+{
+  if (FName.empty()) return;
+
+  typedef std::pair<std::pair<int,int>,size_t> PITEM;
+  std::vector<PITEM> Ranked(overlapPairs.begin(),overlapPairs.end());
+  std::stable_sort(Ranked.begin(),Ranked.end(),
+		   [](const PITEM& A,const PITEM& B)
+		   { return A.second>B.second; });
+
+  std::ofstream OX(FName.c_str());
+  OX<<"# cellA cellB points"<<std::endl;
+  for(const PITEM& PItem : Ranked)
+    OX<<PItem.first.first<<" "<<PItem.first.second<<" "
+      <<PItem.second<<std::endl;
+  OX.close();
+  return;
+}
@@ -46,7 +46,7 @@ class Visit
 
   /// Types of information to plot
   enum class VISITenum : int
-  { cellID=0,material=1,density=2,weight=3};
+  { cellID=0,material=1,density=2,weight=3,overlap=4};
 
  private:
   
@@ -58,6 +58,8 @@ class Visit
 
   std::array<long int,3> nPts;        ///< Number x/y/z points
   boost::multi_array<double,3> mesh;  ///< results mesh
+  /// Cell pair : number of points [overlap]
+  std::map<std::pair<int,int>,size_t> overlapPairs;
 
   static long int procDist(double&,const double,double,double&);
   static long int procPoint(double&,const double);
@@ -83,9 +85,11 @@ class Visit
 
   void populateLine(const Simulation&,const std::set<std::string>&);
   void populatePoint(const Simulation&,const std::set<std::string>&);
+  void populateOverlap(const Simulation&,const std::set<std::string>&);
   void populate(const Simulation&,const std::set<std::string>&);
   void writeVTK(const std::string&) const;
   void writeIntegerVTK(const std::string&) const;
+  void writeOverlapPairs(const std::string&) const;
 };
 
 
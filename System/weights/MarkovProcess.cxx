@@ -31,6 +31,7 @@
 #include <string>
 #include <algorithm>
 #include <memory>
+#include <functional>
 #include <boost/multi_array.hpp>
 
 #include "Exception.h"
@@ -56,6 +57,7 @@
 #include "BaseMap.h"
 #include "CellMap.h"
 #include "Object.h"
+#include "ParallelRun.h"
 
 #include "groupRange.h"
 #include "objectGroups.h"
@@ -64,6 +66,7 @@
 #include "LineTrack.h"
 #include "ObjectTrackAct.h"
 #include "ObjectTrackPoint.h"
+#include "WWGTrack.h"
 #include "WWGWeight.h"
 #include "WWG.h"
 
@@ -73,16 +76,19 @@
 namespace WeightSystem
 {
 
+const double MarkovProcess::attnCut(-20.0);
 
-MarkovProcess::MarkovProcess()
+MarkovProcess::MarkovProcess() :
+  nIteration(0),WX(0),WY(0),WZ(0),WE(0),FSize(0),nRange(1)
  /*! 
     Constructor 
   */
 {}
 
 MarkovProcess::MarkovProcess(const MarkovProcess& A) : 
-  nIteration(A.nIteration),WX(A.WX),WY(A.WY),WZ(A.WZ),
-  FSize(A.FSize),fluxField(A.fluxField)
+  nIteration(A.nIteration),WX(A.WX),WY(A.WY),WZ(A.WZ),WE(A.WE),
+  FSize(A.FSize),nRange(A.nRange),rowStart(A.rowStart),
+  colIndex(A.colIndex),fluxField(A.fluxField),fluxVec(A.fluxVec)
   /*!
     Copy constructor
     \param A :: MarkovProcess to copy
@@ -103,8 +109,13 @@ MarkovProcess::operator=(const MarkovProcess& A)
       WX=A.WX;
       WY=A.WY;
       WZ=A.WZ;
+      WE=A.WE;
       FSize=A.FSize;
+      nRange=A.nRange;
+      rowStart=A.rowStart;
+      colIndex=A.colIndex;
       fluxField=A.fluxField;
+      fluxVec=A.fluxVec;
     }
   return *this;
 }
@@ -118,21 +129,36 @@ MarkovProcess::~MarkovProcess()
 void
 MarkovProcess::initializeData(const WWG& wSet)
   /*!
-    Initialize all the values before execusion
+    Initialize all the values before execusion.
+    The flux starts from the current weight mesh
     \param wSet :: wwg
   */
 {
   ELog::RegMethod RegA("MarkovProcess","initialize");
 
   const Geometry::Mesh3D& grid=wSet.getGrid();
+  const WWGWeight& wMesh=wSet.getMesh();
   
   WX=static_cast<long int>(grid.getXSize());
   WY=static_cast<long int>(grid.getYSize());
   WZ=static_cast<long int>(grid.getZSize());
+  WE=wMesh.getESize();
 
   FSize=WX*WY*WZ;
-  
-  fluxField.resize(boost::extents[FSize][FSize]);
+  if (!wMesh.isSized(WX,WY,WZ,WE) || WE<=0)
+    throw ColErr::MisMatch<long int>
+      (wMesh.getXSize()*wMesh.getYSize()*wMesh.getZSize(),
+       FSize,"WWG mesh not sized to the grid");
+
+  rowStart.clear();
+  colIndex.clear();
+  fluxField.clear();
+
+  const boost::multi_array<double,4>& WGrid=wMesh.getGrid();
+  const double* TData=WGrid.data();
+  fluxVec.resize(WGrid.num_elements());
+  for(size_t i=0;i<fluxVec.size();i++)
+    fluxVec[i]=std::exp(TData[i]);
   
   return;
 }
@@ -144,7 +170,9 @@ MarkovProcess::computeMatrix(const Simulation& System,
 			     const double r2Length,
 			     const double r2Power)
   /*!
-    Calculate the Markov chain process
+    Calculate the Markov chain process. Only mesh cells within
+    nRange of each other are tracked and transfers below
+    exp(attnCut) are dropped.
     \param System :: Simualation
     \param wSet :: WWG set for grid
     \param densityFactor :: Scaling factor for density
@@ -154,46 +182,181 @@ MarkovProcess::computeMatrix(const Simulation& System,
 {
   ELog::RegMethod RegA("MarkovProcess","computeMatrix");
 
-  const Geometry::Mesh3D& grid=wSet.getGrid();
-  const std::vector<Geometry::Vec3D> midPts=wSet.getMidPoints();
+  const std::vector<Geometry::Vec3D>& midPts=wSet.getMidPoints();
 
   if (static_cast<long int>(midPts.size())!=FSize)
     throw ColErr::MisMatch<long int>
       (static_cast<long int>(midPts.size()),FSize,"MidPts.size != FSize");
 
-  for(long int i=0;i<FSize;i++)
-    fluxField[i][i]=1.0;
+  // track distance that can never reach the cut-off
+  const double maxDist=(r2Power>Geometry::zeroTol) ?
+    r2Length*std::exp(-attnCut/r2Power) : -1.0;
 
-  for(long int i=0;i<FSize;i++)
+  // transfers from cell i to cells j>i
+  const size_t NCell(static_cast<size_t>(FSize));
+  std::vector<std::vector<std::pair<long int,double>>> upper(NCell);
+  
+  const ModelSupport::ParallelRun& PR=
+    ModelSupport::ParallelRun::Instance();
+  PR.run(NCell,[&](const size_t uI)
     {
-      const size_t uI(static_cast<size_t>(i));
-      ModelSupport::ObjectTrackPoint OTrack(midPts[uI]); 
-      for(long int j=i+1;j<FSize;j++)
+      const long int i(static_cast<long int>(uI));
+      const long int IX=i/(WY*WZ);
+      const long int IY=(i/WZ) % WY;
+      const long int IZ=i % WZ;
+
+      ModelSupport::ObjectTrackPoint OTrack(midPts[uI]);
+      for(long int jx=std::max(0L,IX-nRange);
+	  jx<=std::min(WX-1,IX+nRange);jx++)
+	for(long int jy=std::max(0L,IY-nRange);
+	    jy<=std::min(WY-1,IY+nRange);jy++)
+	  for(long int jz=std::max(0L,IZ-nRange);
+	      jz<=std::min(WZ-1,IZ+nRange);jz++)
+	    {
+	      const long int j=(jx*WY+jy)*WZ+jz;
+	      if (j<=i) continue;
+	      const size_t uJ(static_cast<size_t>(j));
+	      if (maxDist>0.0 && midPts[uI].Distance(midPts[uJ])>maxDist)
+		continue;
+	      
+	      OTrack.addUnit(System,j,midPts[uJ]);
+	      double DistT=OTrack.getDistance(j)/r2Length;
+	      if (DistT<1.0) DistT=1.0;
+	      const double AT=OTrack.getAttnSum(j); 
+	      const double WFactor= -densityFactor*AT-r2Power*std::log(DistT);
+	      if (WFactor>attnCut)
+		upper[uI].push_back
+		  (std::pair<long int,double>(j,std::exp(WFactor)));
+	    }
+    });
+
+  // symmetric : row i = lower + diagonal + upper [in column order]
+  std::vector<size_t> lowerCnt(NCell+1,0);
+  for(size_t i=0;i<NCell;i++)
+    for(const std::pair<long int,double>& JV : upper[i])
+      lowerCnt[static_cast<size_t>(JV.first)]++;
+
+  rowStart.resize(NCell+1);
+  rowStart[0]=0;
+  for(size_t i=0;i<NCell;i++)
+    rowStart[i+1]=rowStart[i]+lowerCnt[i]+1+upper[i].size();
+  
+  colIndex.resize(rowStart[NCell]);
+  fluxField.resize(rowStart[NCell]);
+
+  // lower part is filled in increasing i so stays ordered
+  std::vector<size_t> fillPt(rowStart.begin(),rowStart.end()-1);
+  for(size_t i=0;i<NCell;i++)
+    {
+      const long int li(static_cast<long int>(i));
+      colIndex[fillPt[i]]=li;
+      fluxField[fillPt[i]]=1.0;
+      fillPt[i]++;
+      for(const std::pair<long int,double>& JV : upper[i])
 	{
-	  const size_t uJ(static_cast<size_t>(i));
-	  OTrack.addUnit(System,j,midPts[uJ]);
-	  double DistT=OTrack.getDistance(j)/r2Length;
-	  if (DistT<1.0) DistT=1.0;
-	  const double AT=OTrack.getAttnSum(j);  // this can take an
-	  const double WFactor= -densityFactor*AT-r2Power*log(DistT);
-	  if (WFactor>-20)
-	    fluxField[i][j]=fluxField[j][i]= -WFactor;
-	  else
-	    fluxField[i][j]=fluxField[j][i]=0.0;
+	  colIndex[fillPt[i]]=JV.first;
+	  fluxField[fillPt[i]]=JV.second;
+	  fillPt[i]++;
+
+	  const size_t uJ(static_cast<size_t>(JV.first));
+	  colIndex[fillPt[uJ]]=li;
+	  fluxField[fillPt[uJ]]=JV.second;
+	  fillPt[uJ]++;
 	}
+      upper[i].clear();
     }
+
+  ELog::EM<<"Markov transfers :: "<<fluxField.size()
+	  <<" ["<<NCell<<" cells]"<<ELog::endDiag;
   return;
 }
 
 void
-MarkovProcess::multiplyOut(const size_t index)
+MarkovProcess::normalizeFlux()
+  /*!
+    Scale the flux of each energy bin to a maximum of 1.0
+  */
 {
+  const size_t NE(static_cast<size_t>(WE));
+  for(size_t e=0;e<NE;e++)
+    {
+      double maxV(0.0);
+      for(size_t i=e;i<fluxVec.size();i+=NE)
+	maxV=std::max(maxV,fluxVec[i]);
+      if (maxV>0.0)
+	for(size_t i=e;i<fluxVec.size();i+=NE)
+	  fluxVec[i]/=maxV;
+    }
+  return;
+}
+
+void
+MarkovProcess::multiplyOut(const size_t nIter)
+  /*!
+    Propagate the flux by power iteration of the transfer matrix.
+    Each iteration is split by mesh cell over the threads
+    \param nIter :: number of iterations
+  */
+{
+  ELog::RegMethod RegA("MarkovProcess","multiplyOut");
+
+  if (rowStart.empty())
+    throw ColErr::EmptyContainer("MarkovProcess matrix not calculated");
+
+  const size_t NCell(rowStart.size()-1);
+  const size_t NE(static_cast<size_t>(WE));
+  const ModelSupport::ParallelRun& PR=
+    ModelSupport::ParallelRun::Instance();
+
+  std::vector<double> nextFlux(fluxVec.size());
+  for(size_t iter=0;iter<nIter;iter++)
+    {
+      PR.run(NCell,[&](const size_t i)
+        {
+	  double* outPtr=&nextFlux[i*NE];
+	  std::fill(outPtr,outPtr+NE,0.0);
+	  for(size_t k=rowStart[i];k<rowStart[i+1];k++)
+	    {
+	      const double* inPtr=
+		&fluxVec[static_cast<size_t>(colIndex[k])*NE];
+	      for(size_t e=0;e<NE;e++)
+		outPtr[e]+=fluxField[k]*inPtr[e];
+	    }
+	});
+      fluxVec.swap(nextFlux);
+      normalizeFlux();
+    }
+  nIteration+=nIter;
   return;
 }
 
 void
-MarkovProcess::rePopulateWWG() 
+MarkovProcess::rePopulateWWG(WWG& wSet) const
+  /*!
+    Set the weight mesh from the flux [log values].
+    Cells with no flux keep the mesh value.
+    \param wSet :: WWG to update
+  */
 {
+  ELog::RegMethod RegA("MarkovProcess","rePopulateWWG");
+
+  WWGWeight wMesh(wSet.getMesh());
+  if (!wMesh.isSized(WX,WY,WZ,WE) ||
+      fluxVec.size()!=static_cast<size_t>(FSize*WE))
+    throw ColErr::MisMatch<size_t>
+      (fluxVec.size(),static_cast<size_t>(FSize*WE),
+       "WWG mesh changed since initializeData");
+
+  const size_t NE(static_cast<size_t>(WE));
+  for(long int i=0;i<FSize;i++)
+    for(long int e=0;e<WE;e++)
+      {
+	const double F=fluxVec[static_cast<size_t>(i)*NE+
+			       static_cast<size_t>(e)];
+	if (F>0.0)
+	  wMesh.setLogPoint(i,e,std::log(F));
+      }
+  wSet.updateWM(wMesh,1.0);
   return;
 }
   
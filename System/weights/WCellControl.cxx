@@ -32,6 +32,8 @@
 #include <string>
 #include <algorithm>
 #include <memory>
+#include <functional>
+#include <type_traits>
 #include <boost/multi_array.hpp>
 
 #include "Exception.h"
@@ -78,6 +80,7 @@
 #include "ObjectTrackAct.h"
 #include "ObjectTrackPoint.h"
 #include "ObjectTrackPlane.h"
+#include "ParallelRun.h"
 #include "Mesh3D.h"
 #include "TempWeights.h"
 #include "WeightControl.h"
@@ -365,6 +368,38 @@ WCellControl::findMax(const Simulation& System,
   return (cellN) ? maxVal : 1.0;
 }
 
+
+template<typename T>
+std::vector<double>
+WCellControl::trackAttn(const Simulation& System,const T& aim,
+			const std::vector<Geometry::Vec3D>& Pts)
+  /*!
+    Calculate the attenuation sum from each point to the aim
+    point/plane. The tracks are independent and are run
+    on the available threads.
+    \param System :: Simulation to use    
+    \param aim :: Point/Plane for the track
+    \param Pts :: Points to track
+    \return attenuation sum for each point [Pts order]
+  */
+{
+  ELog::RegMethod RegA("WCellControl","trackAttn");
+
+  typedef typename std::conditional<
+    std::is_same<T,Geometry::Plane>::value,
+    ModelSupport::ObjectTrackPlane,
+    ModelSupport::ObjectTrackPoint>::type TrackType;
+  
+  std::vector<double> attnSum(Pts.size());
+  ModelSupport::ParallelRun::Instance().run
+    (Pts.size(),[&](const size_t i)
+     {
+       TrackType OTrack(aim);
+       OTrack.addUnit(System,1,Pts[i]);
+       attnSum[i]=OTrack.getAttnSum(1);
+     });
+  return attnSum;
+}
    
 void
 WCellControl::cTrack(const Simulation& System,
@@ -384,15 +419,13 @@ WCellControl::cTrack(const Simulation& System,
   ELog::RegMethod RegA("WCellControl","cTrack");
   // SOURCE Point
 
-  ModelSupport::ObjectTrackPoint OTrack(initPt);
-  std::vector<double> WVec;
+  const std::vector<double> attnSum=trackAttn(System,initPt,Pts);
 
   long int cN(index.empty() ? 1 : index.back());
   for(size_t i=0;i<Pts.size();i++)
     {
       const long int unit(i>=index.size() ? cN++ : index[i]);
-      OTrack.addUnit(System,unit,Pts[i]);
-      CTrack.addTracks(unit,OTrack.getAttnSum(unit));
+      CTrack.addTracks(unit,attnSum[i]);
     } 
   return;
 }
@@ -415,15 +448,13 @@ WCellControl::cTrack(const Simulation& System,
   ELog::RegMethod RegA("WCellControl","cTrack");
   // SOURCE Point
 
-  ModelSupport::ObjectTrackPlane OTrack(initPlane);
-  std::vector<double> WVec;
+  const std::vector<double> attnSum=trackAttn(System,initPlane,Pts);
 
   long int cN(index.empty() ? 1 : index.back());
   for(size_t i=0;i<Pts.size();i++)
     {
       const long int unit(i>=index.size() ? cN++ : index[i]);
-      OTrack.addUnit(System,unit,Pts[i]);
-      CTrack.addTracks(unit,OTrack.getAttnSum(unit));
+      CTrack.addTracks(unit,attnSum[i]);
     } 
   return;
 }
@@ -32,6 +32,8 @@
 #include <string>
 #include <algorithm>
 #include <memory>
+#include <array>
+#include <cstdint>
 #include <boost/multi_array.hpp>
 #include <boost/format.hpp>
 
@@ -60,6 +62,7 @@
 #include "objectRegister.h"
 #include "inputParam.h"
 #include "Mesh3D.h"
+#include "WWGTrack.h"
 #include "WWGWeight.h"
 #include "WWG.h"
 
@@ -371,6 +374,15 @@ WWG::writeVTK(const std::string& FName,
   ELog::RegMethod RegA("WWG","writeVTK");
 
   if (FName.empty()) return;
+
+  const std::string::size_type pos=FName.rfind('.');
+  const std::string ext=(pos==std::string::npos) ? "" : FName.substr(pos);
+  if (ext==".vti" || ext==".vtr")
+    {
+      writeVTKXML(FName);
+      return;
+    }
+  
   std::ofstream OX(FName.c_str());
 
   const long int XSize=WMesh.getXSize();
@@ -411,5 +423,114 @@ WWG::writeVTK(const std::string& FName,
   return;
 }
 
+void
+WWG::writeVTKXML(const std::string& FName) const
+  /*!
+    Write a binary VTK XML file of the weights of all the
+    energy groups [cell data as raw appended blocks].
+    A .vti [ImageData] file needs an even mesh : an uneven
+    mesh is written as a .vtr [RectilinearGrid] file.
+    \param FName :: filename [.vti/.vtr]
+  */
+{
+  ELog::RegMethod RegA("WWG","writeVTKXML");
+
+  const std::array<size_t,3> NPts
+    ({ static_cast<size_t>(WMesh.getXSize()),
+       static_cast<size_t>(WMesh.getYSize()),
+       static_cast<size_t>(WMesh.getZSize()) });
+  const long int ESize=WMesh.getESize();
+
+  std::array<std::vector<double>,3> Coord;
+  for(size_t i=0;i<=NPts[0];i++)
+    Coord[0].push_back(Grid.getXCoordinate(i));
+  for(size_t i=0;i<=NPts[1];i++)
+    Coord[1].push_back(Grid.getYCoordinate(i));
+  for(size_t i=0;i<=NPts[2];i++)
+    Coord[2].push_back(Grid.getZCoordinate(i));
+
+  bool evenFlag(1);
+  for(const std::vector<double>& CVec : Coord)
+    {
+      const double step=CVec[1]-CVec[0];
+      for(size_t i=2;i<CVec.size() && evenFlag;i++)
+	if (std::abs(CVec[i]-CVec[i-1]-step)>1e-6*std::abs(step))
+	  evenFlag=0;
+    }
+
+  std::string OutName(FName);
+  if (!evenFlag && OutName.substr(OutName.size()-4)==".vti")
+    {
+      OutName.replace(OutName.size()-4,4,".vtr");
+      ELog::EM<<"Uneven mesh written as RectilinearGrid : "
+	      <<OutName<<ELog::endWarn;
+    }
+  const bool imageFlag(OutName.substr(OutName.size()-4)==".vti");
+  const std::string gridType=(imageFlag) ? "ImageData" : "RectilinearGrid";
+
+  const uint16_t endTest(1);
+  const std::string byteOrder=
+    (*reinterpret_cast<const char*>(&endTest)) ? 
+    "LittleEndian" : "BigEndian";
+
+  std::ostringstream extent;
+  extent<<"0 "<<NPts[0]<<" 0 "<<NPts[1]<<" 0 "<<NPts[2];
+  
+  std::ofstream OX(OutName.c_str(),std::ios::binary);
+  OX<<std::setprecision(12);
+  OX<<"<?xml version=\"1.0\"?>\n";
+  OX<<"<VTKFile type=\""<<gridType<<"\" version=\"1.0\" "
+    <<"byte_order=\""<<byteOrder<<"\" header_type=\"UInt64\">\n";
+  OX<<"  <"<<gridType<<" WholeExtent=\""<<extent.str()<<"\"";
+  if (imageFlag)
+    OX<<" Origin=\""<<Coord[0][0]<<" "<<Coord[1][0]<<" "<<Coord[2][0]
+      <<"\" Spacing=\""<<(Coord[0][1]-Coord[0][0])<<" "
+      <<(Coord[1][1]-Coord[1][0])<<" "<<(Coord[2][1]-Coord[2][0])<<"\"";
+  OX<<">\n";
+  OX<<"    <Piece Extent=\""<<extent.str()<<"\">\n";
+
+  const size_t NCell(NPts[0]*NPts[1]*NPts[2]);
+  size_t offset(0);
+  OX<<"      <CellData Scalars=\"E0\">\n";
+  for(long int EI=0;EI<ESize;EI++)
+    {
+      OX<<"        <DataArray type=\"Float32\" Name=\"E"<<EI
+	<<"\" format=\"appended\" offset=\""<<offset<<"\"/>\n";
+      offset+=sizeof(uint64_t)+NCell*sizeof(float);
+    }
+  OX<<"      </CellData>\n";
+  if (!imageFlag)
+    {
+      OX<<"      <Coordinates>\n";
+      const char* axisName[]={"X","Y","Z"};
+      for(size_t i=0;i<3;i++)
+	{
+	  OX<<"        <DataArray type=\"Float64\" Name=\""<<axisName[i]
+	    <<"\" format=\"appended\" offset=\""<<offset<<"\"/>\n";
+	  offset+=sizeof(uint64_t)+Coord[i].size()*sizeof(double);
+	}
+      OX<<"      </Coordinates>\n";
+    }
+  OX<<"    </Piece>\n";
+  OX<<"  </"<<gridType<<">\n";
+  OX<<"  <AppendedData encoding=\"raw\">\n   _";
+
+  for(long int EI=0;EI<ESize;EI++)
+    WMesh.writeVTKRaw(OX,EI);
+  if (!imageFlag)
+    for(const std::vector<double>& CVec : Coord)
+      {
+	const uint64_t NByte(CVec.size()*sizeof(double));
+	OX.write(reinterpret_cast<const char*>(&NByte),sizeof(NByte));
+	OX.write(reinterpret_cast<const char*>(CVec.data()),
+		 static_cast<std::streamsize>(NByte));
+      }
+  
+  OX<<"\n  </AppendedData>\n";
+  OX<<"</VTKFile>\n";
+  OX.close();
+  return;
+}
+
   
 }  // NAMESPACE WeightSystem
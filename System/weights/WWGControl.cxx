@@ -79,6 +79,7 @@
 #include "ObjectTrackPlane.h"
 #include "Mesh3D.h"
 #include "WWGItem.h"
+#include "WWGTrack.h"
 #include "WWGWeight.h"
 #include "MarkovProcess.h"
 #include "WeightControl.h"
@@ -330,13 +331,16 @@ WWGControl::wwgMarkov(const Simulation& System,
     {
       const size_t nMult=IParam.getValueError<size_t>
 	("wwgMarkov",index,0,"Mult count not set");
-      if (nMarkov)
+      const long int nRange=IParam.getDefValue<long int>
+	(1,"wwgMarkov",index,1);
+      if (nMult)
 	{
 	  MarkovProcess MCalc;
+	  MCalc.setRange(nRange);
 	  MCalc.initializeData(wwg);
 	  MCalc.computeMatrix(System,wwg,density,r2Length,r2Power);
 	  MCalc.multiplyOut(nMult);
-	  MCalc.rePopulateWWG();
+	  MCalc.rePopulateWWG(wwg);
 	  ELog::EM<<"MARKOV FINISHED"<<ELog::endDiag;
 	}
     }
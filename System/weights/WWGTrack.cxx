@@ -0,0 +1,420 @@
+/********************************************************************* 
+  CombLayer : MCNP(X) Input builder
+ 
+ * File:   weight/WWGTrack.cxx
+ *
+ * Copyright (c) 2004-2019 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+ *
+ ****************************************************************************/
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <cmath>
+#include <complex> 
+#include <vector>
+#include <list>
+#include <set>
+#include <map> 
+#include <string>
+#include <algorithm>
+#include <memory>
+#include <functional>
+
+#include "Exception.h"
+#include "FileReport.h"
+#include "GTKreport.h"
+#include "NameStack.h"
+#include "RegMethod.h"
+#include "OutputLog.h"
+#include "BaseVisit.h"
+#include "BaseModVisit.h"
+#include "MatrixBase.h"
+#include "Matrix.h"
+#include "Vec3D.h"
+#include "Surface.h"
+#include "Quadratic.h"
+#include "Plane.h"
+#include "varList.h"
+#include "Code.h"
+#include "FuncDataBase.h"
+#include "Rules.h"
+#include "HeadRule.h"
+#include "Object.h"
+#include "groupRange.h"
+#include "objectGroups.h"
+#include "Simulation.h"
+#include "Zaid.h"
+#include "MXcards.h"
+#include "Material.h"
+#include "LineTrack.h"
+#include "ParallelRun.h"
+#include "WWGTrack.h"
+
+namespace WeightSystem
+{
+
+const size_t WWGTrack::trackBlock(64);
+  
+WWGTrack::WWGTrack() :
+  aimType(0),aimDist(0.0)
+  /*! 
+    Constructor 
+  */
+{}
+
+WWGTrack::WWGTrack(const WWGTrack& A) : 
+  aimType(A.aimType),aimPt(A.aimPt),aimDist(A.aimDist),
+  gridPts(A.gridPts),trackDist(A.trackDist),
+  matOffset(A.matOffset),matVec(A.matVec),
+  matLength(A.matLength)
+  /*!
+    Copy constructor
+    \param A :: WWGTrack to copy
+  */
+{}
+
+WWGTrack&
+WWGTrack::operator=(const WWGTrack& A)
+  /*!
+    Assignment operator
+    \param A :: WWGTrack to copy
+    \return *this
+  */
+{
+  if (this!=&A)
+    {
+      aimType=A.aimType;
+      aimPt=A.aimPt;
+      aimDist=A.aimDist;
+      gridPts=A.gridPts;
+      trackDist=A.trackDist;
+      matOffset=A.matOffset;
+      matVec=A.matVec;
+      matLength=A.matLength;
+    }
+  return *this;
+}
+
+void
+WWGTrack::clearAll()
+  /*!
+    Remove all the cached tracks
+  */
+{
+  aimType=0;
+  gridPts.clear();
+  trackDist.clear();
+  matOffset.clear();
+  matVec.clear();
+  matLength.clear();
+  return;
+}
+
+Geometry::Vec3D
+WWGTrack::targetPoint(const Geometry::Vec3D& aim,
+		      const Geometry::Vec3D&)
+  /*!
+    Target point of a track to a point
+    \param aim :: Aim point
+    \return aim point
+  */
+{
+  return aim;
+}
+
+Geometry::Vec3D
+WWGTrack::targetPoint(const Geometry::Plane& aim,
+		      const Geometry::Vec3D& gridPt)
+  /*!
+    Target point of a track to a plane
+    \param aim :: Aim plane
+    \param gridPt :: Mesh point
+    \return closest point on the plane
+  */
+{
+  return aim.closestPt(gridPt);
+}
+
+void
+WWGTrack::setAim(const Geometry::Vec3D& Pt)
+  /*!
+    Set the aim as a point
+    \param Pt :: Aim point
+  */
+{
+  aimType=1;
+  aimPt=Pt;
+  aimDist=0.0;
+  return;
+}
+
+void
+WWGTrack::setAim(const Geometry::Plane& P)
+  /*!
+    Set the aim as a plane
+    \param P :: Aim plane
+  */
+{
+  aimType=2;
+  aimPt=P.getNormal();
+  aimDist=P.getDistance();
+  return;
+}
+
+bool
+WWGTrack::isAim(const Geometry::Vec3D& Pt) const
+  /*!
+    Is the point the current aim
+    \param Pt :: Aim point
+    \return true if the tracks are to Pt
+  */
+{
+  return (aimType==1 && aimPt==Pt);
+}
+
+bool
+WWGTrack::isAim(const Geometry::Plane& P) const
+  /*!
+    Is the plane the current aim
+    \param P :: Aim plane
+    \return true if the tracks are to P
+  */
+{
+  return (aimType==2 && aimPt==P.getNormal() &&
+	  std::abs(aimDist-P.getDistance())<Geometry::zeroTol);
+}
+
+template<typename T>
+bool
+WWGTrack::isCached(const T& aim,
+		   const std::vector<Geometry::Vec3D>& MidPt) const
+  /*!
+    Determine if the tracks from aim to the mesh points are
+    already held
+    \param aim :: Point/Plane for the track
+    \param MidPt :: Mesh points
+    \return true if cached
+  */
+{
+  return (isAim(aim) && gridPts==MidPt);
+}
+
+void
+WWGTrack::addPath(const Simulation& System,
+		  const Geometry::Vec3D& gridPt,
+		  const Geometry::Vec3D& targetPt)
+  /*!
+    Track from the mesh point to the target and add the
+    path in each non-void material. Segments outside the
+    geometry are skipped; if the mesh point is not in the
+    model the direct distance is used with no material.
+    \param System :: Simulation to use
+    \param gridPt :: Mesh point
+    \param targetPt :: Aim point of the track
+  */
+{
+  ModelSupport::LineTrack LT(gridPt,targetPt);
+  LT.calculate(System);
+
+  const std::vector<MonteCarlo::Object*>& ObjVec=LT.getObjVec();
+  const std::vector<double>& TVec=LT.getSegmentLen();
+
+  const size_t startIndex(matVec.size());
+  for(size_t i=0;i<ObjVec.size();i++)
+    {
+      if (!ObjVec[i]) continue;
+      const MonteCarlo::Material* MPtr=ObjVec[i]->getMatPtr();
+      if (!MPtr->isVoid())
+	{
+	  size_t index;
+	  for(index=startIndex;index<matVec.size() &&
+		matVec[index]!=MPtr;index++) ;
+	  if (index==matVec.size())
+	    {
+	      matVec.push_back(MPtr);
+	      matLength.push_back(TVec[i]);
+	    }
+	  else
+	    matLength[index]+=TVec[i];
+	}
+    }
+  trackDist.push_back((ObjVec.empty()) ?
+		      gridPt.Distance(targetPt) : LT.getTotalDist());
+  matOffset.push_back(matVec.size());
+  return;
+}
+
+void
+WWGTrack::append(const WWGTrack& A)
+  /*!
+    Add the paths of a block of tracks [mesh points are not copied]
+    \param A :: Tracks to add [matOffset starting at 0]
+  */
+{
+  const size_t offset(matVec.size());
+  trackDist.insert(trackDist.end(),A.trackDist.begin(),A.trackDist.end());
+  matVec.insert(matVec.end(),A.matVec.begin(),A.matVec.end());
+  matLength.insert(matLength.end(),A.matLength.begin(),A.matLength.end());
+  for(size_t i=1;i<A.matOffset.size();i++)
+    matOffset.push_back(offset+A.matOffset[i]);
+  return;
+}
+
+template<typename T>
+void
+WWGTrack::build(const Simulation& System,const T& aim,
+		const std::vector<Geometry::Vec3D>& MidPt)
+  /*!
+    Track from each mesh point to the aim point/plane
+    \param System :: Simulation to use    
+    \param aim :: Point/Plane for the track
+    \param MidPt :: Mesh points
+  */
+{
+  ELog::RegMethod RegA("WWGTrack","build");
+
+  if (isCached(aim,MidPt)) return;
+
+  clearAll();
+  setAim(aim);
+  gridPts=MidPt;
+  trackDist.reserve(MidPt.size());
+  matOffset.reserve(MidPt.size()+1);
+  matOffset.push_back(0);
+
+  const ModelSupport::ParallelRun& PR=
+    ModelSupport::ParallelRun::Instance();
+  if (!PR.isParallel())
+    {
+      for(const Geometry::Vec3D& Pt : MidPt)
+	addPath(System,Pt,targetPoint(aim,Pt));
+      return;
+    }
+
+  const size_t NPts(MidPt.size());
+  const size_t NBlock((NPts+trackBlock-1)/trackBlock);
+  std::vector<WWGTrack> blockTrack(NBlock);
+  PR.run(NBlock,[&](const size_t index)
+    {
+      WWGTrack& BT(blockTrack[index]);
+      BT.matOffset.push_back(0);
+      const size_t iEnd(std::min((index+1)*trackBlock,NPts));
+      for(size_t i=index*trackBlock;i<iEnd;i++)
+	BT.addPath(System,MidPt[i],targetPoint(aim,MidPt[i]));
+    });
+
+  // join in mesh order
+  for(WWGTrack& BT : blockTrack)
+    {
+      append(BT);
+      BT=WWGTrack();      // release block memory
+    }
+  return;
+}
+
+double
+WWGTrack::getDistance(const size_t index) const
+  /*!
+    Get the track length
+    \param index :: Mesh point index
+    \return distance from point to aim 
+  */
+{
+  if (index>=trackDist.size())
+    throw ColErr::IndexError<size_t>(index,trackDist.size(),"index");
+  return trackDist[index];
+}
+
+double
+WWGTrack::getAttnSum(const size_t index,const double) const
+  /*!
+    Calculate the attenuation sum along the track
+    \param index :: Mesh point index
+    \param :: Energy [MeV] : currently no energy dependence
+    \return sum of density * Dist * AtomicMass^0.66
+  */
+{
+  if (index>=trackDist.size())
+    throw ColErr::IndexError<size_t>(index,trackDist.size(),"index");
+
+  double sum(0.0);
+  for(size_t i=matOffset[index];i<matOffset[index+1];i++)
+    {
+      const MonteCarlo::Material* MPtr=matVec[i];
+      sum+=matLength[i]*std::pow(MPtr->getMeanA(),0.66)*
+	MPtr->getAtomDensity();
+    }
+  return sum;
+}
+
+double
+WWGTrack::getWeight(const size_t index,const double E,
+		    const double densityFactor,
+		    const double r2Length,
+		    const double r2Power) const
+  /*!
+    Calculate the log weight for the track
+    \param index :: Mesh point index
+    \param E :: Energy [MeV]
+    \param densityFactor :: Scaling factor for density
+    \param r2Length :: scale factor for length
+    \param r2Power :: power of 1/r^2 factor
+    \return log weight
+  */
+{
+  double DistT=getDistance(index)*r2Length;
+  if (DistT<1.0) DistT=1.0;
+  const double AT=getAttnSum(index,E);
+  return -densityFactor*AT-r2Power*std::log(DistT);
+}
+
+void
+WWGTrack::write(std::ostream& OX) const
+  /*!
+    Debug output
+    \param OX :: Output stream
+   */
+{
+  OX<<"# WWGTrack ["<<aimType<<"] "<<aimPt<<" : "<<aimDist<<std::endl;
+  for(size_t i=0;i<trackDist.size();i++)
+    {
+      OX<<gridPts[i]<<" "<<trackDist[i];
+      for(size_t j=matOffset[i];j<matOffset[i+1];j++)
+	OX<<" "<<matVec[j]->getID()<<":"<<matLength[j];
+      OX<<std::endl;
+    }
+  return;
+}
+
+///\cond TEMPLATE
+
+template
+bool WWGTrack::isCached(const Geometry::Vec3D&,
+			const std::vector<Geometry::Vec3D>&) const;
+template
+bool WWGTrack::isCached(const Geometry::Plane&,
+			const std::vector<Geometry::Vec3D>&) const;
+
+template
+void WWGTrack::build(const Simulation&,const Geometry::Vec3D&,
+		     const std::vector<Geometry::Vec3D>&);
+template
+void WWGTrack::build(const Simulation&,const Geometry::Plane&,
+		     const std::vector<Geometry::Vec3D>&);
+
+///\endcond TEMPLATE
+
+} // Namespace WeightSystem
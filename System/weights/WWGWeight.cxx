@@ -23,6 +23,8 @@
 #include <iomanip>
 #include <iostream>
 #include <cmath>
+#include <cstdio>
+#include <cstdint>
 #include <complex> 
 #include <vector>
 #include <list>
@@ -31,6 +33,7 @@
 #include <string>
 #include <algorithm>
 #include <memory>
+#include <functional>
 #include <boost/multi_array.hpp>
 #include <boost/format.hpp>
 
@@ -76,6 +79,8 @@
 #include "ObjectTrackPlane.h"
 #include "weightManager.h"
 #include "WWGItem.h"
+#include "WWGTrack.h"
+#include "ParallelRun.h"
 #include "WWGWeight.h"
 
 namespace WeightSystem
@@ -100,7 +105,7 @@ WWGWeight::WWGWeight(const size_t EB,
 
 WWGWeight::WWGWeight(const WWGWeight& A) : 
   zeroFlag(A.zeroFlag),WX(A.WX),WY(A.WY),WZ(A.WZ),WE(A.WE),
-  WGrid(A.WGrid)
+  WGrid(A.WGrid),Track(A.Track)
   /*!
     Copy constructor
     \param A :: WWGWeight to copy
@@ -123,6 +128,7 @@ WWGWeight::operator=(const WWGWeight& A)
       WZ=A.WZ;
       WE=A.WE;
       WGrid=A.WGrid;
+      Track=A.Track;
     }
   return *this;
 }
@@ -153,6 +159,10 @@ WWGWeight::resize(const long int LX,const long int LY,
     \param LE :: Energy coorindate size
    */
 {
+  WX=LX;
+  WY=LY;
+  WZ=LZ;
+  WE=LE;
   WGrid.resize(boost::extents[LX][LY][LZ][LE]);
   return;
 }
@@ -459,7 +469,9 @@ WWGWeight::wTrack(const Simulation& System,
 		  const double r2Length,
 		  const double r2Power)
   /*!
-    Calculate a specific track from sourcePoint to position
+    Calculate the tracks from sourcePoint to each grid position.
+    Each track is calculated once and all the energy bins are
+    scored from the cached material path lengths.
     \param System :: Simulation to use    
     \param initPt :: Point for outgoing track
     \param EBand :: Energy grid
@@ -474,14 +486,16 @@ WWGWeight::wTrack(const Simulation& System,
   long int cN(1);
   ELog::EM<<"Processing  "<<MidPt.size()<<" for WWG"<<ELog::endDiag;
 
+  Track.build(System,initPt,MidPt);
+  
   const long int NCut(static_cast<long int>(MidPt.size())/5);
-  for(const Geometry::Vec3D& Pt : MidPt)
+  for(size_t i=0;i<MidPt.size();i++)
     {
       for(long int index=0;index<WE;index++)
 	{
 	  const double EVal=1e-6+EBand[static_cast<size_t>(index)];
 	  const double DT=
-	    distTrack(System,initPt,EVal,Pt,densityFactor,r2Length,r2Power);
+	    Track.getWeight(i,EVal,densityFactor,r2Length,r2Power);
                                                 // energy
 	  if (!((cN-1) % NCut))
 	    ELog::EM<<"WTRAC["<<cN<<"] "<<DT<<ELog::endDiag;
@@ -585,10 +599,12 @@ WWGWeight::CADISnorm(const Simulation& System,
     {
       const size_t tenthValue(gridPts.size()/10);
       ELog::EM<<"Source Point == "<<sourcePt<<ELog::endDiag;
+      // normally already cached from wTrack
+      Track.build(System,sourcePt,gridPts);
       // STILL in log space
       for(size_t i=0;i<gridPts.size();i++)
 	{
-	  const double W=distTrack(System,sourcePt,0.0,gridPts[i],1.0,1.0,2.0);
+	  const double W=Track.getWeight(i,0.0,1.0,1.0,2.0);
 	  for(size_t j=0;j<EnergyStride;j++)
 	    {
 	      sumR[j]=(i) ?
@@ -632,25 +648,113 @@ WWGWeight::CADISnorm(const Simulation& System,
 }
 
 
+/// Number of values formatted as one block
+static const size_t writeBlockSize(65536);
+
+static void
+writeBlocks(std::ostream& OX,const size_t NItem,
+	    const std::function<void(std::string&,const size_t,
+				     const size_t)>& formatFunc)
+  /*!
+    Format the items in fixed blocks [over the threads]
+    and write the blocks in order. At most four blocks per
+    thread are held at once.
+    \param OX :: Output stream
+    \param NItem :: Number of items
+    \param formatFunc :: Append the items [start,end) to the string
+  */
+{
+  const ModelSupport::ParallelRun& PR=
+    ModelSupport::ParallelRun::Instance();
+  const size_t NBlock((NItem+writeBlockSize-1)/writeBlockSize);
+  const size_t NHeld(4*PR.getThreads());
+
+  std::vector<std::string> Out(std::min(NHeld,NBlock));
+  for(size_t bStart=0;bStart<NBlock;bStart+=NHeld)
+    {
+      const size_t NRun(std::min(NHeld,NBlock-bStart));
+      PR.run(NRun,[&](const size_t index)
+        {
+	  const size_t iStart((bStart+index)*writeBlockSize);
+	  std::string& Unit(Out[index]);
+	  Unit.clear();
+	  formatFunc(Unit,iStart,std::min(NItem,iStart+writeBlockSize));
+	});
+      for(size_t i=0;i<NRun;i++)
+	OX.write(Out[i].data(),static_cast<std::streamsize>(Out[i].size()));
+    }
+  return;
+}
+
+static void
+addWWINPValue(std::string& Out,const double V)
+  /*!
+    Add a value in the StrFunc::writeLine format [13.4f/13.4e]
+    \param Out :: String to append
+    \param V :: Value
+  */
+{
+  char buffer[64];
+  const double AVal(std::fabs(V));
+  const int N=(AVal>9.9e4 || (AVal<1e-2 && AVal>1e-38)) ?
+    std::snprintf(buffer,sizeof(buffer),"%13.4e",V) :
+    std::snprintf(buffer,sizeof(buffer),"%13.4f",V);
+  Out.append(buffer,static_cast<size_t>(N));
+  return;
+}
+
+static void
+addVTKValue(std::string& Out,const double V)
+  /*!
+    Add a value in the 11.6g format in a 14 character field
+    \param Out :: String to append
+    \param V :: Value
+  */
+{
+  char buffer[64];
+  const size_t N=static_cast<size_t>
+    (std::snprintf(buffer,sizeof(buffer),"%11.6g",V));
+  Out.append(buffer,N);
+  if (N<14)
+    Out.append(14-N,' ');
+  return;
+}
+
 void
 WWGWeight::writeWWINP(std::ostream& OX) const
   /*!
-    Write out the WWINP format
+    Write out the WWINP format : each energy group
+    with x fastest and six values per line
     \param OX :: Output stream
    */
 {
   ELog::RegMethod RegA("WWGWeight","writeWWINP");
+
+  const size_t NX(static_cast<size_t>(WX));
+  const size_t NY(static_cast<size_t>(WY));
+  const size_t NZ(static_cast<size_t>(WZ));
+  const size_t NE(static_cast<size_t>(WE));
+  const size_t NCell(NX*NY*NZ);
+  const double* TData=WGrid.data();
   
-  for(long int EI=0;EI<WE;EI++)
+  writeBlocks(OX,NCell*NE,[&](std::string& Out,
+			      const size_t iStart,const size_t iEnd)
     {
-      size_t itemCnt=0;
-      for(long int K=0;K<WZ;K++)
-	for(long int J=0;J<WY;J++)
-	  for(long int I=0;I<WX;I++)
-	    StrFunc::writeLine(OX,std::exp(WGrid[I][J][K][EI]),itemCnt,6);
-      // final terminator if needed:
-      if (itemCnt)   OX<<std::endl;
-    }
+      Out.reserve(14*(iEnd-iStart));
+      for(size_t index=iStart;index<iEnd;index++)
+	{
+	  const size_t EI(index/NCell);
+	  const size_t M(index % NCell);
+	  const size_t I(M % NX);
+	  const size_t J((M/NX) % NY);
+	  const size_t K(M/(NX*NY));
+	  addWWINPValue(Out,std::exp(TData[((I*NY+J)*NZ+K)*NE+EI]));
+	  // six to a line and a final terminator if needed
+	  if ((M % 6)==5 || (M+1==NCell && (NCell % 6)))
+	    Out+='\n';
+	}
+    });
+  OX.flush();
   return;
 }
 
@@ -665,19 +769,70 @@ WWGWeight::writeVTK(std::ostream& OX,
 {
   ELog::RegMethod RegA("WWGWeight","writeVTK");
 
-  boost::format fFMT("%1$11.6g%|14t|");
+  if (EIndex<0 || EIndex>=WE)
+    throw ColErr::IndexError<long int>(EIndex,WE,"index in WMesh.ESize");
+
+  const size_t NX(static_cast<size_t>(WX));
+  const size_t NY(static_cast<size_t>(WY));
+  const size_t NZ(static_cast<size_t>(WZ));
+  const size_t NE(static_cast<size_t>(WE));
+  const size_t EI(static_cast<size_t>(EIndex));
+  const double* TData=WGrid.data();
+
+  writeBlocks(OX,NX*NY*NZ,[&](std::string& Out,
+			      const size_t iStart,const size_t iEnd)
+    {
+      Out.reserve(15*(iEnd-iStart));
+      for(size_t index=iStart;index<iEnd;index++)
+	{
+	  const size_t I(index % NX);
+	  const size_t J((index/NX) % NY);
+	  const size_t K(index/(NX*NY));
+	  addVTKValue(Out,std::exp(TData[((I*NY+J)*NZ+K)*NE+EI]));
+	  if (I+1==NX)
+	    Out+='\n';
+	}
+    });
+  OX.flush();
+  return;
+}
+
+void
+WWGWeight::writeVTKRaw(std::ostream& OX,
+		       const long int EIndex) const
+  /*!
+    Write one energy group as a raw VTK appended block :
+    UInt64 byte count then Float32 values [x fastest]
+    \param OX :: Output stream
+    \param EIndex :: energy index
+  */
+{
+  ELog::RegMethod RegA("WWGWeight","writeVTKRaw");
 
   if (EIndex<0 || EIndex>=WE)
     throw ColErr::IndexError<long int>(EIndex,WE,"index in WMesh.ESize");
-  
-  for(long int K=0;K<WZ;K++)
-    for(long int J=0;J<WY;J++)
-      {
-	for(long int I=0;I<WX;I++)
-	  OX<<(fFMT % std::exp(WGrid[I][J][K][EIndex]));
-	OX<<std::endl;
-      }
-  
+
+  const size_t NX(static_cast<size_t>(WX));
+  const size_t NY(static_cast<size_t>(WY));
+  const size_t NZ(static_cast<size_t>(WZ));
+  const size_t NE(static_cast<size_t>(WE));
+  const size_t EI(static_cast<size_t>(EIndex));
+  const double* TData=WGrid.data();
+
+  std::vector<float> Out(NX*NY*NZ);
+  ModelSupport::ParallelRun::Instance().run(NZ,[&](const size_t K)
+    {
+      float* outPtr=&Out[K*NX*NY];
+      for(size_t J=0;J<NY;J++)
+	for(size_t I=0;I<NX;I++)
+	  *outPtr++ =static_cast<float>
+	    (std::exp(TData[((I*NY+J)*NZ+K)*NE+EI]));
+    });
+
+  const uint64_t NByte(Out.size()*sizeof(float));
+  OX.write(reinterpret_cast<const char*>(&NByte),sizeof(NByte));
+  OX.write(reinterpret_cast<const char*>(Out.data()),
+	   static_cast<std::streamsize>(NByte));
   return;
 }
 
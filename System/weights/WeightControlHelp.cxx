@@ -94,9 +94,11 @@ WeightControl::help()
   ELog::EM<<"-- wWWG --::"<<ELog::endDiag;
   ELog::EM<<"-- wwgNorm -- minWeight power :: 10^-minWeight and w=w^power "<<ELog::endDiag;
   ELog::EM<<"-- wwgCalc --::"<<ELog::endDiag;
-  ELog::EM<<"-- wwgMarkov --::"<<ELog::endDiag;
+  ELog::EM<<"-- wwgMarkov -- nIteration [nRange] :: "
+    "propagate WWG by mesh cells within nRange"<<ELog::endDiag;
   ELog::EM<<"-- wwgRPtMesh -- set hte reference point for the mesh ::"<<ELog::endDiag;
-  ELog::EM<<"-- wwgVTK --::"<<ELog::endDiag;
+  ELog::EM<<"-- wwgVTK -- FileName :: .vti/.vtr for binary VTK XML"
+    " [all energy groups]"<<ELog::endDiag;
   procCalcHelp();
 
   ELog::EM<<"-- wFCL --:: Set forced collision"<<ELog::endDiag;
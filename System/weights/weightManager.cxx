@@ -56,6 +56,7 @@
 #include "WItem.h"
 #include "WCells.h"
 #include "Mesh3D.h"
+#include "WWGTrack.h"
 #include "WWGWeight.h"
 #include "WWG.h"
 #include "cellValueSet.h"
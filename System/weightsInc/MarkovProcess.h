@@ -38,23 +38,39 @@ namespace WeightSystem
     \author S. Ansell
     \date October 2015
     \brief Input to Weights controller
+
+    The transfer between mesh cells is held as a sparse [CSR]
+    matrix : only cells within nRange mesh cells of each other
+    and with a transfer above the cut-off are coupled.
+    The flux of each energy bin is propagated by
+    repeated multiplication of the matrix.
   */
   
 class MarkovProcess
 {
  private:
 
-  
+  static const double attnCut;    ///< Lowest log transfer kept
+
   size_t nIteration;       ///< number of iterations
 
   long int WX;             ///< WX size of WWG
   long int WY;             ///< WY size of WWG 
   long int WZ;             ///< WZ size of WWG
+  long int WE;             ///< Energy size of WWG
 
-  long int FSize;          ///< size of fluxField [square]
+  long int FSize;          ///< number of mesh cells
+  long int nRange;         ///< Mesh cells coupled in each direction
 
-  /// Array of interaction [initialCell][finalCell]
-  boost::multi_array<double,2> fluxField;
+  /// Start of each initialCell in colIndex/fluxField [FSize+1]
+  std::vector<size_t> rowStart;
+  std::vector<long int> colIndex;    ///< finalCell of each transfer
+  /// Transfer fraction [initialCell][finalCell]
+  std::vector<double> fluxField;
+  /// Flux [cell*WE+energy]
+  std::vector<double> fluxVec;
+
+  void normalizeFlux();
   
  public:
 
@@ -64,11 +80,16 @@ class MarkovProcess
   ~MarkovProcess();
 
 
+  /// Set the neighbour range
+  void setRange(const long int R) { nRange=(R>0) ? R : 1; }
+  /// Number of transfers held
+  size_t getNonZero() const { return fluxField.size(); }
+
   void initializeData(const WWG&);
   void computeMatrix(const Simulation&,const WWG&,const double,
 		     const double,const double);
   void multiplyOut(const size_t);
-  void rePopulateWWG();
+  void rePopulateWWG(WWG&) const;
   
 };
 
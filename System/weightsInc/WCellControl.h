@@ -80,6 +80,12 @@ class WCellControl : public WeightControl
 		      const mainSystem::inputParam&);
   
   void setWeights(Simulation&,const std::string&);
+
+  template<typename T>
+  static std::vector<double>
+  trackAttn(const Simulation&,const T&,
+	    const std::vector<Geometry::Vec3D>&);
+  
   void cTrack(const Simulation&,const Geometry::Vec3D&,
 	      const std::vector<Geometry::Vec3D>&,
 	      const std::vector<long int>&,
@@ -77,6 +77,8 @@ class WWG
   /// get grid mid point
   const std::vector<Geometry::Vec3D>& getMidPoints() const
     { return GridMidPt; }
+  /// access to the weight mesh
+  const WWGWeight& getMesh() const { return WMesh; }
 
   void setParticles(const std::set<std::string>&);
   /// Access to EBin
@@ -97,6 +99,7 @@ class WWG
   void write(std::ostream&) const;
   void writeWWINP(const std::string&) const;
   void writeVTK(const std::string&,const long int =0) const;
+  void writeVTKXML(const std::string&) const;
 
 
   
@@ -0,0 +1,111 @@
+/********************************************************************* 
+  CombLayer : MCNP(X) Input builder
+ 
+ * File:   weightInc/WWGTrack.h
+ *
+ * Copyright (c) 2004-2019 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+ *
+ ****************************************************************************/
+#ifndef WeightSystem_WWGTrack_h
+#define WeightSystem_WWGTrack_h
+
+class Simulation;
+
+namespace MonteCarlo
+{
+  class Material;
+}
+
+namespace WeightSystem
+{
+
+/*!
+  \class WWGTrack
+  \version 1.0
+  \author S. Ansell
+  \date May 2019
+  \brief Cached tracks from a source point/plane to the WWG mesh
+
+  Each mesh point is tracked once and the path is reduced to
+  the length in each non-void material. The energy dependent
+  attenuation is then evaluated from the cached lengths without
+  tracking through the model again.
+  Blocks of mesh points are tracked on separate threads and
+  joined in mesh order, so the cache is the same for any
+  number of threads.
+*/
+  
+class WWGTrack 
+{
+ private:
+
+  int aimType;                  ///< Type of aim [0 none/1 point/2 plane]
+  Geometry::Vec3D aimPt;        ///< Point / Plane normal
+  double aimDist;               ///< Plane distance
+  
+  std::vector<Geometry::Vec3D> gridPts;  ///< Mesh points tracked
+
+  std::vector<double> trackDist;         ///< Track length [per point]
+  std::vector<size_t> matOffset;         ///< Start of point in matVec
+  /// Materials on each path [non-void]
+  std::vector<const MonteCarlo::Material*> matVec; 
+  std::vector<double> matLength;         ///< Path length in material
+
+  static const size_t trackBlock;        ///< Points per work item
+
+  static Geometry::Vec3D targetPoint(const Geometry::Vec3D&,
+				     const Geometry::Vec3D&);
+  static Geometry::Vec3D targetPoint(const Geometry::Plane&,
+				     const Geometry::Vec3D&);
+
+  void setAim(const Geometry::Vec3D&);
+  void setAim(const Geometry::Plane&);
+  bool isAim(const Geometry::Vec3D&) const;
+  bool isAim(const Geometry::Plane&) const;
+
+  void addPath(const Simulation&,const Geometry::Vec3D&,
+	       const Geometry::Vec3D&);
+  void append(const WWGTrack&);
+  
+ public:
+
+  WWGTrack();
+  WWGTrack(const WWGTrack&);
+  WWGTrack& operator=(const WWGTrack&);    
+  ~WWGTrack() {}          ///< Destructor
+
+  void clearAll();
+  
+  /// Number of points tracked
+  size_t size() const { return trackDist.size(); }
+
+  template<typename T>
+  bool isCached(const T&,const std::vector<Geometry::Vec3D>&) const;
+  template<typename T>
+  void build(const Simulation&,const T&,
+	     const std::vector<Geometry::Vec3D>&);
+
+  double getDistance(const size_t) const;
+  double getAttnSum(const size_t,const double) const;
+  double getWeight(const size_t,const double,
+		   const double,const double,const double) const;
+  
+  void write(std::ostream&) const;
+};
+
+}
+
+#endif
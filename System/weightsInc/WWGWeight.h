@@ -48,6 +48,8 @@ class WWGWeight
   
   /// local storage for data [i,j,k,Energy]
   boost::multi_array<double,4> WGrid; 
+
+  WWGTrack Track;          ///< Cached tracks from the last aim point
   
  public:
 
@@ -122,6 +124,7 @@ class WWGWeight
   
   void writeWWINP(std::ostream&) const;
   void writeVTK(std::ostream&,const long int) const;
+  void writeVTKRaw(std::ostream&,const long int) const;
   void write(std::ostream&) const;
 };
 
@@ -86,7 +86,6 @@ class SimFLUKA : public Simulation
   void writeWeights(std::ostream&) const;
   void writeTransform(std::ostream&) const;
   void writeTally(std::ostream&) const;
-  void writePhysics(std::ostream&) const;
   void writeSource(std::ostream&) const;
   void writeVariables(std::ostream&) const;
 
@@ -140,6 +139,8 @@ class SimFLUKA : public Simulation
   void setDefaultPhysics(const std::string&);
   void setForCinder();
   
+  void writeModel(std::ostream&) const;
+  void writePhysics(std::ostream&) const;
   virtual void write(const std::string&) const;
 
 };
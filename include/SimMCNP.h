@@ -95,7 +95,6 @@ class SimMCNP : public Simulation
   void writeTransform(std::ostream&) const;
   void writeTally(std::ostream&) const;
   void writeSource(std::ostream&) const;
-  void writePhysics(std::ostream&) const;
 
 
   // The Cinder Write stuff
@@ -144,6 +143,8 @@ class SimMCNP : public Simulation
   
   virtual void writeCinder() const;          
 
+  void writeModel(std::ostream&) const;
+  void writePhysics(std::ostream&) const;
   virtual void write(const std::string&) const;  
     
 };
@@ -88,6 +88,7 @@ class SimPHITS : public Simulation
   PTallyTYPE& getTallyMap() { return PTItem; }            ///< Access tally map
   const PTallyTYPE& getTallyMap() const { return PTItem; }  ///< Access constant
   
+  void writeModel(std::ostream&) const;
   virtual void write(const std::string&) const;
 
 };
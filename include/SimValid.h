@@ -22,9 +22,11 @@
 #ifndef ModelSupport_SimValid_h
 #define ModelSupport_SimValid_h
 
+class MTRand;
 
 namespace ModelSupport
 {
+  class CellIndex;
 
 /*!
   \class simPoint
@@ -68,6 +70,40 @@ struct simPoint
 
 };
 
+/*!
+  \struct simFail
+  \brief Failure found on the validation tracks
+  \author S. Ansell
+  \version 1.0
+  \date May 2019
+
+  The type is overlap [two cells valid at a point], gap
+  [no cell valid / no cell found across a surface] or track 
+  [the tracked cell is not valid along its own track].
+ */
+struct simFail
+{
+  std::string type;                ///< overlap / gap / track
+  std::string startName;           ///< Start point [component/cell]
+  int cellA;                       ///< Cell being tracked
+  int cellB;                       ///< Other cell [0 if none]
+  int surfN;                       ///< Surface crossed [0 if none]
+  size_t count;                    ///< Number of tracks with failure
+  Geometry::Vec3D Pt;              ///< First failure point
+  Geometry::Vec3D Dir;             ///< Track direction at the point
+
+  simFail(const std::string& T,const std::string& SName,
+	  const int A,const int B,const int SN,
+	  const Geometry::Vec3D& P,const Geometry::Vec3D& D) :
+  type(T),startName(SName),cellA(A),cellB(B),surfN(SN),
+    count(1),Pt(P),Dir(D) {}
+
+  /// Same failure [not point]
+  bool sameFail(const simFail& A) const
+    { return type==A.type && cellA==A.cellA && 
+	cellB==A.cellB && surfN==A.surfN; }
+};
+
 /*!
   \class SimValid
   \brief Applies simple test to a simulation to check validity
@@ -81,9 +117,25 @@ class SimValid
  private:
 
   Geometry::Vec3D Centre;   // Centre for tracks
+  std::vector<simFail> Fails;  ///< Failures from runAll
 
   void diagnostics(const Simulation&,
 		   const std::vector<simPoint>&) const;
+
+  static Geometry::Vec3D randomDir(MTRand&);
+  static bool trackDir(const Simulation&,const Geometry::Vec3D&,
+		       MonteCarlo::Object*,const int,
+		       const Geometry::Vec3D&,std::vector<simPoint>&);
+  static bool trackCheck(const Simulation&,const CellIndex&,
+			 const std::string&,const Geometry::Vec3D&,
+			 MonteCarlo::Object*,const Geometry::Vec3D&,
+			 std::vector<simFail>&);
+  static bool startCell(const Simulation&,const CellIndex&,
+			const std::string&,const Geometry::Vec3D&,
+			MonteCarlo::Object*&,std::vector<simFail>&);
+  static bool sampleCell(const MonteCarlo::Object&,MTRand&,
+			 Geometry::Vec3D&);
+  void addFails(const std::vector<simFail>&);
   
  public:
   
@@ -100,6 +152,11 @@ class SimValid
   
   int runFixedComp(const Simulation&,const size_t) const;
 
+  size_t runAll(const Simulation&,const size_t,const unsigned int);
+  /// Failures [merged] from runAll
+  const std::vector<simFail>& getFails() const { return Fails; }
+  void writeFails(std::ostream&) const;
+
 };
 
 }
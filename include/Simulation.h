@@ -43,6 +43,7 @@ namespace Surface
 namespace ModelSupport
 {
   class ObjSurfMap;
+  class CellIndex;
 }
 
 namespace MonteCarlo
@@ -80,6 +81,7 @@ class Simulation : public objectGroups
   
   FuncDataBase DB;                      ///< DataBase of variables
   ModelSupport::ObjSurfMap* OSMPtr;     ///< Object surface map [if required]
+  ModelSupport::CellIndex* CIPtr;       ///< Cell spatial index [if required]
 
   TransTYPE TList;                      ///< Transforms List (key=Transform)
 
@@ -122,6 +124,7 @@ class Simulation : public objectGroups
   void setCellDNF(const size_t C) { cellDNF=C; }
   /// set cell CNF
   void setCellCNF(const size_t C) { cellCNF=C; }
+  void setCellIndex(const bool);
 
   MonteCarlo::Object* findObject(const int);         
   const MonteCarlo::Object* findObject(const int) const; 
@@ -199,6 +202,9 @@ class Simulation : public objectGroups
   void validateObjSurfMap();
   /// Access surface map
   const ModelSupport::ObjSurfMap* getOSM() const;
+  void createCellIndex();
+  void clearCellIndex();
+  void clearGeomCache();
 
   // Tally processing
 
@@ -115,6 +115,11 @@ class objectGroups
   /// Get full components list
   const cMapTYPE& getComponents() const
     { return Components; }
+  /// Get the cell zones [zone : name]
+  const RTYPE& getRangeMap() const
+    { return rangeMap; }
+  /// Get the size of a cell zone
+  int getCellZone() const { return cellZone; }
 
   int getFirstCell(const std::string&) const;
   int getLastCell(const std::string&) const;
@@ -710,16 +710,16 @@ SimFLUKA::prepareWrite()
 }
 
 void
-SimFLUKA::write(const std::string& Fname) const
+SimFLUKA::writeModel(std::ostream& OX) const
   /*!
-    Write out all the system (in FLUKA output format)
-    \param Fname :: Output file 
+    Write out everything before the physics/random cards.
+    This does not depend on the RND seed so can be reused
+    for each deck of a multi-run.
+    \param OX :: Output stream
   */
 {
-  ELog::RegMethod RegA("SimFLUKA","write");
+  ELog::RegMethod RegA("SimFLUKA","writeModel");
 
-
-  std::ofstream OX(Fname.c_str());
   const size_t nCells(OList.size());
   const size_t maxCells(20000);
   if (nCells>maxCells)
@@ -756,6 +756,20 @@ SimFLUKA::write(const std::string& Fname) const
   RadDecayPtr->write(*this,OX);
   writeTally(OX);
   writeSource(OX);
+  return;
+}
+
+void
+SimFLUKA::write(const std::string& Fname) const
+  /*!
+    Write out all the system (in FLUKA output format)
+    \param Fname :: Output file 
+  */
+{
+  ELog::RegMethod RegA("SimFLUKA","write");
+
+  std::ofstream OX(Fname.c_str());
+  writeModel(OX);
   writePhysics(OX);
   OX<<"STOP"<<std::endl;
   OX.close();
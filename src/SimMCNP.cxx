@@ -678,14 +678,14 @@ SimMCNP::writeCinderMat() const
 }
 
 void
-SimMCNP::write(const std::string& Fname) const
+SimMCNP::writeModel(std::ostream& OX) const
   /*!
-    Write out all the system (in MCNPX output format)
-    \param Fname :: Output file 
+    Write out everything before the physics cards. This 
+    does not depend on the RND seed so can be reused
+    for each deck of a multi-run.
+    \param OX :: Output stream
   */
 {
-  std::ofstream OX(Fname.c_str());
-  
   OX<<"Input File:"<<inputFile<<std::endl;
   StrFunc::writeMCNPXcomment("RunCmd:"+cmdLine,OX);
   writeVariables(OX);
@@ -696,6 +696,18 @@ SimMCNP::write(const std::string& Fname) const
   writeWeights(OX);
   writeTally(OX);
   writeSource(OX);
+  return;
+}
+
+void
+SimMCNP::write(const std::string& Fname) const
+  /*!
+    Write out all the system (in MCNPX output format)
+    \param Fname :: Output file 
+  */
+{
+  std::ofstream OX(Fname.c_str());
+  writeModel(OX);
   writePhysics(OX);
   OX.close();
   return;
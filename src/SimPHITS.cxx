@@ -389,13 +389,12 @@ SimPHITS::writePhysics(std::ostream& OX) const
 }
 
 void
-SimPHITS::write(const std::string& Fname) const
+SimPHITS::writeModel(std::ostream& OX) const
   /*!
     Write out all the system (in PHITS output format)
-    \param Fname :: Output file 
+    \param OX :: Output stream
   */
 {
-  std::ofstream OX(Fname.c_str());
   OX<<"[Title]"<<std::endl;
   writePhysics(OX);
   //  Simulation::writeVariables(OX);
@@ -410,6 +409,18 @@ SimPHITS::write(const std::string& Fname) const
   writeSource(OX);
 
   OX<<"[end]"<<std::endl;
+  return;
+}
+
+void
+SimPHITS::write(const std::string& Fname) const
+  /*!
+    Write out all the system (in PHITS output format)
+    \param Fname :: Output file 
+  */
+{
+  std::ofstream OX(Fname.c_str());
+  writeModel(OX);
   OX.close();
   return;
 }
@@ -52,11 +52,11 @@ SimTrack::SimTrack()
 SimTrack&
 SimTrack::Instance()
   /*!
-    Singleton this
+    Singleton this [one per thread]
     \return SimTrack object
    */
 {
-  static SimTrack ST;
+  static thread_local SimTrack ST;
   return ST;
 }
 
@@ -99,14 +99,9 @@ SimTrack::setCell(const Simulation* SimPtr,MonteCarlo::Object* OPtr)
 {
   ELog::RegMethod RegA("SimTrack","setCell");
 
+  // Simulations are only added in the creating thread
   fcTYPE::key_type sInt=reinterpret_cast<fcTYPE::key_type>(SimPtr);
-  fcTYPE::iterator mc=findCell.find(sInt);
-  if (mc==findCell.end())
-    {
-      throw ColErr::InContainerError<fcTYPE::key_type>
-	(sInt,"sInt not fould in findCell");
-    }
-  mc->second=OPtr;
+  findCell[sInt]=OPtr;
   return;
 }
 
@@ -115,17 +110,14 @@ SimTrack::curCell(const Simulation* SimPtr) const
   /*!
     Get the current cell
     \param SimPtr :: Significant figures
-    \return :: Object Pointer
+    \return :: Object Pointer [0 if not set in this thread]
   */
 {
   ELog::RegMethod RegA("SimTrack","curCell");
 
   fcTYPE::key_type sInt=reinterpret_cast<fcTYPE::key_type>(SimPtr);
   fcTYPE::const_iterator mc=findCell.find(sInt);
-  if (mc==findCell.end())
-    throw ColErr::InContainerError<fcTYPE::key_type>
-      (sInt,"simluation<long Int>");
-  return mc->second;
+  return (mc==findCell.end()) ? 0 : mc->second;
 }
 
 void
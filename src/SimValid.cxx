@@ -31,6 +31,8 @@
 #include <set>
 #include <vector>
 #include <memory>
+#include <functional>
+#include <algorithm>
 
 #include "Exception.h"
 #include "FileReport.h"
@@ -64,6 +66,9 @@
 #include "groupRange.h"
 #include "objectGroups.h"
 #include "Simulation.h"
+#include "ParallelRun.h"
+#include "CellIndex.h"
+#include "RuleBox.h"
 #include "SimValid.h"
 
 #include "debugMethod.h"
@@ -81,7 +86,7 @@ SimValid::SimValid() :
 {}
 
 SimValid::SimValid(const SimValid& A) : 
-  Centre(A.Centre)
+  Centre(A.Centre),Fails(A.Fails)
   /*!
     Copy constructor
     \param A :: SimValid to copy
@@ -99,6 +104,7 @@ SimValid::operator=(const SimValid& A)
   if (this!=&A)
     {
       Centre=A.Centre;
+      Fails=A.Fails;
     }
   return *this;
 }
@@ -173,12 +179,79 @@ SimValid::diagnostics(const Simulation& System,
   return;
 }
   
+Geometry::Vec3D
+SimValid::randomDir(MTRand& RX)
+  /*!
+    Get a random direction 
+    \param RX :: Random number generator
+    \return unit vector
+  */
+{
+  const double phi=RX.rand()*M_PI;
+  const double theta=2.0*RX.rand()*M_PI;
+  return Geometry::Vec3D(cos(theta)*sin(phi),
+			 sin(theta)*sin(phi),
+			 cos(phi));
+}
+
+bool
+SimValid::trackDir(const Simulation& System,
+		   const Geometry::Vec3D& CP,
+		   MonteCarlo::Object* InitObj,
+		   const int initSurfNum,
+		   const Geometry::Vec3D& uVec,
+		   std::vector<simPoint>& Pts)
+  /*!
+    Track a line from the centre point to the outside
+    \param System :: Simulation to use
+    \param CP :: Centre point
+    \param InitObj :: Cell at the centre point
+    \param initSurfNum :: Surface the centre point is on
+    \param uVec :: Direction
+    \param Pts :: Track points 
+    \return true if track reached a zero importance cell
+  */
+{
+  const ModelSupport::ObjSurfMap* OSMPtr =System.getOSM();
+  const Geometry::Surface* SPtr;          // Output surface
+  double aDist;       
+
+  MonteCarlo::eTrack TNeut(CP,uVec);
+
+  MonteCarlo::Object* OPtr=InitObj;
+  int SN(-initSurfNum);
+
+  Pts.push_back(simPoint(TNeut.Pos,TNeut.uVec,OPtr->getName(),SN,OPtr));
+  while(OPtr && OPtr->getImp())
+    {
+      // Note: Need OPPOSITE Sign on exiting surface
+      SN= OPtr->trackOutCell(TNeut,aDist,SPtr,abs(SN));
+      if (aDist>1e30 && Pts.size()<=1)
+	{
+	  ELog::EM<<"Fail on Pts==1 and aDist INF"<<ELog::endDiag;
+	  ELog::EM<<"Index == "<<Pts.size()-2<<ELog::endDiag;
+	  ELog::EM<<"Pts[0] == "<<Pts[0].Pt<<ELog::endDiag;
+	  ELog::EM<<"Pts[0] == "<<Pts[0].Dir<<ELog::endDiag;
+	  ELog::EM<<"SN == "<<SN<<ELog::endDiag;
+	  aDist=1e-5;
+	}
+      
+      TNeut.moveForward(aDist);
+      Pts.push_back(simPoint(TNeut.Pos,TNeut.uVec,OPtr->getName(),SN,OPtr));
+      OPtr=(SN) ?
+	OSMPtr->findNextObject(SN,TNeut.Pos,OPtr->getName()) : 0;	    
+    }
+  return (OPtr) ? 1 : 0;
+}
+  
 int
 SimValid::runPoint(const Simulation& System,
 		   const Geometry::Vec3D& CP,
 		   const size_t  nAngle) const
   /*!
-    Calculate the tracking
+    Calculate the tracking. In parallel the directions
+    are taken in blocks, and the first failed direction is 
+    re-tracked in this thread to write the diagnostics.
     \param System :: Simulation to use
     \param CP :: Centre point
     \param nAngle :: Number of points to test
@@ -188,57 +261,60 @@ SimValid::runPoint(const Simulation& System,
   ELog::RegMethod RegA("SimValid","run");
   ELog::debugMethod DebA;
   
-  const ModelSupport::ObjSurfMap* OSMPtr =System.getOSM();
   MonteCarlo::Object* InitObj(0);
-  const Geometry::Surface* SPtr;          // Output surface
-  double aDist;       
-
-  // Note for sphere that you can use X,Y,Z in any orthogonal 
-  // directiron
-  double phi,theta;
 
   // Find Initial cell [Store for next time]
   //  Centre+=Geometry::Vec3D(0.001,0.001,0.001);
   InitObj=System.findCell(CP,InitObj);  
   const int initSurfNum=InitObj->isOnSide(CP);
 
-  // check surfaces
-  for(size_t i=0;i<nAngle;i++)
+  const ParallelRun& PR=ParallelRun::Instance();
+  if (PR.isParallel())
     {
-      std::vector<simPoint> Pts;
-      // Get random starting point on edge of volume
-      phi=RNG.rand()*M_PI;
-      theta=2.0*RNG.rand()*M_PI;
-      Geometry::Vec3D uVec(cos(theta)*sin(phi),
-			     sin(theta)*sin(phi),
-			     cos(phi));
-      MonteCarlo::eTrack TNeut(CP,uVec);
-
-      MonteCarlo::Object* OPtr=InitObj;
-      int SN(-initSurfNum);
+      const size_t NBlock=ParallelRun::nBlocks(nAngle);
+      const std::vector<unsigned int> seeds=
+	ParallelRun::blockSeeds(RNG,NBlock);
+      // first failed direction in each block [nAngle if none]
+      std::vector<size_t> failIndex(NBlock,nAngle);
+      std::vector<Geometry::Vec3D> failDir(NBlock);
 
-      Pts.push_back(simPoint(TNeut.Pos,TNeut.uVec,OPtr->getName(),SN,OPtr));
-      while(OPtr && OPtr->getImp())
-	{
-	  // Note: Need OPPOSITE Sign on exiting surface
-	  SN= OPtr->trackOutCell(TNeut,aDist,SPtr,abs(SN));
-	  if (aDist>1e30 && Pts.size()<=1)
+      PR.run(NBlock,[&](const size_t index)
+        {
+	  MTRand RX(seeds[index]);
+	  const size_t iEnd=ParallelRun::blockEnd(index,nAngle);
+	  for(size_t i=ParallelRun::blockStart(index,nAngle);i<iEnd;i++)
 	    {
-	      ELog::EM<<"Fail on Pts==1 and aDist INF"<<ELog::endDiag;
-	      ELog::EM<<"Index == "<<Pts.size()-2<<ELog::endDiag;
-	      ELog::EM<<"Pts[0] == "<<Pts[0].Pt<<ELog::endDiag;
-	      ELog::EM<<"Pts[0] == "<<Pts[0].Dir<<ELog::endDiag;
-	      ELog::EM<<"SN == "<<SN<<ELog::endDiag;
-	      aDist=1e-5;
+	      std::vector<simPoint> Pts;
+	      const Geometry::Vec3D uVec=randomDir(RX);
+	      if (!trackDir(System,CP,InitObj,initSurfNum,uVec,Pts))
+		{
+		  failIndex[index]=i;
+		  failDir[index]=uVec;
+		  return;
+		}
 	    }
+	});
 
-	  TNeut.moveForward(aDist);
-	  Pts.push_back(simPoint(TNeut.Pos,TNeut.uVec,OPtr->getName(),SN,OPtr));
-	  OPtr=(SN) ?
-	    OSMPtr->findNextObject(SN,TNeut.Pos,OPtr->getName()) : 0;	    
-	}
+      for(size_t index=0;index<NBlock;index++)
+	if (failIndex[index]!=nAngle)
+	  {
+	    std::vector<simPoint> Pts;
+	    trackDir(System,CP,InitObj,initSurfNum,failDir[index],Pts);
+	    ELog::EM<<"Failed to calculate cell correctly: "
+		    <<failIndex[index]<<ELog::endCrit;
+	    diagnostics(System,Pts);
+	    return 0;
+	  }
+      return 1;
+    }
 
-      if (!OPtr)
+  // check surfaces
+  for(size_t i=0;i<nAngle;i++)
+    {
+      std::vector<simPoint> Pts;
+      // Get random starting point on edge of volume
+      const Geometry::Vec3D uVec=randomDir(RNG);
+      if (!trackDir(System,CP,InitObj,initSurfNum,uVec,Pts))
 	{
 	  ELog::EM<<"Failed to calculate cell correctly: "<<i<<ELog::endCrit;
 	  if (!InitObj)
@@ -281,4 +357,266 @@ SimValid::runFixedComp(const Simulation& System,
   return 1;
 }
 
+bool
+SimValid::trackCheck(const Simulation& System,
+		     const CellIndex& CI,
+		     const std::string& startName,
+		     const Geometry::Vec3D& CP,
+		     MonteCarlo::Object* InitObj,
+		     const Geometry::Vec3D& uVec,
+		     std::vector<simFail>& Out)
+  /*!
+    Track a line from the start point to a zero importance
+    cell. The cells valid at the middle of each track
+    segment are found and a following cell is required at 
+    each surface crossing.
+    \param System :: Simulation to use
+    \param CI :: Cell index of the simulation
+    \param startName :: Name of the start point
+    \param CP :: Start point
+    \param InitObj :: Cell at the start point
+    \param uVec :: Direction
+    \param Out :: Failures [added to]
+    \return true if the track reached a zero importance cell
+  */
+{
+  const size_t maxStep(100000);    // segments before a track fails
+  const double minDist(1e-5);      // no middle check below 
+
+  const ModelSupport::ObjSurfMap* OSMPtr =System.getOSM();
+  const Geometry::Surface* SPtr;          // Output surface
+  double aDist;       
+  std::vector<MonteCarlo::Object*> cellVec;
+
+  MonteCarlo::eTrack TNeut(CP,uVec);
+  MonteCarlo::Object* OPtr=InitObj;
+  int SN(-InitObj->isOnSide(CP));
+  for(size_t step=0;OPtr && OPtr->getImp();step++)
+    {
+      const int cellN=OPtr->getName();
+      // Note: Need OPPOSITE Sign on exiting surface
+      SN=OPtr->trackOutCell(TNeut,aDist,SPtr,std::abs(SN));
+      if (aDist>1e30 || step>maxStep)
+	{
+	  Out.push_back(simFail("track",startName,cellN,0,SN,
+				TNeut.Pos,TNeut.uVec));
+	  return 0;
+	}
+      if (aDist>minDist)
+	{
+	  const Geometry::Vec3D MidPt(TNeut.Pos+TNeut.uVec*(aDist/2.0));
+	  CI.findAllCells(MidPt,cellVec);
+	  if (cellVec.size()!=1 || cellVec.front()!=OPtr)
+	    {
+	      if (cellVec.empty())
+		Out.push_back(simFail("gap",startName,cellN,0,0,
+				      MidPt,TNeut.uVec));
+	      else if (std::find(cellVec.begin(),cellVec.end(),OPtr)==
+		       cellVec.end())
+		Out.push_back(simFail("track",startName,cellN,
+				      cellVec.front()->getName(),0,
+				      MidPt,TNeut.uVec));
+	      else
+		for(const MonteCarlo::Object* CPtr : cellVec)
+		  if (CPtr!=OPtr)
+		    Out.push_back
+		      (simFail("overlap",startName,
+			       std::min(cellN,CPtr->getName()),
+			       std::max(cellN,CPtr->getName()),0,
+			       MidPt,TNeut.uVec));
+	      return 0;
+	    }
+	}
+      TNeut.moveForward(aDist);
+      OPtr=(SN) ? OSMPtr->findNextObject(SN,TNeut.Pos,cellN) : 0;
+      if (!OPtr)
+	{
+	  Out.push_back(simFail("gap",startName,cellN,0,SN,
+				TNeut.Pos,TNeut.uVec));
+	  return 0;
+	}
+    }
+  return 1;
+}
+
+bool
+SimValid::startCell(const Simulation&,
+		    const CellIndex& CI,
+		    const std::string& startName,
+		    const Geometry::Vec3D& CP,
+		    MonteCarlo::Object*& OPtr,
+		    std::vector<simFail>& Out)
+  /*!
+    Find the cell of a start point. Several cells can
+    be valid if the point is on a surface [not a failure].
+    \param CI :: Cell index of the simulation
+    \param startName :: Name of the start point
+    \param CP :: Start point
+    \param OPtr :: Cell found [first in cell order]
+    \param Out :: Failures [added to]
+    \return true if the point is in a cell with importance
+  */
+{
+  std::vector<MonteCarlo::Object*> cellVec;
+  if (!CI.findAllCells(CP,cellVec))
+    {
+      Out.push_back(simFail("gap",startName,0,0,0,
+			    CP,Geometry::Vec3D(0,0,0)));
+      OPtr=0;
+      return 0;
+    }
+  OPtr=cellVec.front();
+  return (OPtr->getImp()) ? 1 : 0;
+}
+
+bool
+SimValid::sampleCell(const MonteCarlo::Object& Obj,MTRand& RX,
+		     Geometry::Vec3D& Pt)
+  /*!
+    Find a random point within a cell from its bounding box
+    \param Obj :: Cell to sample
+    \param RX :: Random number generator
+    \param Pt :: Point found
+    \return true if a point was found
+  */
+{
+  const size_t nTry(100);
+
+  Geometry::Vec3D LPt,HPt;
+  Obj.getBoundBox(LPt,HPt);
+  if (!RuleBox::isBounded(LPt,HPt))
+    return 0;
+
+  const Geometry::Vec3D Range(HPt-LPt);
+  for(size_t i=0;i<nTry;i++)
+    {
+      Pt=LPt+Geometry::Vec3D(RX.rand()*Range[0],
+			     RX.rand()*Range[1],
+			     RX.rand()*Range[2]);
+      if (Obj.isValid(Pt))
+	return 1;
+    }
+  return 0;
+}
+
+void
+SimValid::addFails(const std::vector<simFail>& FVec)
+  /*!
+    Merge failures with those already found
+    \param FVec :: Failures of one start point
+  */
+{
+  for(const simFail& FItem : FVec)
+    {
+      std::vector<simFail>::iterator vc=
+	std::find_if(Fails.begin(),Fails.end(),
+		     [&FItem](const simFail& A)
+		     { return A.sameFail(FItem); });
+      if (vc==Fails.end())
+	Fails.push_back(FItem);
+      else
+	vc->count++;
+    }
+  return;
+}
+
+size_t
+SimValid::runAll(const Simulation& System,
+		 const size_t nAngle,
+		 const unsigned int seed)
+  /*!
+    Track random directions from the centre and link points
+    of every component and from a random point in every cell
+    with importance. Each start point is a work item with its
+    own seed [from seed] so the failures do not depend on the
+    number of threads. All the failures are kept.
+    \param System :: Simulation to use [ObjSurfMap built]
+    \param nAngle :: Number of tracks from each start point
+    \param seed :: Random seed
+    \return number of different failures
+  */
+{
+  ELog::RegMethod RegA("SimValid","runAll");
+
+  Fails.clear();
+  CellIndex CI;
+  CI.build(System.getCells());
+
+  std::vector<std::pair<std::string,Geometry::Vec3D>> FixedPts;
+  for(const auto& [name,FC] : System.getComponents())
+    {
+      FixedPts.emplace_back(name+":centre",FC->getCentre());
+      const std::vector<Geometry::Vec3D> LPts=FC->getAllLinkPts();
+      for(size_t i=0;i<LPts.size();i++)
+	FixedPts.emplace_back(name+":"+std::to_string(i+1),
+			      LPts[i]+Geometry::Vec3D(0.001,0.001,0.001));
+    }
+  std::vector<const MonteCarlo::Object*> CellPts;
+  for(const auto& [cellN,OPtr] : System.getCells())
+    if (OPtr->getImp())
+      CellPts.push_back(OPtr);
+
+  const size_t NItem(FixedPts.size()+CellPts.size());
+  MTRand RX(seed);
+  const std::vector<unsigned int> seeds=
+    ParallelRun::blockSeeds(RX,NItem);
+  std::vector<std::vector<simFail>> ItemFails(NItem);
+
+  const ParallelRun& PR=ParallelRun::Instance();
+  PR.run(NItem,[&](const size_t index)
+    {
+      MTRand RXItem(seeds[index]);
+      std::vector<simFail>& Out(ItemFails[index]);
+
+      std::string startName;
+      Geometry::Vec3D CP;
+      if (index<FixedPts.size())
+	{
+	  startName=FixedPts[index].first;
+	  CP=FixedPts[index].second;
+	}
+      else
+	{
+	  const MonteCarlo::Object* OPtr=CellPts[index-FixedPts.size()];
+	  startName="cell:"+std::to_string(OPtr->getName());
+	  if (!sampleCell(*OPtr,RXItem,CP))
+	    return;
+	}
+
+      MonteCarlo::Object* InitObj;
+      if (!startCell(System,CI,startName,CP,InitObj,Out))
+	return;
+      for(size_t i=0;i<nAngle;i++)
+	trackCheck(System,CI,startName,CP,InitObj,randomDir(RXItem),Out);
+    });
+
+  for(const std::vector<simFail>& FVec : ItemFails)
+    addFails(FVec);
+
+  ELog::EM<<"Validation : "<<NItem<<" start points : "
+	  <<Fails.size()<<" failures"<<ELog::endDiag;
+  return Fails.size();
+}
+
+void
+SimValid::writeFails(std::ostream& OX) const
+  /*!
+    Write the failures one per line as :
+    type cellA cellB surf count x y z ux uy uz start
+    \param OX :: Output stream
+  */
+{
+  OX<<"# type cellA cellB surf count x y z ux uy uz start"<<std::endl;
+  for(const simFail& FItem : Fails)
+    {
+      OX<<FItem.type<<" "<<FItem.cellA<<" "<<FItem.cellB<<" "
+	<<FItem.surfN<<" "<<FItem.count<<" "
+	<<std::setprecision(10)
+	<<FItem.Pt[0]<<" "<<FItem.Pt[1]<<" "<<FItem.Pt[2]<<" "
+	<<FItem.Dir[0]<<" "<<FItem.Dir[1]<<" "<<FItem.Dir[2]<<" "
+	<<FItem.startName<<std::endl;
+    }
+  return;
+}
+
 } // NAMESPACE ModelSupport
@@ -89,6 +89,9 @@
 #include "SourceBase.h"
 #include "sourceDataBase.h"
 #include "ObjSurfMap.h"
+#include "CellIndex.h"
+#include "ParallelRun.h"
+#include "vertexCalc.h"
 #include "ReadFunctions.h"
 #include "BaseMap.h"
 #include "CellMap.h"
@@ -98,7 +101,7 @@
 #include "Simulation.h"
 
 Simulation::Simulation()  :
-  OSMPtr(new ModelSupport::ObjSurfMap),
+  OSMPtr(new ModelSupport::ObjSurfMap),CIPtr(0),
   cellDNF(0),cellCNF(0)
   /*!
     Start of simulation Object
@@ -112,11 +115,13 @@ Simulation::Simulation(const Simulation& A) :
   inputFile(A.inputFile),
   cmdLine(A.cmdLine),DB(A.DB),
   OSMPtr(new ModelSupport::ObjSurfMap(*A.OSMPtr)),
+  CIPtr((A.CIPtr) ? new ModelSupport::CellIndex : 0),
   TList(A.TList),cellDNF(A.cellDNF),cellCNF(A.cellCNF),
   cellOutOrder(A.cellOutOrder),
   sourceName(A.sourceName)
   /*!
-    Copy constructor
+    Copy constructor. The cell index [if in use] is
+    rebuilt at the next createObjSurfMap/validateObjSurfMap
     \param A :: Simulation to copy
   */
 {
@@ -143,6 +148,8 @@ Simulation::operator=(const Simulation& A)
       OList=A.OList;
       cellOutOrder=A.cellOutOrder;
       sourceName=A.sourceName;
+      setCellIndex(A.CIPtr!=0);
+      clearCellIndex();
     }
   return *this;
 }
@@ -157,6 +164,7 @@ Simulation::~Simulation()
   ELog::RegMethod RegA("Simulation","delete operator");
 
   delete OSMPtr;
+  delete CIPtr;
   deleteObjects();
   ModelSupport::SimTrack::Instance().clearSim(this);
   
@@ -171,6 +179,7 @@ Simulation::resetAll()
   ModelSupport::surfIndex::Instance().reset();
   TList.erase(TList.begin(),TList.end());
   OSMPtr->clearAll();
+  clearCellIndex();
   deleteObjects();
   cellOutOrder.clear();
   masterRotate& MR = masterRotate::Instance();
@@ -187,6 +196,7 @@ Simulation::deleteObjects()
   ELog::RegMethod RegA("Simulation","deleteObjects");
   
   ModelSupport::SimTrack::Instance().setCell(this,0);
+  clearCellIndex();
   for(OTYPE::value_type& mc : OList)
     delete mc.second;
   
@@ -269,6 +279,7 @@ Simulation::addCell(const int cellNumber,const MonteCarlo::Object& A)
     }
   OList.emplace(cellNumber,A.clone());
   MonteCarlo::Object* QHptr=OList[cellNumber];
+  clearCellIndex();
 
   QHptr->setName(cellNumber);
   if (!QHptr->hasComplement() ||
@@ -425,6 +436,7 @@ Simulation::removeCell(const int cellNumber)
     throw ColErr::InContainerError<int>(cellNumber,"cellNumber in OList");
 
   OSMPtr->removeObject(vc->second);
+  clearCellIndex();
   
   ModelSupport::SimTrack& ST(ModelSupport::SimTrack::Instance());
   ST.checkDelete(this,vc->second);
@@ -483,6 +495,7 @@ Simulation::substituteAllSurface(const int oldSurfN,const int newSurfN)
   OTYPE::iterator oc;
   for(oc=OList.begin();oc!=OList.end();oc++)
     oc->second->substituteSurf(oldSurfN,newSurfN,XPtr);
+  clearCellIndex();
 
   // Source:
   if (!sourceName.empty())
@@ -655,7 +668,9 @@ int
 Simulation::populateCells()
   /*!
     Place a surface* with each keyN in the cell list 
-    Generate the Object map.
+    Generate the Object map. Only cells changed since
+    the last call are processed [called after each 
+    inserted component].
     \retval 0 on success, 
     \retval -1 failed to find surface key
   */
@@ -670,8 +685,7 @@ Simulation::populateCells()
       MonteCarlo::Object& workObj= *(oc->second);
       try
         {
-	  workObj.populate();
-	  workObj.createSurfaceList();
+	  workObj.updateSurfaceList();
 	}
       catch (ColErr::InContainerError<int>& A)
         {
@@ -704,8 +718,7 @@ Simulation::populateCells(const std::vector<int>& cellVec)
       MonteCarlo::Object& workObj= *(oc->second);
       try
         {
-	  workObj.populate();
-	  workObj.createSurfaceList();
+	  workObj.updateSurfaceList();
 	}
       catch (ColErr::InContainerError<int>& A)
         {
@@ -735,9 +748,11 @@ Simulation::applyTransforms()
       if (sm->second->applyTransform(TList)<0)
         {
 	  ELog::EM<<"Failed on "<<sm->first<<ELog::endErr;
+	  clearGeomCache();
 	  return 1;
 	}
     }
+  clearGeomCache();
   return 0;
 }
 
@@ -785,29 +800,35 @@ Simulation::calcVertex(const int CellN)
   MonteCarlo::Object* QH=findObject(CellN);
   if (!QH) return 0;
 
-  
-  
-  return CellN;
+  QH->populate();
+  return static_cast<int>(ModelSupport::calcVertexPoints(*QH).size());
 }
 
 void
 Simulation::calcAllVertex()
   /*! 
-     Calculates the vertexes in the Cell and stores
-     in the Object. The number of vertexes found are returned. 
+     Calculates the vertexes in all the cells and stores
+     them in each Object. Each cell is an independent 
+     work item [run in parallel]
   */
 {
   ELog::RegMethod RegA("Simulation","calcAllVertex");
 
-
-  OTYPE::iterator mc;
-
-  for(mc=OList.begin();mc!=OList.end();mc++)
+  std::vector<MonteCarlo::Object*> OVec;
+  for(const OTYPE::value_type& mc : OList)
     {
-      // This point may be outside of the point
-      //      if (!mc->second->calcVertex())   
-      //	mc->second->calcMidVertex();
+      mc.second->populate();
+      if (mc.second->getSurList().empty())
+	mc.second->createSurfaceList();
+      OVec.push_back(mc.second);
     }
+
+  const ModelSupport::ParallelRun& PR=
+    ModelSupport::ParallelRun::Instance();
+  PR.run(OVec.size(),[&OVec](const size_t index)
+    {
+      ModelSupport::calcVertexPoints(*OVec[index]);
+    });
   return;
 }
 
@@ -834,6 +855,9 @@ Simulation::updateSurface(const int SN,const std::string& SLine)
 	  oc->second->rePopulate();
 	}
     }
+  // boxes of the cells changed
+  OSMPtr->clearIndex();
+  clearCellIndex();
   return;
 }
 
@@ -867,11 +891,14 @@ Simulation::validateObjSurfMap()
       MonteCarlo::Object* objPtr(mc->second);
       if (!objPtr->isObjSurfValid() || !objPtr->isPopulated())
 	{
-	  objPtr->createSurfaceList();
+	  objPtr->updateSurfaceList();
 	  OSMPtr->addSurfaces(objPtr);
 	  objPtr->setObjSurfValid();
 	}
     }
+  OSMPtr->buildIndex();
+  if (CIPtr)
+    CIPtr->build(OList);
   return;
 } 
 
@@ -893,6 +920,68 @@ Simulation::createObjSurfMap()
       // First add surface that are opposite 
       OSMPtr->addSurfaces(mc->second);
     }  
+  OSMPtr->buildIndex();
+  createCellIndex();
+  return;
+}
+
+void
+Simulation::setCellIndex(const bool flag)
+  /*!
+    Set/Unset the use of a spatial cell index in findCell.
+    The index is built in createObjSurfMap
+    \param flag :: true to use an index
+  */
+{
+  if (flag && !CIPtr)
+    CIPtr=new ModelSupport::CellIndex;
+  else if (!flag)
+    {
+      delete CIPtr;
+      CIPtr=0;
+    }
+  return;
+}
+
+void
+Simulation::createCellIndex()
+  /*!
+    Build the spatial cell index [if in use]
+  */
+{
+  ELog::RegMethod RegA("Simulation","createCellIndex");
+  if (CIPtr)
+    CIPtr->build(OList);
+  return;
+}
+
+void
+Simulation::clearCellIndex()
+  /*!
+    Invalidate the spatial cell index after the 
+    cell list has changed
+  */
+{
+  if (CIPtr)
+    CIPtr->clearAll();
+  return;
+}
+
+void
+Simulation::clearGeomCache()
+  /*!
+    Remove the bounding boxes, vertex points and compiled
+    programs of all the cells and the indices built from
+    the boxes, after the surfaces have been moved in place.
+    The indices are rebuilt by createObjSurfMap.
+  */
+{
+  ELog::RegMethod RegA("Simulation","clearGeomCache");
+
+  for(OTYPE::value_type& OItem : OList)
+    OItem.second->clearGeomCache();
+  OSMPtr->clearIndex();
+  clearCellIndex();
   return;
 }
 
@@ -1131,6 +1220,17 @@ Simulation::findCell(const Geometry::Vec3D& Pt,
       && curObjPtr->isValid(Pt))
     return curObjPtr;
       
+  // now use the index (if built)
+  if (CIPtr && CIPtr->isBuilt())
+    {
+      MonteCarlo::Object* OPtr=CIPtr->findCell(Pt);
+      if (OPtr)
+	{
+	  ST.setCell(this,OPtr);
+	  return OPtr;
+	}
+    }
+  
   // now we need to search everthing
   OTYPE::const_iterator mpc;
   for(mpc=OList.begin();mpc!=OList.end();mpc++)
@@ -1408,6 +1508,7 @@ Simulation::renumberCells(const std::vector<int>& cOffset,
 
     }    
   OList=newMap;
+  clearCellIndex();
   return RMap;
 }
 
@@ -1706,11 +1807,14 @@ Simulation::masterRotation()
   std::map<int,Geometry::Surface*>::const_iterator sc;
   for(sc=SurMap.begin();sc!=SurMap.end();sc++)
     MR.applyFull(sc->second);
+  ModelSupport::surfIndex::Instance().rehash();
 
   // Apply to QHull if calculated:
   OTYPE::iterator oc;
   for(oc=OList.begin();oc!=OList.end();oc++)
     MR.applyFull(oc->second);
+  // cached boxes/vertices/indices are from the unrotated surfaces
+  clearGeomCache();
 
   objectGroups::rotateMaster();
   
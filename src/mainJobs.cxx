@@ -172,6 +172,8 @@ createVTK(const mainSystem::inputParam& IParam,
 	IParam.getDefValue<std::string>("","vtkType",0);
       if (vType=="cell" || vType=="Cell")
 	VTK.setType(Visit::VISITenum::cellID);
+      else if (vType=="overlap")
+	VTK.setType(Visit::VISITenum::overlap);
       else if (vType.empty())
 	VTK.setType(Visit::VISITenum::material);
       else 
@@ -196,6 +198,11 @@ createVTK(const mainSystem::inputParam& IParam,
       ELog::EM<<"VTK Type == "<<vType<<ELog::endDiag;
       if (vType=="cell" || vType=="Cell")
 	VTK.writeIntegerVTK(Oname);
+      else if (vType=="overlap")
+	{
+	  VTK.writeIntegerVTK(Oname);
+	  VTK.writeOverlapPairs(Oname+".pairs");
+	}
       else
 	VTK.writeVTK(Oname);
       return 2;
@@ -196,7 +196,7 @@ objectGroups::inRangeGroup(const int Index)
 {
   ELog::RegMethod RegA("objectGroups","inRangeGroup");
   
-  static std::string prevName;
+  static thread_local std::string prevName;
 
   // Quick check to determine if it is the same one as before!
   // Note: groupRange could have been updated to can't store
@@ -243,7 +243,7 @@ objectGroups::inRange(const int Index) const
    */
 {
   ELog::RegMethod RegA("objectGroups","inRange");
-  static std::string prevName;
+  static thread_local std::string prevName;
 
   // Quick check to determine if it is the same one as before!
   // Note: groupRange could have been updated to can't store
@@ -88,6 +88,7 @@ testAlgebra::applyTest(const int extra)
       &testAlgebra::testExpandCNFBracket,
       &testAlgebra::testInsert,
       &testAlgebra::testIsTrue,
+      &testAlgebra::testLargeLogic,
       &testAlgebra::testLogicalCover,      
       &testAlgebra::testLogicalEqual,
       &testAlgebra::testMakeString,
@@ -111,6 +112,7 @@ testAlgebra::applyTest(const int extra)
       "ExpandCNFBracket",
       "Insert",
       "IsTrue",
+      "LargeLogic",
       "LogicalCover",
       "LogicalEqual",
       "MakeString",
@@ -557,6 +559,66 @@ testAlgebra::testIsTrue()
   return 0;
 }
 
+int
+testAlgebra::testLargeLogic()
+  /*!
+    Test equality and DNF/CNF of functions with more
+    literals than a truth table allows
+    \retval 0 :: success
+   */
+{
+  ELog::RegMethod RegA("testAlgebra","testLargeLogic");
+
+  const size_t NPair(20);
+  // (x1+x2)(x3+x4)... : in reverse order / last literal changed
+  std::string AStr,BStr,CStr;
+  for(size_t i=0;i<NPair;i++)
+    {
+      const int aIndex(static_cast<int>(2*i+1));
+      const int bIndex(static_cast<int>(2*(NPair-i)));
+      AStr+="("+Acomp::strUnit(aIndex)+"+"+Acomp::strUnit(aIndex+1)+")";
+      BStr+="("+Acomp::strUnit(bIndex)+"+"+Acomp::strUnit(bIndex-1)+")";
+      CStr+="("+Acomp::strUnit(aIndex)+"+"+
+	Acomp::strUnit((i+1==NPair) ? -aIndex-1 : aIndex+1)+")";
+    }
+  Algebra A,B,C;
+  A.setFunction(AStr);
+  B.setFunction(BStr);
+  C.setFunction(CStr);
+  if (!A.logicalEqual(B) || A.logicalEqual(C))
+    {
+      ELog::EM<<"A == "<<A<<ELog::endDiag;
+      ELog::EM<<"B == "<<B<<ELog::endDiag;
+      ELog::EM<<"C == "<<C<<ELog::endDiag;
+      return -1;
+    }
+
+  // x1 + x2 x3 ... x30 : DNF and CNF
+  std::string DStr;
+  for(int i=2;i<=30;i++)
+    DStr+="("+Acomp::strUnit(1)+"+"+Acomp::strUnit(i)+")";
+  Algebra D,E;
+  D.setFunction(DStr);
+  E.setFunction(DStr);
+  D.makeDNF();
+  if (!D.logicalEqual(E) || !D.getComp().isDNF() ||
+      D.countLiterals()!=30)
+    {
+      ELog::EM<<"DNF of "<<E<<ELog::endDiag;
+      ELog::EM<<"DNF == "<<D<<ELog::endDiag;
+      return -1;
+    }
+  D.makeCNF();
+  if (!D.logicalEqual(E) || !D.getComp().isCNF() ||
+      D.getComp().size().second!=29)
+    {
+      ELog::EM<<"CNF of "<<E<<ELog::endDiag;
+      ELog::EM<<"CNF == "<<D<<ELog::endDiag;
+      return -1;
+    }
+  return 0;
+}
+
 int
 testAlgebra::testLogicalEqual()
   /*!
@@ -80,6 +80,7 @@ testFunction::applyTest(const int extra)
     {
       &testFunction::testAnalyse,
       &testFunction::testBuiltIn,
+      &testFunction::testCacheChange,
       &testFunction::testCopyVarSet,
       &testFunction::testEval,
       &testFunction::testString, 
@@ -92,6 +93,7 @@ testFunction::applyTest(const int extra)
     {
       "Analyse",
       "BuiltIn",
+      "CacheChange",
       "CopyVarSet",
       "Eval",
       "String",
@@ -208,6 +210,64 @@ testFunction::testBuiltIn()
   return 0;
 }
 
+int
+testFunction::testCacheChange()
+  /*!
+    Test that a cached function value follows a change
+    of the variables it uses [and only in its own database]
+    \return 0 on succes and -ve on failure
+  */
+{
+  ELog::RegMethod RegA("testFunction","testCacheChange");
+
+  FuncDataBase Control;
+  Control.addVariable("lenA",2.0);
+  Control.Parse("lenA*3.0");
+  Control.addVariable("lenB");
+  Control.Parse("lenB+1.0");
+  Control.addVariable("lenC");
+
+  // variable : value : expected lenC
+  typedef std::tuple<std::string,double,double> TTYPE;
+  const std::vector<TTYPE> Tests=
+    {
+      TTYPE("lenA",2.0,7.0),
+      TTYPE("lenA",5.0,16.0),
+      TTYPE("lenB",3.0,4.0)
+    };
+
+  for(const TTYPE& tc : Tests)
+    {
+      Control.setVariable(std::get<0>(tc),std::get<1>(tc));
+      // read twice to use the cache
+      const double CA=Control.EvalVar<double>("lenC");
+      const double CB=Control.EvalVar<double>("lenC");
+      if (std::abs(CA-std::get<2>(tc))>1e-10 ||
+	  std::abs(CB-std::get<2>(tc))>1e-10)
+	{
+	  ELog::EM<<"Failed on set "<<std::get<0>(tc)<<" = "
+		  <<std::get<1>(tc)<<ELog::endDiag;
+	  ELog::EM<<"lenC == "<<CA<<" "<<CB<<" expected "
+		  <<std::get<2>(tc)<<ELog::endDiag;
+	  return -1;
+	}
+    }
+
+  // copies must evaluate against their own variables
+  Control.Parse("lenA*3.0");
+  Control.setVariable("lenB");
+  FuncDataBase Copy(Control);
+  Copy.setVariable("lenA",10.0);
+  if (std::abs(Copy.EvalVar<double>("lenC")-31.0)>1e-10 ||
+      std::abs(Control.EvalVar<double>("lenC")-16.0)>1e-10)
+    {
+      ELog::EM<<"Failed on copy : "<<Copy.EvalVar<double>("lenC")<<" "
+	      <<Control.EvalVar<double>("lenC")<<ELog::endDiag;
+      return -1;
+    }
+  return 0;
+}
+
 int
 testFunction::testCopyVarSet()
   /*!
@@ -87,10 +87,12 @@ testModelSupport::applyTest(const int extra)
   typedef int (testModelSupport::*testPtr)();
   testPtr TPtr[]=
     {
+      &testModelSupport::testGetHeadRule,
       &testModelSupport::testRemoveOpenPair
     };
   const std::string TestName[]=
     {
+      "GetHeadRule",
       "RemoveOpenPair",
     };
   
@@ -118,6 +120,52 @@ testModelSupport::applyTest(const int extra)
   return 0;
 }
 
+int
+testModelSupport::testGetHeadRule()
+  /*!
+    Test the template HeadRule matches the string from getComposite
+    \return 0 on success
+  */
+{
+  ELog::RegMethod RegA("testModelSupport","testGetHeadRule");
+
+  ModelSupport::surfRegister SMap;
+  SMap.addMatch(103,7);
+  SMap.addMatch(205,-8);
+  SMap.addMatch(11,12);
+
+  typedef std::tuple<int,int,std::string> TTYPE;
+  const std::vector<TTYPE> Tests=
+    {
+      TTYPE(100,200,"1 -2 3 -4"),
+      TTYPE(100,200,"1 -2 (3:-4) 11T 5M"),
+      TTYPE(-100,200,"1 -2 #(3 -4) -11T"),
+      TTYPE(100,-200,"(1 : -3 : 5M) -2M")
+    };
+  
+  for(const TTYPE& tc : Tests)
+    {
+      const int offset(std::get<0>(tc));
+      const int minorOffset(std::get<1>(tc));
+      const std::string& cellStr(std::get<2>(tc));
+      const HeadRule Expect(ModelSupport::getComposite
+			    (SMap,offset,minorOffset,cellStr));
+      // second call uses the cached template
+      for(size_t i=0;i<2;i++)
+	{
+	  const HeadRule Res=
+	    ModelSupport::getHeadRule(SMap,offset,minorOffset,cellStr);
+	  if (Res.display()!=Expect.display())
+	    {
+	      ELog::EM<<"Cell    == "<<cellStr<<ELog::endDiag;
+	      ELog::EM<<"Result  == "<<Res.display()<<ELog::endDiag;
+	      ELog::EM<<"Expect  == "<<Expect.display()<<ELog::endDiag;
+	      return -1;
+	    }
+	}
+    }
+  return 0;
+}
 
 int
 testModelSupport::testRemoveOpenPair()
@@ -33,6 +33,7 @@
 #include <string>
 #include <algorithm>
 #include <memory>
+#include <tuple>
 
 #include "Exception.h"
 #include "FileReport.h"
@@ -91,11 +92,13 @@ testObjSurfMap::applyTest(const int extra)
   typedef int (testObjSurfMap::*testPtr)();
   testPtr TPtr[]=
     {
+      &testObjSurfMap::testFindNext,
       &testObjSurfMap::testMap
     };
 
   const std::string TestName[]=
     {
+      "FindNext",
       "Map"
     };
 
@@ -146,6 +149,87 @@ testObjSurfMap::createSurfaces()
   return;
 }
 
+int
+testObjSurfMap::testFindNext()
+  /*!
+    Test the boxed index in findNextObject gives the
+    same object as the search of all the objects [first
+    in map order if objects overlap]
+    \returns 0 on succes and -ve on failure
+  */
+{
+  ELog::RegMethod RegA("testObjSurfMap","testFindNext");
+
+  ModelSupport::surfIndex& SurI=ModelSupport::surfIndex::Instance();
+  // slabs in x
+  for(int i=0;i<6;i++)
+    SurI.createSurface(11+i,"px "+std::to_string(2*i));
+  SurI.createSurface(21,"pz 0");
+  SurI.createSurface(22,"pz 1");
+  SurI.createSurface(23,"pz 3");
+  SurI.createSurface(24,"pz 5");
+
+  // row of cells below/above surface 22
+  std::vector<std::shared_ptr<MonteCarlo::Object> > OVec;
+  for(int i=0;i<5;i++)
+    {
+      const std::string slab=std::to_string(11+i)+" "+
+	std::to_string(-12-i)+" 3 -4 ";
+      OVec.push_back(std::make_shared<MonteCarlo::Object>
+		     (10+i,1,0.1,slab+"21 -22"));
+      OVec.push_back(std::make_shared<MonteCarlo::Object>
+		     (20+i,1,0.1,slab+"22 -23"));
+    }
+  // overlapping cells above surface 23
+  OVec.push_back(std::make_shared<MonteCarlo::Object>
+		 (30,1,0.1,"11 -13 3 -4 23 -24"));
+  OVec.push_back(std::make_shared<MonteCarlo::Object>
+		 (31,1,0.1,"11 -16 3 -4 23 -24"));
+
+  ObjSurfMap OM;
+  for(std::shared_ptr<MonteCarlo::Object>& OPtr : OVec)
+    {
+      OPtr->populate();
+      OPtr->createSurfaceList();
+      OM.addSurfaces(OPtr.get());
+    }
+  const ObjSurfMap linearOM(OM);    // not indexed
+  OM.buildIndex();
+
+  // SN : point : exclude : expected object
+  typedef std::tuple<int,Geometry::Vec3D,int,int> TTYPE;
+  std::vector<TTYPE> Tests;
+  for(int i=4;i>=0;i--)
+    {
+      const Geometry::Vec3D Pt(1.0+2*i,0.0,1.0);
+      Tests.push_back(TTYPE(22,Pt,10+i,20+i));
+      Tests.push_back(TTYPE(-22,Pt,20+i,10+i));
+    }
+  // overlap : result must not depend on the previous search
+  Tests.push_back(TTYPE(23,Geometry::Vec3D(1,0,3),20,30));
+  Tests.push_back(TTYPE(23,Geometry::Vec3D(7,0,3),23,31));
+  Tests.push_back(TTYPE(23,Geometry::Vec3D(1,0,3),20,30));
+
+  for(const TTYPE& tc : Tests)
+    {
+      const int SN(std::get<0>(tc));
+      const Geometry::Vec3D& Pt(std::get<1>(tc));
+      const int exclude(std::get<2>(tc));
+      const MonteCarlo::Object* APtr=OM.findNextObject(SN,Pt,exclude);
+      const MonteCarlo::Object* BPtr=
+	linearOM.findNextObject(SN,Pt,exclude);
+      if (!APtr || APtr!=BPtr || APtr->getName()!=std::get<3>(tc))
+	{
+	  ELog::EM<<"Failed on "<<SN<<" at "<<Pt<<ELog::endDiag;
+	  ELog::EM<<"Index  == "<<(APtr ? APtr->getName() : 0)
+		  <<ELog::endDiag;
+	  ELog::EM<<"Expect == "<<std::get<3>(tc)<<ELog::endDiag;
+	  return -1;
+	}
+    }
+  return 0;
+}
+
 int
 testObjSurfMap::testMap()
   /*!
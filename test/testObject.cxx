@@ -57,8 +57,11 @@
 #include "surfIndex.h"
 #include "HeadRule.h"
 #include "Object.h"
+#include "RuleProgram.h"
 #include "particle.h"
 #include "eTrack.h"
+#include "SurfVertex.h"
+#include "vertexCalc.h"
 
 #include "Debug.h"
 
@@ -181,27 +184,39 @@ testObject::applyTest(const int extra)
   typedef int (testObject::*testPtr)();
   testPtr TPtr[]=
     {
+      &testObject::testAddIntersection,
+      &testObject::testBoundBox,
+      &testObject::testCalcVertex,
       &testObject::testCellStr,
       &testObject::testComplement,
       &testObject::testIsValid,
+      &testObject::testIsValidBlock,
       &testObject::testIsOnSide,
       &testObject::testMakeComplement,
       &testObject::testRemoveComplement,
+      &testObject::testRuleProgram,
       &testObject::testSetObject,
       &testObject::testSetObjectExtra,
+      &testObject::testSurfaceList,
       &testObject::testTrackCell,
       &testObject::testWriteFluka
     };
   const std::string TestName[]=
     {
+      "AddIntersection",
+      "BoundBox",
+      "CalcVertex",
       "CellStr",
       "Complement",
       "IsValid",
+      "IsValidBlock",
       "IsOnSide",
       "MakeComplement",
       "RemoveComplement",
+      "RuleProgram",
       "SetObject",
       "SetObjectExtra",
+      "SurfaceList",
       "TrackCell",
       "WriteFluka"
     };
@@ -231,6 +246,225 @@ testObject::applyTest(const int extra)
 }
 
 
+int
+testObject::testAddIntersection()
+  /*!
+    Test the structured insertion of rules gives the same
+    cell as the string insertion
+    \retval 0 :: success
+  */
+{
+  ELog::RegMethod RegA("testObject","testAddIntersection");
+
+  createSurfaces();
+
+  typedef std::tuple<std::string,std::vector<std::string>> TTYPE;
+  const std::vector<TTYPE> Tests=
+    {
+      TTYPE("4 10 0.05524655 -100",{"#(1 -2 3 -4 5 -6)"}),
+      TTYPE("5 0 -100 (-11:12:-13:14:-15:16)",
+	    {"(-21:22:-3:4:-5:6)","-5"}),
+      TTYPE("6 10 0.05524655 (1 -2 3 -4) : (21 -22 -100)",
+	    {"(-1:2:-3:4:-5:6)","-100","#(21 -22 3 -4 5 -6)"}),
+      TTYPE("7 0 -100",{"(-11:12:-13:14:-15:16)","(-21:22:-3:4:-5:6)",
+			"-14","13","(-1:2)"})
+    };
+
+  for(const TTYPE& tc : Tests)
+    {
+      Object A;
+      A.setObject(std::get<0>(tc));
+      Object B(A);
+      Object C(A);
+      std::vector<HeadRule> CVec;
+      for(const std::string& XStr : std::get<1>(tc))
+	{
+	  A.addSurfString(XStr);
+	  B.addIntersection(HeadRule(XStr));
+	  CVec.push_back(HeadRule(XStr));
+	}
+      C.addIntersection(CVec);
+      A.populate();
+      B.populate();
+      C.populate();
+
+      if (A.getHeadRule().getSurfSet()!=B.getHeadRule().getSurfSet() ||
+	  A.getHeadRule().getSurfSet()!=C.getHeadRule().getSurfSet())
+	{
+	  ELog::EM<<"Failed on surfaces "<<std::get<0>(tc)<<ELog::endDiag;
+	  return -1;
+	}
+      for(double x=-27.0;x<27.0;x+=0.5)
+	for(double y=-4.0;y<4.0;y+=0.25)
+	  {
+	    const Geometry::Vec3D Pt(x,y,0.5*y);
+	    if (A.isValid(Pt)!=B.isValid(Pt) ||
+		A.isValid(Pt)!=C.isValid(Pt))
+	      {
+		ELog::EM<<"Failed on "<<std::get<0>(tc)<<ELog::endDiag;
+		ELog::EM<<"Point= "<<Pt<<ELog::endDiag;
+		ELog::EM<<"A= "<<A.cellCompStr()<<ELog::endDiag;
+		ELog::EM<<"B= "<<B.cellCompStr()<<ELog::endDiag;
+		ELog::EM<<"C= "<<C.cellCompStr()<<ELog::endDiag;
+		return -2;
+	      }
+	  }
+    }
+  return 0;
+}
+
+int
+testObject::testBoundBox()
+  /*!
+    Test the bounding box and that it is recalculated
+    after a change of the surfaces [also in place] but
+    not by a populate of an unchanged cell
+    \retval 0 :: success
+  */
+{
+  ELog::RegMethod RegA("testObject","testBoundBox");
+
+  createSurfaces();
+  
+  // cell : Lower Box : Upper Box
+  typedef std::tuple<std::string,Geometry::Vec3D,Geometry::Vec3D> TTYPE;
+  const std::vector<TTYPE> Tests=
+    {
+      TTYPE("4 10 0.05 1 -2 3 -4 5 -6",
+	    Geometry::Vec3D(-1,-1,-1),Geometry::Vec3D(1,1,1)),
+      TTYPE("5 10 0.05 (1 -2 3 -4 5 -6) : (21 -22 3 -4 5 -6)",
+	    Geometry::Vec3D(-1,-1,-1),Geometry::Vec3D(15,1,1)),
+      TTYPE("6 10 0.05 -100 11",
+	    Geometry::Vec3D(-3,-25,-25),Geometry::Vec3D(25,25,25))
+    };
+
+  for(const TTYPE& tc : Tests)
+    {
+      Object A;
+      A.setObject(std::get<0>(tc));
+      A.populate();
+      Geometry::Vec3D LPt,HPt;
+      A.getBoundBox(LPt,HPt);
+      if (LPt.Distance(std::get<1>(tc))>1e-3 ||
+	  HPt.Distance(std::get<2>(tc))>1e-3)
+	{
+	  ELog::EM<<"Failed on "<<std::get<0>(tc)<<ELog::endDiag;
+	  ELog::EM<<"Box    == "<<LPt<<" : "<<HPt<<ELog::endDiag;
+	  ELog::EM<<"Expect == "<<std::get<1>(tc)<<" : "
+		  <<std::get<2>(tc)<<ELog::endDiag;
+	  return -1;
+	}
+    }
+
+  // box changes with the surface
+  Object A;
+  A.setObject("4 10 0.05 1 -2 3 -4 5 -6");
+  A.populate();
+  Geometry::Vec3D LPt,HPt;
+  A.getBoundBox(LPt,HPt);
+  A.substituteSurf(2,12,0);
+  A.getBoundBox(LPt,HPt);
+  if (HPt.Distance(Geometry::Vec3D(3,1,1))>1e-3)
+    {
+      ELog::EM<<"Failed on substitute : "<<LPt<<" : "<<HPt<<ELog::endDiag;
+      return -2;
+    }
+
+  // surfaces moved in place [transComp/masterRotate]
+  ModelSupport::surfIndex& SurI=ModelSupport::surfIndex::Instance();
+  const Geometry::Vec3D shift(0,0,4);
+  Object B;
+  B.setObject("4 10 0.05 1 -2 3 -4 5 -6");
+  B.populate();
+  B.getBoundBox(LPt,HPt);
+  B.setVertexPoints({Geometry::Vec3D(0,0,0)});
+  for(const int SN : B.getHeadRule().getSurfSet())
+    SurI.getSurf(std::abs(SN))->displace(shift);
+  B.displace(shift);
+  const bool vFlag(B.hasVertexPoints());
+  B.getBoundBox(LPt,HPt);
+  for(const int SN : B.getHeadRule().getSurfSet())
+    SurI.getSurf(std::abs(SN))->displace(-shift);
+  if (vFlag ||
+      LPt.Distance(Geometry::Vec3D(-1,-1,3))>1e-3 ||
+      HPt.Distance(Geometry::Vec3D(1,1,5))>1e-3)
+    {
+      ELog::EM<<"Failed on displace : "<<LPt<<" : "<<HPt<<ELog::endDiag;
+      return -3;
+    }
+
+  // cell without a compiled program [#] keeps its caches
+  Object C;
+  C.setObject("7 0 -100 #4");
+  C.populate();
+  C.getBoundBox(LPt,HPt);
+  C.setVertexPoints({Geometry::Vec3D(0,0,0)});
+  C.populate();
+  if (!C.hasVertexPoints())
+    {
+      ELog::EM<<"Failed on populate cache : "<<C<<ELog::endDiag;
+      return -4;
+    }
+  return 0;
+}
+
+int
+testObject::testCalcVertex()
+  /*!
+    Test the vertex [pruned triples] are the same as those 
+    of all the surface triples and are kept by the object
+    \retval 0 :: success
+  */
+{
+  ELog::RegMethod RegA("testObject","testCalcVertex");
+
+  createSurfaces();
+  ModelSupport::surfIndex& SurI=ModelSupport::surfIndex::Instance();
+  SurI.createSurface(31,"c/y 2.0 0.0 3.0");
+  SurI.createSurface(32,"s 0 0 2 1.5");
+  
+  // cell : number of vertex
+  typedef std::tuple<std::string,size_t> TTYPE;
+  const std::vector<TTYPE> Tests=
+    {
+      TTYPE("4 10 0.05 1 -2 3 -4 5 -6",8),
+      TTYPE("5 10 0.05 11 -12 13 -14 15 -16 (-1:2:-3:4:-5:6)",16),
+      TTYPE("6 10 0.05 -31 3 -4 1 -2",0),
+      TTYPE("7 10 0.05 -32 11 -12 13 -14 15 -16 21",0)
+    };
+
+  for(const TTYPE& tc : Tests)
+    {
+      Object A;
+      A.setObject(std::get<0>(tc));
+      A.populate();
+      A.createSurfaceList();
+
+      std::vector<MonteCarlo::SurfVertex> VList;
+      const std::vector<const Geometry::Surface*>& SL=A.getSurList();
+      for(size_t i=0;i<SL.size();i++)
+	for(size_t j=i+1;j<SL.size();j++)
+	  for(size_t k=j+1;k<SL.size();k++)
+	    ModelSupport::getIntersect(A,SL[i],SL[j],SL[k],VList);
+
+      const std::vector<Geometry::Vec3D> VPts=
+	ModelSupport::calcVertexPoints(A);
+      
+      bool flag(A.hasVertexPoints() && 
+		VList.size()==VPts.size() &&
+		A.getVertexPoints().size()==VPts.size());
+      for(size_t i=0;flag && i<VPts.size();i++)
+	flag=(VList[i].getPoint().Distance(VPts[i])<1e-8);
+      if (!flag || VPts.size()<std::get<1>(tc))
+	{
+	  ELog::EM<<"Failed on "<<std::get<0>(tc)<<" : "
+		  <<VPts.size()<<" "<<VList.size()<<ELog::endDiag;
+	  return -1;
+	}
+    }
+  return 0;
+}
+
 int
 testObject::testCellStr()
   /*!
@@ -427,6 +661,101 @@ testObject::testComplement()
   return 0;
 }
 
+int
+testObject::testRuleProgram() 
+  /*!
+    Test the compiled rule program gives the same 
+    result as the rule tree
+    \retval 0 :: success
+  */
+{
+  ELog::RegMethod RegA("testObject","testRuleProgram");
+
+  createSurfaces();
+
+  const std::vector<std::string> Tests=
+    {
+      "4 10 0.05524655  1 -2 3 -4 5 -6",
+      "5 10 0.05524655 -100 (-11:12:-13:14:-15:16)",
+      "6 10 0.05524655 11 -12 13 -14 15 -16 #(1 -2 3 -4 5 -6)",
+      "7 10 0.05524655 (1 -2 3 -4) : (21 -22 -100) : (-5 : 6) 100",
+      "8 10 0.05524655 -100 #(11 -12 #(1 -2 3 -4 5 -6) 13 -14 15 -16)"
+    };
+
+  for(const std::string& cellStr : Tests)
+    {
+      Object A;
+      A.setObject(cellStr);
+      A.populate();
+      const HeadRule& HR=A.getHeadRule();
+      for(double x=-27.0;x<27.0;x+=0.5)
+	for(double y=-4.0;y<4.0;y+=0.25)
+	  {
+	    const Geometry::Vec3D Pt(x,y,0.5*y);
+	    const int SN(((x>0.0) ? 1 : -1)*((y>0.0) ? 2 : 12));
+	    if (A.isValid(Pt)!=HR.isValid(Pt) ||
+		A.isValid(Pt,SN)!=HR.isValid(Pt,SN) ||
+		A.isDirectionValid(Pt,SN)!=HR.isDirectionValid(Pt,SN))
+	      {
+		ELog::EM<<"Failed on "<<cellStr<<ELog::endDiag;
+		ELog::EM<<"Point= "<<Pt<<" SN="<<SN<<ELog::endDiag;
+		ELog::EM<<"Display= "<<HR.display(Pt)<<ELog::endDiag;
+		return -1;
+	      }
+	  }
+    }
+  return 0;
+}
+
+int
+testObject::testIsValidBlock() 
+  /*!
+    Test the block validity [Surface::sideBlock] gives
+    the same result as the single point test
+    \retval 0 :: success
+  */
+{
+  ELog::RegMethod RegA("testObject","testIsValidBlock");
+
+  createSurfaces();
+  ModelSupport::surfIndex& SurI=ModelSupport::surfIndex::Instance();
+  SurI.createSurface(31,"c/y 2.0 0.0 3.0");
+  SurI.createSurface(32,"gq 1 0.5 1 0 0 0 0 0 0 -16");
+  SurI.createSurface(33,"kz 1 2");
+
+  const std::vector<std::string> Tests=
+    {
+      "4 10 0.05524655  1 -2 3 -4 5 -6",
+      "5 10 0.05524655 -100 (-11:12:-13:14:-15:16)",
+      "6 10 0.05524655 -31 -32 #(1 -2 3 -4 5 -6)",
+      "7 10 0.05524655 (1 -2 3 -4) : (21 -22 -100) : -33"
+    };
+
+  // grid with points on the surfaces
+  std::vector<Geometry::Vec3D> Pts;
+  for(double x=-27.0;x<27.0;x+=0.5)
+    for(double y=-4.0;y<4.0;y+=0.25)
+      Pts.push_back(Geometry::Vec3D(x,y,0.5*y));
+
+  std::vector<char> Out(Pts.size());
+  for(const std::string& cellStr : Tests)
+    {
+      Object A;
+      A.setObject(cellStr);
+      A.populate();
+      A.isValidBlock(Pts.data(),Pts.size(),Out.data());
+      for(size_t i=0;i<Pts.size();i++)
+	if (Out[i]!=A.isValid(Pts[i]))
+	  {
+	    ELog::EM<<"Failed on "<<cellStr<<ELog::endDiag;
+	    ELog::EM<<"Point= "<<Pts[i]<<" Block="
+		    <<static_cast<int>(Out[i])<<ELog::endDiag;
+	    return -1;
+	  }
+    }
+  return 0;
+}
+
 int
 testObject::testIsValid() 
   /*!
@@ -547,6 +876,72 @@ testObject::testIsOnSide()
   return 0;
 }
 
+int
+testObject::testSurfaceList()
+  /*!
+    Test the surface list is only rebuilt by updateSurfaceList
+    after the rule has changed
+    \retval 0 :: success
+  */
+{
+  ELog::RegMethod RegA("testObject","testSurfaceList");
+
+  createSurfaces();
+
+  // cell : added rule : surface set after the addition
+  typedef std::tuple<std::string,std::string,std::set<int>> TTYPE;
+  const std::vector<TTYPE> Tests=
+    {
+      TTYPE("4 10 0.05 1 -2 3 -4","5 -6",{1,-2,3,-4,5,-6}),
+      TTYPE("5 0 -100","(-11:12:-13:14:-15:16)",
+	    {-100,-11,12,-13,14,-15,16}),
+      TTYPE("6 0 -100","(-1:2:-3:4:-5:6)",
+	    {-100,-1,2,-3,4,-5,6})
+    };
+
+  for(const TTYPE& tc : Tests)
+    {
+      Object A;
+      A.setObject(std::get<0>(tc));
+      A.updateSurfaceList();
+      const std::set<int> initSet=A.getSurfSet();
+      A.updateSurfaceList();
+      if (!A.isSurfListValid() || A.getSurfSet()!=initSet)
+	{
+	  ELog::EM<<"Failed on initial "<<std::get<0>(tc)<<ELog::endDiag;
+	  return -1;
+	}
+
+      A.addIntersection(HeadRule(std::get<1>(tc)));
+      if (A.isSurfListValid())
+	{
+	  ELog::EM<<"Failed to invalidate "<<std::get<0>(tc)<<ELog::endDiag;
+	  return -1;
+	}
+      A.updateSurfaceList();
+      if (!A.isSurfListValid() ||
+	  A.getSurfSet()!=std::get<2>(tc) ||
+	  A.getSurList().size()!=std::get<2>(tc).size())
+	{
+	  ELog::EM<<"Failed on "<<std::get<0>(tc)<<" : "
+		  <<std::get<1>(tc)<<ELog::endDiag;
+	  for(const int SN : A.getSurfSet())
+	    ELog::EM<<"Surf == "<<SN<<ELog::endDiag;
+	  return -1;
+	}
+
+      A.makeComplement();
+      A.updateSurfaceList();
+      if (A.getSurfSet().find(-*std::get<2>(tc).begin())==
+	  A.getSurfSet().end())
+	{
+	  ELog::EM<<"Failed on complement "<<std::get<0>(tc)<<ELog::endDiag;
+	  return -1;
+	}
+    }
+  return 0;
+}
+
 int
 testObject::testTrackCell() 
   /*!
@@ -35,6 +35,7 @@
 #include <iterator>
 #include <memory>
 #include <tuple>
+#include <boost/multi_array.hpp>
 
 
 #include "Exception.h"
@@ -48,6 +49,10 @@
 #include "MatrixBase.h"
 #include "Matrix.h"
 #include "Vec3D.h"
+#include "Mesh3D.h"
+#include "Surface.h"
+#include "Quadratic.h"
+#include "Plane.h"
 #include "varList.h"
 #include "Code.h"
 #include "FItem.h"
@@ -66,6 +71,10 @@
 #include "LineTrack.h"
 #include "ObjectTrackAct.h"
 #include "ObjectTrackPoint.h"
+#include "ObjectTrackPlane.h"
+#include "ParallelRun.h"
+#include "WWGTrack.h"
+#include "WWGWeight.h"
 
 #include "testFunc.h"
 #include "testObjectTrackAct.h"
@@ -93,6 +102,9 @@ testObjectTrackAct::initSim()
   */
 {
   ASim.resetAll();
+  // cells below the first cell zone belong to World
+  ASim.objectGroups::reset();
+  ASim.cell("World");
   createSurfaces();
   createObjects();
   ASim.createObjSurfMap();
@@ -183,11 +195,15 @@ testObjectTrackAct::applyTest(const int extra)
   typedef int (testObjectTrackAct::*testPtr)();
   testPtr TPtr[]=
     {
-      &testObjectTrackAct::testPointDet
+      &testObjectTrackAct::testPointDet,
+      &testObjectTrackAct::testWWGTrack,
+      &testObjectTrackAct::testWWGWeight
     };
   const std::string TestName[]=
     {
-      "PointDet"
+      "PointDet",
+      "WWGTrack",
+      "WWGWeight"
     };
   
   const int TSize(sizeof(TPtr)/sizeof(testPtr));
@@ -259,3 +275,150 @@ testObjectTrackAct::testPointDet()
   return 0;
 }
 
+
+int
+testObjectTrackAct::testWWGTrack()
+  /*!
+    Test the cached mesh tracks against the single
+    object tracks 
+    \return 0 on success and -1 on error
+  */
+{
+  ELog::RegMethod RegA("testObjectTrackAct","testWWGTrack");
+
+  std::vector<Geometry::Vec3D> gridPts;
+  for(double y=-2.5;y<3.0;y+=1.0)
+    for(double z=-0.5;z<1.0;z+=1.0)
+      gridPts.push_back(Geometry::Vec3D(-5.0,y,z));
+
+  const Geometry::Vec3D aimPt(20.0,0.0,0.0);
+  const Geometry::Plane aimPlane(1,0,Geometry::Vec3D(12.0,0,0),
+				 Geometry::Vec3D(1,0,0));
+
+  WeightSystem::WWGTrack PointTrack;
+  WeightSystem::WWGTrack PlaneTrack;
+  PointTrack.build(ASim,aimPt,gridPts);
+  PlaneTrack.build(ASim,aimPlane,gridPts);
+
+  if (!PointTrack.isCached(aimPt,gridPts) ||
+      PointTrack.isCached(aimPlane,gridPts) ||
+      !PlaneTrack.isCached(aimPlane,gridPts) ||
+      PointTrack.size()!=gridPts.size())
+    {
+      ELog::EM<<"Failed on cache state"<<ELog::endDiag;
+      return -1;
+    }
+
+  for(size_t i=0;i<gridPts.size();i++)
+    {
+      ObjectTrackPoint OA(aimPt);
+      ObjectTrackPlane OB(aimPlane);
+      OA.addUnit(ASim,1,gridPts[i]);
+      OB.addUnit(ASim,1,gridPts[i]);
+
+      if (std::abs(OA.getDistance(1)-PointTrack.getDistance(i))>1e-5 ||
+	  std::abs(OA.getAttnSum(1,1.0)-PointTrack.getAttnSum(i,1.0))>1e-5 ||
+	  std::abs(OB.getDistance(1)-PlaneTrack.getDistance(i))>1e-5 ||
+	  std::abs(OB.getAttnSum(1,1.0)-PlaneTrack.getAttnSum(i,1.0))>1e-5)
+	{
+	  ELog::EM<<"Failed on point "<<gridPts[i]<<ELog::endDiag;
+	  ELog::EM<<"Point Dist/Attn "<<OA.getDistance(1)<<" "
+		  <<OA.getAttnSum(1,1.0)<<" :: "
+		  <<PointTrack.getDistance(i)<<" "
+		  <<PointTrack.getAttnSum(i,1.0)<<ELog::endDiag;
+	  ELog::EM<<"Plane Dist/Attn "<<OB.getDistance(1)<<" "
+		  <<OB.getAttnSum(1,1.0)<<" :: "
+		  <<PlaneTrack.getDistance(i)<<" "
+		  <<PlaneTrack.getAttnSum(i,1.0)<<ELog::endDiag;
+	  return -1;
+	}
+    }
+
+  // threaded build must give the same cache
+  std::vector<Geometry::Vec3D> fineGrid;
+  for(double y=-2.6;y<2.7;y+=0.25)
+    for(double z=-2.5;z<2.6;z+=0.5)
+      fineGrid.push_back(Geometry::Vec3D(-5.0,y,z));
+
+  ModelSupport::ParallelRun& PR=ModelSupport::ParallelRun::Instance();
+  WeightSystem::WWGTrack SerialTrack;
+  WeightSystem::WWGTrack ThreadTrack;
+  SerialTrack.build(ASim,aimPt,fineGrid);
+  PR.setThreads(4);
+  ThreadTrack.build(ASim,aimPt,fineGrid);
+  PR.setThreads(1);
+
+  if (ThreadTrack.size()!=fineGrid.size())
+    {
+      ELog::EM<<"Thread size == "<<ThreadTrack.size()<<ELog::endDiag;
+      return -2;
+    }
+  for(size_t i=0;i<fineGrid.size();i++)
+    if (SerialTrack.getDistance(i)!=ThreadTrack.getDistance(i) ||
+	SerialTrack.getAttnSum(i,1.0)!=ThreadTrack.getAttnSum(i,1.0))
+      {
+	ELog::EM<<"Failed on thread point "<<fineGrid[i]<<ELog::endDiag;
+	return -2;
+      }
+  
+  return 0;
+}
+
+int
+testObjectTrackAct::testWWGWeight()
+  /*!
+    Test the mesh weights [all energy bins from one
+    cached track] against the single track distTrack
+    with one and with several threads
+    \return 0 on success and -1 on error
+  */
+{
+  ELog::RegMethod RegA("testObjectTrackAct","testWWGWeight");
+
+  // enough points for several WWGTrack blocks
+  Geometry::Mesh3D WMesh;
+  WMesh.setMesh({-5.5,-4.5},{1},{-5.5,5.5},{22},{-2.5,2.5},{10});
+  const std::vector<Geometry::Vec3D> midPts=WMesh.midPoints();
+
+  const Geometry::Vec3D aimPt(20.0,0.0,0.0);
+  const std::vector<double> EBand({0.01,1.0,20.0});
+  const double densityFactor(1.0);
+  const double r2Length(1.0);
+  const double r2Power(2.0);
+
+  ModelSupport::ParallelRun& PR=ModelSupport::ParallelRun::Instance();
+  for(const size_t nThread : {1,4})
+    {
+      PR.setThreads(nThread);
+      WeightSystem::WWGWeight WW(EBand.size(),WMesh);
+      WW.wTrack(ASim,aimPt,EBand,midPts,densityFactor,r2Length,r2Power);
+      PR.setThreads(1);
+      
+      const boost::multi_array<double,4>& WGrid=WW.getGrid();
+      size_t index(0);
+      for(long int i=0;i<WW.getXSize();i++)
+	for(long int j=0;j<WW.getYSize();j++)
+	  for(long int k=0;k<WW.getZSize();k++)
+	    {
+	      for(long int e=0;e<WW.getESize();e++)
+		{
+		  const double DT=
+		    WW.distTrack(ASim,aimPt,
+				 1e-6+EBand[static_cast<size_t>(e)],
+				 midPts[index],densityFactor,
+				 r2Length,r2Power);
+		  if (std::abs(WGrid[i][j][k][e]-DT)>1e-5)
+		    {
+		      ELog::EM<<"Failed on point "<<midPts[index]
+			      <<" energy "<<EBand[static_cast<size_t>(e)]
+			      <<" threads "<<nThread<<ELog::endDiag;
+		      ELog::EM<<"Weight "<<WGrid[i][j][k][e]<<" == "
+			      <<DT<<ELog::endDiag;
+		      return -1;
+		    }
+		}
+	      index++;
+	    }
+    }
+  return 0;
+}
@@ -42,6 +42,7 @@
 #include "NameStack.h"
 #include "RegMethod.h"
 #include "OutputLog.h"
+#include "MersenneTwister.h"
 #include "BaseVisit.h"
 #include "BaseModVisit.h"
 #include "mathSupport.h"
@@ -65,6 +66,8 @@
 #include "HeadRule.h"
 #include "Object.h"
 #include "ObjSurfMap.h"
+#include "RuleBox.h"
+#include "CellIndex.h"
 #include "ReadFunctions.h"
 #include "surfRegister.h"
 #include "ModelSupport.h"
@@ -73,6 +76,8 @@
 #include "objectGroups.h"
 #include "Simulation.h"
 #include "SimMCNP.h"
+#include "ParallelRun.h"
+#include "QueryContext.h"
 
 #include "testFunc.h"
 #include "testSimulation.h"
@@ -96,6 +101,9 @@ testSimulation::initSim()
   */
 {
   ASim.resetAll();
+  // cells below the first cell zone belong to World
+  ASim.objectGroups::reset();
+  ASim.cell("World");
   createSurfaces();
   createObjects();
   return;
@@ -189,14 +197,20 @@ testSimulation::applyTest(const int extra)
   typedef int (testSimulation::*testPtr)();
   testPtr TPtr[]=
     {
+      &testSimulation::testCellBlock,
+      &testSimulation::testCellIndex,
       &testSimulation::testCreateObjSurfMap,
       &testSimulation::testInCell,
+      &testSimulation::testParallelQuery,
       &testSimulation::testSplitCell
     };
   const std::string TestName[]=
     {
+      "CellBlock",
+      "CellIndex",
       "CreateObjSurfMap",
       "InCell",
+      "ParallelQuery",
       "SplitCell"
     };
   
@@ -225,6 +239,170 @@ testSimulation::applyTest(const int extra)
 }
 
 
+int
+testSimulation::testCellBlock()
+  /*!
+    Test the block search of a row of points [longer than
+    one block] gives the same cells as findCell on each point
+    \retval 0 :: success
+  */
+{
+  ELog::RegMethod RegA("testSimulation","testCellBlock");
+
+  initSim();
+  ASim.createObjSurfMap();
+
+  std::vector<Geometry::Vec3D> rowPts;
+  for(double x=-30.0;x<30.0;x+=0.37)
+    rowPts.push_back(Geometry::Vec3D(x,0.3,0.1));
+
+  std::vector<MonteCarlo::Object*> rowObj(rowPts.size());
+  ModelSupport::QueryContext QC(ASim,0);
+  QC.findCellBlock(rowPts.data(),rowPts.size(),rowObj.data());
+
+  for(size_t i=0;i<rowPts.size();i++)
+    {
+      const MonteCarlo::Object* OPtr=ASim.findCell(rowPts[i],0);
+      if (OPtr!=rowObj[i])
+	{
+	  ELog::EM<<"Failed on point:"<<rowPts[i]<<" : "
+		  <<((OPtr) ? OPtr->getName() : 0)<<" != "
+		  <<((rowObj[i]) ? rowObj[i]->getName() : 0)<<ELog::endDiag;
+	  return -1;
+	}
+    }
+  return 0;
+}
+
+int
+testSimulation::testCellIndex()
+  /*!
+    Test the spatial index gives the same cell as 
+    a linear search of the cells
+    \retval 0 :: success
+  */
+{
+  ELog::RegMethod RegA("testSimulation","testCellIndex");
+
+  initSim();
+  ASim.createObjSurfMap();
+
+  const Simulation::OTYPE& OMap=ASim.getCells();
+  ModelSupport::CellIndex CI;
+  CI.build(OMap);
+  if (!CI.isBuilt()) return -1;
+
+  // Box of the steel cell [2] : must be finite
+  Geometry::Vec3D LPt,HPt;
+  OMap.find(2)->second->getBoundBox(LPt,HPt);
+  if (!RuleBox::isBounded(LPt,HPt) ||
+      LPt.Distance(Geometry::Vec3D(-1,-1,-1))>1e-3 ||
+      HPt.Distance(Geometry::Vec3D(1,1,1))>1e-3)
+    {
+      ELog::EM<<"Box == "<<LPt<<" : "<<HPt<<ELog::endDiag;
+      return -2;
+    }
+  
+  for(double x=-30.0;x<30.0;x+=1.37)
+    for(double y=-30.0;y<30.0;y+=1.71)
+      for(double z=-30.0;z<30.0;z+=2.13)
+	{
+	  const Geometry::Vec3D Pt(x,y,z);
+	  const MonteCarlo::Object* LPtr(0);
+	  for(const Simulation::OTYPE::value_type& mc : OMap)
+	    if (mc.second->isValid(Pt))
+	      {
+		LPtr=mc.second;
+		break;
+	      }
+	  const MonteCarlo::Object* IPtr=CI.findCell(Pt);
+	  if (LPtr!=IPtr)
+	    {
+	      ELog::EM<<"Failed on point:"<<Pt<<ELog::endDiag;
+	      ELog::EM<<"Linear == "<<(LPtr ? LPtr->getName() : 0)
+		      <<" Index == "<<(IPtr ? IPtr->getName() : 0)
+		      <<ELog::endDiag;
+	      return -3;
+	    }
+	}
+  return 0;
+}
+
+int
+testSimulation::testParallelQuery()
+  /*!
+    Test that threaded findCell gives the same cells as
+    a serial search and that the first error is returned
+    \retval 0 :: success
+  */
+{
+  ELog::RegMethod RegA("testSimulation","testParallelQuery");
+
+  initSim();
+  ASim.createObjSurfMap();
+
+  ModelSupport::ParallelRun& PR=ModelSupport::ParallelRun::Instance();
+  PR.setThreads(4);
+
+  const size_t NX(40);
+  std::vector<std::vector<int>> cellNum(NX);
+  PR.run(NX,[&](const size_t index)
+    {
+      ModelSupport::QueryContext QC(ASim,0);
+      const double x(-30.0+1.5*static_cast<double>(index));
+      for(double y=-30.0;y<30.0;y+=1.71)
+	for(double z=-30.0;z<30.0;z+=2.13)
+	  {
+	    const MonteCarlo::Object* OPtr=
+	      QC.findCell(Geometry::Vec3D(x,y,z));
+	    cellNum[index].push_back((OPtr) ? OPtr->getName() : 0);
+	  }
+    });
+
+  for(size_t index=0;index<NX;index++)
+    {
+      size_t i(0);
+      const double x(-30.0+1.5*static_cast<double>(index));
+      for(double y=-30.0;y<30.0;y+=1.71)
+	for(double z=-30.0;z<30.0;z+=2.13)
+	  {
+	    const MonteCarlo::Object* OPtr=
+	      ASim.findCell(Geometry::Vec3D(x,y,z),0);
+	    const int CN((OPtr) ? OPtr->getName() : 0);
+	    if (i>=cellNum[index].size() || cellNum[index][i]!=CN)
+	      {
+		PR.setThreads(1);
+		ELog::EM<<"Failed on point:"<<Geometry::Vec3D(x,y,z)
+			<<" : "<<CN<<ELog::endDiag;
+		return -1;
+	      }
+	    i++;
+	  }
+    }
+
+  // errors : lowest failed item is thrown
+  int errorItem(0);
+  try
+    {
+      PR.run(64,[](const size_t index)
+        {
+	  if (index==13 || index==17)
+	    throw ColErr::ExBase(static_cast<int>(index),"index");
+	});
+    }
+  catch(const ColErr::ExBase& A)
+    {
+      errorItem=A.getErrorNum();
+    }
+  PR.setThreads(1);
+  if (errorItem!=13)
+    {
+      ELog::EM<<"Error item == "<<errorItem<<ELog::endDiag;
+      return -2;
+    }
+  return 0;
+}
+
 int
 testSimulation::testCreateObjSurfMap()
   /*!
@@ -271,6 +449,8 @@ testSimulation::testInCell()
 {
   ELog::RegMethod RegA("testSimulation","testInCell");
 
+  initSim();
+
   typedef std::tuple<Geometry::Vec3D,int> TTYPE;
   const std::vector<TTYPE> Tests=
     {
@@ -50,6 +50,7 @@
 #include "Surface.h"
 #include "surfIndex.h"
 #include "Quadratic.h"
+#include "Cylinder.h"
 #include "NullSurface.h"
 #include "Sphere.h"
 #include "Plane.h"
@@ -116,13 +117,15 @@ testSurfEqual::applyTest(const int extra)
   testPtr TPtr[]=
     {
       &testSurfEqual::testBasicPair,
-      &testSurfEqual::testEqualSurfNum
+      &testSurfEqual::testEqualSurfNum,
+      &testSurfEqual::testHashIndex
     };
 
   const std::string TestName[]=
     {
       "BasicPair",
-      "EqualSurfNum"
+      "EqualSurfNum",
+      "HashIndex"
     };
 
   const int TSize(sizeof(TPtr)/sizeof(testPtr));
@@ -212,3 +215,122 @@ testSurfEqual::testEqualSurfNum()
   return 0;
 }
 
+
+template<typename T>
+static bool
+typeEqual(const Geometry::Surface* APtr,const Geometry::Surface* BPtr)
+  /*!
+    Linear search comparison [as used in EqualSurf]
+    \param APtr :: Surface to find
+    \param BPtr :: Surface in the map
+    \return true if the same type and equal
+  */
+{
+  const T* AX=dynamic_cast<const T*>(APtr);
+  const T* BX=dynamic_cast<const T*>(BPtr);
+  return (AX && BX && BX->operator==(*AX));
+}
+
+int
+testSurfEqual::testHashIndex()
+  /*!
+    Test that the hashed equal/opposite search gives
+    the same surface as a linear search. Values are placed
+    on bucket edges and moved within tolerance.
+    \return -ve on error 
+  */
+{
+  ELog::RegMethod RegA("testSurfEqual","testHashIndex");
+
+  typedef std::map<int,Geometry::Surface*> STYPE;
+  
+  ModelSupport::surfIndex& SurI=ModelSupport::surfIndex::Instance();
+  SurI.reset();
+
+  const double dT(0.3*Geometry::zeroTol);
+  const std::vector<double> DVec({0.0,1e-5,-2e-5,2.5,7.00001});
+  const std::vector<Geometry::Vec3D> NVec=
+    {
+      Geometry::Vec3D(1,0,0),Geometry::Vec3D(0,-1,0),
+      Geometry::Vec3D(1,1,0).unit(),Geometry::Vec3D(0.3,0.4,0.5).unit()
+    };
+  const std::vector<Geometry::Vec3D> dVec=
+    {
+      Geometry::Vec3D(0,0,0),Geometry::Vec3D(dT,0,0),
+      Geometry::Vec3D(0,-dT,dT)
+    };
+  
+  int SN(1);
+  for(const Geometry::Vec3D& N : NVec)
+    for(const double D : DVec)
+      for(const Geometry::Vec3D& dV : dVec)
+	{
+	  const double dD(dV.X());
+	  Geometry::Plane* PA=new Geometry::Plane(SN++,0);
+	  PA->setPlane(N,D+dD);
+	  SurI.insertSurface(PA);
+	  Geometry::Plane* PB=new Geometry::Plane(SN++,0);
+	  PB->setPlane(-N,-D-dD);
+	  SurI.insertSurface(PB);
+	  Geometry::Plane* PC=new Geometry::Plane(SN++,0);
+	  PC->setPlane(N+dV,D-dD);
+	  SurI.insertSurface(PC);
+
+	  const double R(std::abs(D)+1.0);
+	  Geometry::Cylinder* CA=new Geometry::Cylinder(SN++,0);
+	  CA->setCylinder(N*D+dV,N,R+dD);
+	  SurI.insertSurface(CA);
+	  Geometry::Cylinder* CB=new Geometry::Cylinder(SN++,0);
+	  CB->setCylinder(N*(D+5.0),-N,R);
+	  SurI.insertSurface(CB);
+
+	  std::ostringstream cx;
+	  cx.precision(17);
+	  cx<<"s "<<D+dV.Y()<<" "<<D<<" "<<dV.Z()<<" "<<R-dD;
+	  SurI.createSurface(SN++,cx.str());
+	}
+
+  const STYPE& SMap=SurI.surMap();
+  size_t equalCnt(0);
+  size_t oppCnt(0);
+  for(const STYPE::value_type& SItem : SMap)
+    {
+      const Geometry::Surface* SPtr=SItem.second;
+      int eqN(SItem.first);
+      int oppN(0);
+      for(const STYPE::value_type& TItem : SMap)
+	{
+	  if (eqN==SItem.first && TItem.first!=SItem.first &&
+	      (typeEqual<Geometry::Plane>(SPtr,TItem.second) ||
+	       typeEqual<Geometry::Cylinder>(SPtr,TItem.second) ||
+	       typeEqual<Geometry::Sphere>(SPtr,TItem.second)))
+	    eqN=TItem.first;
+	  if (!oppN && ModelSupport::oppositeSurfaces(SPtr,TItem.second))
+	    oppN=TItem.first;
+	}
+      if (eqN!=SItem.first) equalCnt++;
+      if (oppN) oppCnt++;
+      
+      const int hashEqN=ModelSupport::equalSurfNum(SPtr);
+      const int hashOppN=SurI.findOpposite(SPtr);
+      if (hashEqN!=eqN || hashOppN!=oppN)
+	{
+	  ELog::EM<<"Surface :  "<<*SPtr<<ELog::endDiag;
+	  ELog::EM<<"Equal   :  "<<hashEqN<<" ["<<eqN<<"]"<<ELog::endDiag;
+	  ELog::EM<<"Opposite:  "<<hashOppN<<" ["<<oppN<<"]"<<ELog::endDiag;
+	  SurI.reset();
+	  createSurfaces();
+	  return -1;
+	}
+    }
+  SurI.reset();
+  createSurfaces();
+  
+  if (!equalCnt || !oppCnt)
+    {
+      ELog::EM<<"No equal/opposite surfaces found : "
+	      <<equalCnt<<" "<<oppCnt<<ELog::endDiag;
+      return -1;
+    }
+  return 0;
+}
@@ -48,6 +48,7 @@ private:
   int testExpandCNFBracket();
   int testInsert();
   int testIsTrue();
+  int testLargeLogic();
   int testLogicalCover();
   int testLogicalEqual();
   int testMakeString();
@@ -38,6 +38,7 @@ private:
   //Tests 
   int testAnalyse();
   int testBuiltIn();
+  int testCacheChange();
   int testCopyVarSet();
   int testEval();
   int testString();
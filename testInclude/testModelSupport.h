@@ -39,6 +39,7 @@ private:
   void createSurfaces();
 
   //Tests 
+  int testGetHeadRule();
   int testRemoveOpenPair();
 
 public:
@@ -38,6 +38,7 @@ class testObjSurfMap
 
   void createSurfaces();
   //Tests 
+  int testFindNext();
   int testMap();
 
  
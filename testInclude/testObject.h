@@ -46,14 +46,20 @@ private:
   void createSurfaces();
 
   //Tests 
+  int testAddIntersection();
+  int testBoundBox();
+  int testCalcVertex();
   int testCellStr();
   int testComplement();
   int testIsValid();
+  int testIsValidBlock();
   int testIsOnSide();
   int testMakeComplement();
   int testRemoveComplement();
+  int testRuleProgram();
   int testSetObject();
   int testSetObjectExtra();
+  int testSurfaceList();
   int testTrackCell();
   int testWriteFluka();
 
@@ -44,6 +44,8 @@ private:
 
   //Tests 
   int testPointDet();
+  int testWWGTrack();
+  int testWWGWeight();
 
 public:
   
@@ -43,8 +43,11 @@ private:
   void createObjects();
 
   //Tests 
+  int testCellBlock();
+  int testCellIndex();
   int testCreateObjSurfMap();
   int testInCell();
+  int testParallelQuery();
   int testSplitCell();
 
 public:
@@ -41,6 +41,7 @@ class testSurfEqual
   //Tests 
   int testBasicPair();
   int testEqualSurfNum();
+  int testHashIndex();
  
  public:
 